@@ -1,8 +1,16 @@
 #include "DirectXCommon.h"
+#include "TextureDecoder.h"
+#include "PipelineStateHasher.h"
+#include "Hash.h"
+#include "Logger.h"
 
 #include <cassert>
 #include <vector>
 #include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include "externals/DirectXTex/d3dx12.h" 
 
 #pragma comment(lib, "d3d12.lib")
@@ -11,6 +19,99 @@
 
 using namespace Microsoft::WRL;
 
+namespace {
+    // 一時データ用アップロードリングの容量
+    constexpr uint64_t kUploadRingSize = 16 * 1024 * 1024;
+
+    // SRVヒープの大きさ（常駐領域 + フレームごとの一時領域 × 同時フレーム数）
+    constexpr uint32_t kSrvPersistentCount = 4096;
+    constexpr uint32_t kSrvTransientCountPerFrame = 1024;
+
+    // コンパイル済みシェーダーのキャッシュを置く場所（実行時のカレントディレクトリから）
+    constexpr char kShaderCacheDirectory[] = "cache/shaders";
+
+    // パイプラインライブラリのファイル（実行時のカレントディレクトリから）
+    constexpr char kPipelineLibraryPath[] = "cache/pipelines.bin";
+
+    // パイプラインライブラリのファイルの先頭
+    struct PipelineLibraryFileHeader {
+        static constexpr uint32_t kMagic = 0x4C4F5350; // "PSOL"
+        static constexpr uint32_t kVersion = 2;        // ファイルの形式・PSO のキーの作り方を変えたら上げる
+
+        uint32_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint64_t deviceKey = 0; // GPU とドライバのバージョンのハッシュ
+        uint64_t dataSize = 0;  // 後ろに続く ID3D12PipelineLibrary::Serialize の大きさ
+    };
+
+    // シェーダーはポインタではなく中身で見る
+    void AddShaderBytecode(PipelineStateHasher& hasher, const D3D12_SHADER_BYTECODE& shader) {
+        hasher.AddUInt64(shader.BytecodeLength);
+        hasher.AddUInt64(shader.pShaderBytecode ? Hash::XXH64(shader.pShaderBytecode, shader.BytecodeLength) : 0);
+    }
+
+    void AddStencilOp(PipelineStateHasher& hasher, const D3D12_DEPTH_STENCILOP_DESC& desc) {
+        hasher.AddUInt32(desc.StencilFailOp);
+        hasher.AddUInt32(desc.StencilDepthFailOp);
+        hasher.AddUInt32(desc.StencilPassOp);
+        hasher.AddUInt32(desc.StencilFunc);
+    }
+
+    // パイプラインライブラリに登録する名前
+    // LoadGraphicsPipeline は登録したときの記述と中身をそのまま比べ、1つでも違えば E_INVALIDARG を返す。
+    // 正規化したキーだけで名前を付けると、キーが同じで使わない項目だけが違う記述が同じ名前に当たり、
+    // 読み込みに失敗したうえ StorePipeline も名前が使用済みで失敗するので、毎回コンパイルし直すことになる。
+    // そこで、キーに積まなかった項目もそのままの値で積んで名前にする
+    uint64_t HashPipelineLibraryName(uint64_t key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) {
+        PipelineStateHasher hasher;
+        hasher.AddUInt64(key);
+
+        hasher.AddUInt32(desc.StreamOutput.RasterizedStream);
+        for (const D3D12_RENDER_TARGET_BLEND_DESC& blend : desc.BlendState.RenderTarget) {
+            hasher.AddBool(blend.BlendEnable);
+            hasher.AddBool(blend.LogicOpEnable);
+            hasher.AddUInt32(blend.SrcBlend);
+            hasher.AddUInt32(blend.DestBlend);
+            hasher.AddUInt32(blend.BlendOp);
+            hasher.AddUInt32(blend.SrcBlendAlpha);
+            hasher.AddUInt32(blend.DestBlendAlpha);
+            hasher.AddUInt32(blend.BlendOpAlpha);
+            hasher.AddUInt32(blend.LogicOp);
+            hasher.AddUInt32(blend.RenderTargetWriteMask);
+        }
+        hasher.AddUInt32(desc.DepthStencilState.DepthWriteMask);
+        hasher.AddUInt32(desc.DepthStencilState.DepthFunc);
+        hasher.AddUInt32(desc.DepthStencilState.StencilReadMask);
+        hasher.AddUInt32(desc.DepthStencilState.StencilWriteMask);
+        AddStencilOp(hasher, desc.DepthStencilState.FrontFace);
+        AddStencilOp(hasher, desc.DepthStencilState.BackFace);
+        for (DXGI_FORMAT format : desc.RTVFormats) {
+            hasher.AddUInt32(format);
+        }
+        return hasher.Finish();
+    }
+
+    // DXC のオブジェクトは複数のスレッドから同時に使えないので、スレッドごとに作る
+    struct DxcContext {
+        ComPtr<IDxcUtils> utils;
+        ComPtr<IDxcCompiler3> compiler;
+        ComPtr<IDxcIncludeHandler> includeHandler;
+    };
+
+    DxcContext& GetDxcContext() {
+        thread_local DxcContext context;
+        if (!context.compiler) {
+            HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&context.utils));
+            assert(SUCCEEDED(hr));
+            hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&context.compiler));
+            assert(SUCCEEDED(hr));
+            hr = context.utils->CreateDefaultIncludeHandler(&context.includeHandler);
+            assert(SUCCEEDED(hr));
+        }
+        return context;
+    }
+}
+
 // 文字列変換ヘルパー（警告回避用）
 std::wstring ConvertString(const std::string& str) {
     if (str.empty()) {
@@ -25,9 +126,11 @@ std::wstring ConvertString(const std::string& str) {
     return result;
 }
 
-void DirectXCommon::Initialize(WinApp* winApp) {
+void DirectXCommon::Initialize(WinApp* winApp, uint32_t framesInFlight) {
     assert(winApp);
+    assert(framesInFlight >= 2 && framesInFlight <= FrameScheduler::kMaxFramesInFlight);
     winApp_ = winApp;
+    framesInFlight_ = framesInFlight;
 
     InitializeFixFPS();
     InitializeDevice();
@@ -40,8 +143,10 @@ void DirectXCommon::Initialize(WinApp* winApp) {
     InitializeViewport();
     InitializeScissorRect();
     InitializeDXCCompiler();
+    InitializePipelineLibrary();
     InitializeImGui();
     InitializeFence();
+    InitializeUploadRing();
 }
 
 void DirectXCommon::PreDraw() {
@@ -91,21 +196,55 @@ void DirectXCommon::PostDraw() {
 
     swapChain_->Present(1, 0);
 
-    //シグナル発行もコマンドキューに対して行う
-    fenceVal_++;
-    commandQueue_->Signal(fence_.Get(), fenceVal_);
+    //シグナル発行もコマンドキューに対して行う（ここでは待たない）
+    uint64_t fenceValue = frameScheduler_.EndFrame();
 
-    if (fence_->GetCompletedValue() < fenceVal_) {
-        fence_->SetEventOnCompletion(fenceVal_, fenceEvent_);
-        WaitForSingleObject(fenceEvent_, INFINITE);
-    }
+    // このフレームで切り出した一時データは fenceValue を通過したら再利用できる
+    uploadRing_.FinishFrame(fenceValue);
+
+    // 次のフレームのスロットが空くのを待つ（framesInFlight_ フレーム前の完了だけを待つ）
+    uint32_t frameIndex = frameScheduler_.BeginFrame();
+    srvAllocator_.BeginFrame(frameIndex);
 
-    hr = commandAllocator_->Reset();
+    hr = commandAllocators_[frameIndex]->Reset();
     assert(SUCCEEDED(hr));
-    hr = commandList_->Reset(commandAllocator_.Get(), nullptr);
+    hr = commandList_->Reset(commandAllocators_[frameIndex].Get(), nullptr);
     assert(SUCCEEDED(hr));
 }
 
+void DirectXCommon::WaitForGpu() {
+    frameScheduler_.WaitForIdle();
+}
+
+void DirectXCommon::RetireResource(Microsoft::WRL::ComPtr<ID3D12Resource> resource) {
+    if (!resource) {
+        return;
+    }
+    // 統計用に、解放されるメモリ量を調べておく
+    D3D12_RESOURCE_DESC desc = resource->GetDesc();
+    uint64_t sizeInBytes = device_->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+
+    // ラムダが ComPtr を持っている間は解放されない
+    frameScheduler_.Retire([resource]() {}, sizeInBytes);
+}
+
+uint32_t DirectXCommon::AllocateSrvIndex() {
+    uint32_t index = srvAllocator_.AllocatePersistent();
+    assert(index != DescriptorAllocator::kInvalidIndex && "SRVヒープの常駐領域が足りない");
+    return index;
+}
+
+void DirectXCommon::FreeSrvIndex(uint32_t index) {
+    // 前のフレームがまだこの番号のSRVを使っているかもしれないので、GPUが通過してから空きに戻す
+    frameScheduler_.Retire([this, index]() { srvAllocator_.FreePersistent(index); });
+}
+
+uint32_t DirectXCommon::AllocateTransientSrvIndices(uint32_t count) {
+    uint32_t index = srvAllocator_.AllocateTransient(count);
+    assert(index != DescriptorAllocator::kInvalidIndex && "SRVヒープの一時領域が足りない");
+    return index;
+}
+
 D3D12_CPU_DESCRIPTOR_HANDLE DirectXCommon::GetSRVCPUDescriptorHandle(uint32_t index) const {
     D3D12_CPU_DESCRIPTOR_HANDLE handleCPU = srvDescriptorHeap_->GetCPUDescriptorHandleForHeapStart();
     handleCPU.ptr += (static_cast<SIZE_T>(srvDescriptorSize_) * index);
@@ -154,10 +293,13 @@ void DirectXCommon::InitializeCommand() {
     HRESULT hr = device_->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(&commandQueue_));
     assert(SUCCEEDED(hr));
 
-    hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator_));
-    assert(SUCCEEDED(hr));
+    for (uint32_t i = 0; i < framesInFlight_; ++i) {
+        hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocators_[i]));
+        assert(SUCCEEDED(hr));
+    }
 
-    hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator_.Get(), nullptr, IID_PPV_ARGS(&commandList_));
+    // 最初のフレームはスロット0のアロケータで記録する
+    hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocators_[0].Get(), nullptr, IID_PPV_ARGS(&commandList_));
     assert(SUCCEEDED(hr));
 }
 
@@ -205,11 +347,12 @@ void DirectXCommon::InitializeDescriptorHeaps() {
     assert(SUCCEEDED(hr));
     dsvDescriptorSize_ = device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
 
-    // SRV
+    // SRV（常駐領域と、フレームごとの一時領域に分けて使う）
+    srvAllocator_.Initialize(kSrvPersistentCount, kSrvTransientCountPerFrame, framesInFlight_);
     D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc{};
     srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
     srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    srvHeapDesc.NumDescriptors = 128;
+    srvHeapDesc.NumDescriptors = srvAllocator_.GetCapacity();
     hr = device_->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&srvDescriptorHeap_));
     assert(SUCCEEDED(hr));
     srvDescriptorSize_ = device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -277,12 +420,64 @@ void DirectXCommon::InitializeScissorRect() {
 }
 
 void DirectXCommon::InitializeDXCCompiler() {
-    HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxcUtils_));
-    assert(SUCCEEDED(hr));
-    hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler_));
-    assert(SUCCEEDED(hr));
-    hr = dxcUtils_->CreateDefaultIncludeHandler(&includeHandler_);
-    assert(SUCCEEDED(hr));
+    // メインスレッドの分は先に作っておく（他のスレッドの分は最初にコンパイルするときに作られる）
+    GetDxcContext();
+
+    shaderCache_.Initialize(kShaderCacheDirectory);
+}
+
+void DirectXCommon::InitializePipelineLibrary() {
+    // パイプラインライブラリは ID3D12Device1 から（使えなければ PSO の使い回しだけ行う）
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device_.As(&device1))) {
+        return;
+    }
+
+    // GPU とドライバのバージョン（変わったら前回の PSO は使えない）
+    ComPtr<IDXGIFactory4> factory;
+    ComPtr<IDXGIAdapter1> adapter;
+    if (SUCCEEDED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))) &&
+        SUCCEEDED(factory->EnumAdapterByLuid(device_->GetAdapterLuid(), IID_PPV_ARGS(&adapter)))) {
+        DXGI_ADAPTER_DESC1 adapterDesc{};
+        adapter->GetDesc1(&adapterDesc);
+        LARGE_INTEGER driverVersion{};
+        adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+
+        PipelineStateHasher hasher;
+        hasher.AddUInt32(adapterDesc.VendorId);
+        hasher.AddUInt32(adapterDesc.DeviceId);
+        hasher.AddUInt32(adapterDesc.SubSysId);
+        hasher.AddUInt32(adapterDesc.Revision);
+        hasher.AddUInt64(static_cast<uint64_t>(driverVersion.QuadPart));
+        pipelineLibraryDeviceKey_ = hasher.Finish();
+    }
+
+    // 前回のファイルを読む（同じ GPU・ドライバで書いたものだけ）
+    std::ifstream file(kPipelineLibraryPath, std::ios::binary);
+    PipelineLibraryFileHeader header{};
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        header.magic == PipelineLibraryFileHeader::kMagic &&
+        header.version == PipelineLibraryFileHeader::kVersion &&
+        header.deviceKey == pipelineLibraryDeviceKey_ && header.dataSize > 0) {
+        pipelineLibraryData_.resize(static_cast<size_t>(header.dataSize));
+        if (!file.read(reinterpret_cast<char*>(pipelineLibraryData_.data()), static_cast<std::streamsize>(pipelineLibraryData_.size()))) {
+            pipelineLibraryData_.clear();
+        }
+    }
+    file.close();
+
+    if (!pipelineLibraryData_.empty()) {
+        HRESULT hr = device1->CreatePipelineLibrary(pipelineLibraryData_.data(), pipelineLibraryData_.size(), IID_PPV_ARGS(&pipelineLibrary_));
+        if (SUCCEEDED(hr)) {
+            return;
+        }
+        // ドライバが違う・壊れているなどで読めなければ空から作り直す
+        pipelineLibraryData_.clear();
+    }
+    HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&pipelineLibrary_));
+    if (FAILED(hr)) {
+        pipelineLibrary_.Reset();
+    }
 }
 
 void DirectXCommon::InitializeImGui() {
@@ -290,10 +485,65 @@ void DirectXCommon::InitializeImGui() {
 }
 
 void DirectXCommon::InitializeFence() {
-    HRESULT hr = device_->CreateFence(fenceVal_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+    HRESULT hr = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
     assert(SUCCEEDED(hr));
     fenceEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
     assert(fenceEvent_ != nullptr);
+
+    frameQueue_.Initialize(commandQueue_.Get(), fence_.Get(), fenceEvent_);
+    frameScheduler_.Initialize(&frameQueue_, framesInFlight_);
+}
+
+void DirectXCommon::FrameQueue::Initialize(ID3D12CommandQueue* commandQueue, ID3D12Fence* fence, HANDLE fenceEvent) {
+    assert(commandQueue);
+    assert(fence);
+    commandQueue_ = commandQueue;
+    fence_ = fence;
+    fenceEvent_ = fenceEvent;
+}
+
+void DirectXCommon::FrameQueue::Signal(uint64_t fenceValue) {
+    HRESULT hr = commandQueue_->Signal(fence_, fenceValue);
+    assert(SUCCEEDED(hr));
+}
+
+uint64_t DirectXCommon::FrameQueue::GetCompletedFenceValue() {
+    return fence_->GetCompletedValue();
+}
+
+void DirectXCommon::FrameQueue::WaitForFenceValue(uint64_t fenceValue) {
+    if (fence_->GetCompletedValue() < fenceValue) {
+        fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
+        WaitForSingleObject(fenceEvent_, INFINITE);
+    }
+}
+
+void DirectXCommon::InitializeUploadRing() {
+    uploadRingResource_ = CreateBufferResource(kUploadRingSize);
+    uploadRingBackend_.Initialize(uploadRingResource_.Get(), fence_.Get(), fenceEvent_);
+    uploadRing_.Initialize(&uploadRingBackend_, kUploadRingSize);
+}
+
+void DirectXCommon::UploadRingBackend::Initialize(ID3D12Resource* resource, ID3D12Fence* fence, HANDLE fenceEvent) {
+    assert(resource);
+    assert(fence);
+    // アップロードヒープは Map したままでよいので、Unmap はしない
+    HRESULT hr = resource->Map(0, nullptr, reinterpret_cast<void**>(&mappedPointer_));
+    assert(SUCCEEDED(hr));
+    gpuAddress_ = resource->GetGPUVirtualAddress();
+    fence_ = fence;
+    fenceEvent_ = fenceEvent;
+}
+
+uint64_t DirectXCommon::UploadRingBackend::GetCompletedFenceValue() {
+    return fence_->GetCompletedValue();
+}
+
+void DirectXCommon::UploadRingBackend::WaitForFenceValue(uint64_t fenceValue) {
+    if (fence_->GetCompletedValue() < fenceValue) {
+        fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
+        WaitForSingleObject(fenceEvent_, INFINITE);
+    }
 }
 
 // ==========================================
@@ -303,29 +553,15 @@ void DirectXCommon::InitializeFence() {
 // LoadTextureの実装
 DirectX::ScratchImage DirectXCommon::LoadTexture(const std::string& filePath) {
     // 文字コード変換（警告が出ないようにヘルパー関数使用）
-    std::wstring filePathW = ConvertString(filePath);
+    // TextureCooker でクック済みの DDS があればそちらを読む（ミップマップ生成も要らない）
+    std::wstring filePathW = TextureDecoder::ResolveCookedPath(ConvertString(filePath));
 
-    // 2. WICファイル（png, jpgなど）として読み込む
-    DirectX::ScratchImage image{};
-    HRESULT hr = DirectX::LoadFromWICFile(
-        filePathW.c_str(),
-        DirectX::WIC_FLAGS_FORCE_SRGB,
-        nullptr,
-        image);
-    assert(SUCCEEDED(hr));
-
-    // 3. ミップマップの生成
+    // 読み込みとミップマップの生成（拡張子で WIC / DDS / TGA / HDR を使い分ける）
     DirectX::ScratchImage mipImages{};
-    hr = DirectX::GenerateMipMaps(
-        image.GetImages(),
-        image.GetImageCount(),
-        image.GetMetadata(),
-        DirectX::TEX_FILTER_SRGB,
-        0,
-        mipImages);
+    HRESULT hr = TextureDecoder::Decode(filePathW, mipImages);
     assert(SUCCEEDED(hr));
 
-    // 4. ミップマップ付きのデータを返す
+    // ミップマップ付きのデータを返す
     return mipImages;
 }
 
@@ -354,9 +590,63 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateBufferResource(size_
     return resource;
 }
 
-Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const std::wstring& filePath, const std::wstring& profile) {
+UploadRingAllocator::Allocation DirectXCommon::AllocateUpload(size_t sizeInBytes, size_t alignment) {
+    UploadRingAllocator::Allocation allocation = uploadRing_.Allocate(sizeInBytes, alignment);
+    if (allocation.IsValid()) {
+        return allocation;
+    }
+
+    // リングに入りきらない（1フレームで容量を超えた）ときは、このフレームだけ使う専用のバッファを作る
+    // 先頭は常に 64KB 境界に置かれるので alignment は満たしている
+    assert(alignment <= D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+    Microsoft::WRL::ComPtr<ID3D12Resource> resource = CreateBufferResource(sizeInBytes);
+    void* mappedPointer = nullptr;
+    HRESULT hr = resource->Map(0, nullptr, &mappedPointer);
+    assert(SUCCEEDED(hr));
+    allocation.cpuAddress = mappedPointer;
+    allocation.gpuAddress = resource->GetGPUVirtualAddress();
+    allocation.offset = 0;
+    allocation.size = sizeInBytes;
+
+    // GPUがこのフレームを使い終わったら解放する
+    RetireResource(resource);
+    return allocation;
+}
+
+Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const std::wstring& filePath, const std::wstring& profile, const std::vector<std::wstring>& additionalArguments) {
+    // 1. コンパイラに渡す引数（キャッシュのキーにも含める）
+    // Debug はデバッグ情報付き・最適化なし、それ以外は最適化ありでデバッグ情報を埋め込まない
+    std::vector<std::wstring> arguments = {
+        filePath,
+        L"-E", L"main",
+        L"-T", profile,
+#ifdef _DEBUG
+        L"-Zi", L"-Qembed_debug",
+        L"-Od",
+#else
+        L"-O3",
+#endif
+        L"-Zpr",
+    };
+    // バリアントの #define など
+    arguments.insert(arguments.end(), additionalArguments.begin(), additionalArguments.end());
+
+    // 別のスレッドから同時に呼ばれてもよいよう、DXC はこのスレッドのものを使う
+    DxcContext& dxc = GetDxcContext();
+
+    // 2. 同じソース・インクルード・引数でコンパイルしたものがあれば、それを使う
+    uint64_t cacheKey = ShaderCache::ComputeKey(filePath, arguments);
+    MappedFile cachedBytecode;
+    if (shaderCache_.Load(cacheKey, cachedBytecode)) {
+        ComPtr<IDxcBlobEncoding> cachedBlob = nullptr;
+        HRESULT hr = dxc.utils->CreateBlob(cachedBytecode.GetData(), UINT32(cachedBytecode.GetSize()), DXC_CP_ACP, &cachedBlob);
+        assert(SUCCEEDED(hr));
+        return cachedBlob;
+    }
+
+    // 3. コンパイル
     ComPtr<IDxcBlobEncoding> shaderSource = nullptr;
-    HRESULT hr = dxcUtils_->LoadFile(filePath.c_str(), nullptr, &shaderSource);
+    HRESULT hr = dxc.utils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
     assert(SUCCEEDED(hr));
 
     DxcBuffer shaderSourceBuffer;
@@ -364,20 +654,17 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const std::wstring
     shaderSourceBuffer.Size = shaderSource->GetBufferSize();
     shaderSourceBuffer.Encoding = DXC_CP_UTF8;
 
-    LPCWSTR arguments[] = {
-        filePath.c_str(),
-        L"-E", L"main",
-        L"-T", profile.c_str(),
-        L"-Zi", L"-Qembed_debug",
-        L"-Od", L"-Zpr",
-    };
+    std::vector<LPCWSTR> argumentPointers;
+    for (const std::wstring& argument : arguments) {
+        argumentPointers.push_back(argument.c_str());
+    }
 
     ComPtr<IDxcResult> shaderResult = nullptr;
-    hr = dxcCompiler_->Compile(
+    hr = dxc.compiler->Compile(
         &shaderSourceBuffer,
-        arguments,
-        _countof(arguments),
-        includeHandler_.Get(),
+        argumentPointers.data(),
+        UINT32(argumentPointers.size()),
+        dxc.includeHandler.Get(),
         IID_PPV_ARGS(&shaderResult));
     assert(SUCCEEDED(hr));
 
@@ -392,6 +679,9 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const std::wstring
     hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
     assert(SUCCEEDED(hr));
 
+    // 4. 次回の起動のために保存する
+    shaderCache_.Store(cacheKey, shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+
     return shaderBlob;
 }
 
@@ -423,7 +713,10 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateTextureResource(cons
 Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages) {
     std::vector<D3D12_SUBRESOURCE_DATA> subresources;
     DirectX::PrepareUpload(device_.Get(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresources);
+    return UploadTextureData(texture, subresources);
+}
 
+Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::UploadTextureData(ID3D12Resource* texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources) {
     uint64_t intermediateSize = GetRequiredIntermediateSize(texture, 0, UINT(subresources.size()));
     Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(intermediateSize);
 
@@ -439,4 +732,215 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::UploadTextureData(ID3D12Re
     commandList_->ResourceBarrier(1, &barrier);
 
     return intermediateResource;
-}
\ No newline at end of file
+}
+
+Microsoft::WRL::ComPtr<ID3D12RootSignature> DirectXCommon::CreateRootSignature(ID3DBlob* signatureBlob) {
+    ComPtr<ID3D12RootSignature> rootSignature;
+    HRESULT hr = device_->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
+    assert(SUCCEEDED(hr));
+
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    rootSignatureHashes_[rootSignature.Get()] = Hash::XXH64(signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize());
+    return rootSignature;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> DirectXCommon::CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) {
+    std::unique_lock<std::mutex> lock(pipelineMutex_);
+    uint64_t key = HashGraphicsPipelineDesc(desc);
+
+    // 1. 同じ記述の PSO を作ってあれば、それを使う
+    auto found = pipelineStates_.find(key);
+    if (found != pipelineStates_.end()) {
+        ++pipelineStats_.sharedCount;
+        return found->second;
+    }
+
+    // 2. 前回までに作ったものはパイプラインライブラリから読み込む
+    wchar_t name[32];
+    std::swprintf(name, sizeof(name) / sizeof(name[0]), L"%016llx", static_cast<unsigned long long>(HashPipelineLibraryName(key, desc)));
+    ComPtr<ID3D12PipelineState> pipelineState;
+    HRESULT loadResult = pipelineLibrary_ ? pipelineLibrary_->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(&pipelineState)) : E_FAIL;
+    if (SUCCEEDED(loadResult)) {
+        ++pipelineStats_.libraryHitCount;
+    } else {
+        // E_INVALIDARG は名前はあったが記述が違った（名前の付け方の不具合なので気付けるようにする）
+        if (loadResult == E_INVALIDARG) {
+            Logger::Log("DirectXCommon: pipeline library entry does not match its description\n");
+        }
+        // 3. 作る（ドライバのコンパイルは時間がかかるので、その間は他のスレッドを止めない）
+        lock.unlock();
+        HRESULT hr = device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+        assert(SUCCEEDED(hr));
+        lock.lock();
+
+        ++pipelineStats_.createdCount;
+        if (pipelineLibrary_) {
+            HRESULT storeResult = pipelineLibrary_->StorePipeline(name, pipelineState.Get());
+            if (SUCCEEDED(storeResult)) {
+                pipelineLibraryDirty_ = true;
+            } else {
+                // 黙って失敗すると、次の起動でもまたコンパイルすることになる
+                char message[96];
+                std::snprintf(message, sizeof(message), "DirectXCommon: failed to store pipeline in library (hr 0x%08lx)\n", static_cast<unsigned long>(storeResult));
+                Logger::Log(message);
+            }
+        }
+    }
+
+    // 別のスレッドが同じものを同時に作っていたら、先に登録された方を使う
+    auto inserted = pipelineStates_.emplace(key, pipelineState);
+    return inserted.first->second;
+}
+
+void DirectXCommon::SavePipelineLibrary() {
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    if (!pipelineLibrary_ || !pipelineLibraryDirty_) {
+        return;
+    }
+
+    PipelineLibraryFileHeader header{};
+    header.deviceKey = pipelineLibraryDeviceKey_;
+    header.dataSize = pipelineLibrary_->GetSerializedSize();
+    std::vector<uint8_t> data(static_cast<size_t>(header.dataSize));
+    HRESULT hr = pipelineLibrary_->Serialize(data.data(), data.size());
+    if (FAILED(hr)) {
+        return;
+    }
+
+    // 書きかけのファイルを次回の起動で読まないよう、一時ファイルに書いてから名前を変える
+    std::filesystem::path path = kPipelineLibraryPath;
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            return;
+        }
+    }
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return;
+    }
+    pipelineLibraryDirty_ = false;
+}
+
+DirectXCommon::PipelineStats DirectXCommon::GetPipelineStats() {
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    return pipelineStats_;
+}
+
+uint64_t DirectXCommon::HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const {
+    // 結果に影響しない項目（無効にしたブレンド・深度・ステンシルの設定、使わないレンダーターゲットなど）は積まない
+    PipelineStateHasher hasher;
+
+    // ルートシグネチャはシリアライズした中身のハッシュで見る
+    auto rootSignature = rootSignatureHashes_.find(desc.pRootSignature);
+    assert(rootSignature != rootSignatureHashes_.end() && "root signature must be created with DirectXCommon::CreateRootSignature");
+    hasher.AddUInt64(rootSignature != rootSignatureHashes_.end() ? rootSignature->second : 0);
+
+    AddShaderBytecode(hasher, desc.VS);
+    AddShaderBytecode(hasher, desc.PS);
+    AddShaderBytecode(hasher, desc.DS);
+    AddShaderBytecode(hasher, desc.HS);
+    AddShaderBytecode(hasher, desc.GS);
+
+    // StreamOutput
+    hasher.AddUInt32(desc.StreamOutput.NumEntries);
+    for (UINT i = 0; i < desc.StreamOutput.NumEntries; ++i) {
+        const D3D12_SO_DECLARATION_ENTRY& entry = desc.StreamOutput.pSODeclaration[i];
+        hasher.AddUInt32(entry.Stream);
+        hasher.AddString(entry.SemanticName);
+        hasher.AddUInt32(entry.SemanticIndex);
+        hasher.AddUInt32(entry.StartComponent);
+        hasher.AddUInt32(entry.ComponentCount);
+        hasher.AddUInt32(entry.OutputSlot);
+    }
+    hasher.AddUInt32(desc.StreamOutput.NumStrides);
+    for (UINT i = 0; i < desc.StreamOutput.NumStrides; ++i) {
+        hasher.AddUInt32(desc.StreamOutput.pBufferStrides[i]);
+    }
+    if (desc.StreamOutput.NumEntries > 0) {
+        hasher.AddUInt32(desc.StreamOutput.RasterizedStream);
+    }
+
+    // BlendState（IndependentBlendEnable でなければ RenderTarget[0] だけが使われる）
+    hasher.AddBool(desc.BlendState.AlphaToCoverageEnable);
+    hasher.AddBool(desc.BlendState.IndependentBlendEnable);
+    UINT blendCount = desc.BlendState.IndependentBlendEnable ? desc.NumRenderTargets : (std::min)(desc.NumRenderTargets, 1u);
+    for (UINT i = 0; i < blendCount; ++i) {
+        const D3D12_RENDER_TARGET_BLEND_DESC& blend = desc.BlendState.RenderTarget[i];
+        hasher.AddBool(blend.BlendEnable);
+        if (blend.BlendEnable) {
+            hasher.AddUInt32(blend.SrcBlend);
+            hasher.AddUInt32(blend.DestBlend);
+            hasher.AddUInt32(blend.BlendOp);
+            hasher.AddUInt32(blend.SrcBlendAlpha);
+            hasher.AddUInt32(blend.DestBlendAlpha);
+            hasher.AddUInt32(blend.BlendOpAlpha);
+        }
+        hasher.AddBool(blend.LogicOpEnable);
+        if (blend.LogicOpEnable) {
+            hasher.AddUInt32(blend.LogicOp);
+        }
+        hasher.AddUInt32(blend.RenderTargetWriteMask);
+    }
+    hasher.AddUInt32(desc.SampleMask);
+
+    // RasterizerState
+    hasher.AddUInt32(desc.RasterizerState.FillMode);
+    hasher.AddUInt32(desc.RasterizerState.CullMode);
+    hasher.AddBool(desc.RasterizerState.FrontCounterClockwise);
+    hasher.AddUInt32(static_cast<uint32_t>(desc.RasterizerState.DepthBias));
+    hasher.AddFloat(desc.RasterizerState.DepthBiasClamp);
+    hasher.AddFloat(desc.RasterizerState.SlopeScaledDepthBias);
+    hasher.AddBool(desc.RasterizerState.DepthClipEnable);
+    hasher.AddBool(desc.RasterizerState.MultisampleEnable);
+    hasher.AddBool(desc.RasterizerState.AntialiasedLineEnable);
+    hasher.AddUInt32(desc.RasterizerState.ForcedSampleCount);
+    hasher.AddUInt32(desc.RasterizerState.ConservativeRaster);
+
+    // DepthStencilState
+    hasher.AddBool(desc.DepthStencilState.DepthEnable);
+    if (desc.DepthStencilState.DepthEnable) {
+        hasher.AddUInt32(desc.DepthStencilState.DepthWriteMask);
+        hasher.AddUInt32(desc.DepthStencilState.DepthFunc);
+    }
+    hasher.AddBool(desc.DepthStencilState.StencilEnable);
+    if (desc.DepthStencilState.StencilEnable) {
+        hasher.AddUInt32(desc.DepthStencilState.StencilReadMask);
+        hasher.AddUInt32(desc.DepthStencilState.StencilWriteMask);
+        AddStencilOp(hasher, desc.DepthStencilState.FrontFace);
+        AddStencilOp(hasher, desc.DepthStencilState.BackFace);
+    }
+
+    // InputLayout（セマンティクス名はポインタではなく文字列で見る）
+    hasher.AddUInt32(desc.InputLayout.NumElements);
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+        const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+        hasher.AddString(element.SemanticName);
+        hasher.AddUInt32(element.SemanticIndex);
+        hasher.AddUInt32(element.Format);
+        hasher.AddUInt32(element.InputSlot);
+        hasher.AddUInt32(element.AlignedByteOffset);
+        hasher.AddUInt32(element.InputSlotClass);
+        hasher.AddUInt32(element.InstanceDataStepRate);
+    }
+
+    hasher.AddUInt32(desc.IBStripCutValue);
+    hasher.AddUInt32(desc.PrimitiveTopologyType);
+    hasher.AddUInt32(desc.NumRenderTargets);
+    for (UINT i = 0; i < desc.NumRenderTargets; ++i) {
+        hasher.AddUInt32(desc.RTVFormats[i]);
+    }
+    hasher.AddUInt32(desc.DSVFormat);
+    hasher.AddUInt32(desc.SampleDesc.Count);
+    hasher.AddUInt32(desc.SampleDesc.Quality);
+    hasher.AddUInt32(desc.NodeMask);
+    hasher.AddUInt32(desc.Flags);
+    return hasher.Finish();
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "WinApp.h"
+#include "UploadRingAllocator.h"
+#include "FrameScheduler.h"
+#include "DescriptorAllocator.h"
+#include "ShaderCache.h"
 
 #include <array>
 #include <d3d12.h>
@@ -8,17 +12,41 @@
 #include <dxcapi.h>
 #include <wrl.h>
 #include <string>
+#include <vector>
 #include <chrono>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 #include "externals/DirectXTex/DirectXTex.h"
 
+// UTF-8 の文字列をワイド文字列に変換する
+std::wstring ConvertString(const std::string& str);
+
 class DirectXCommon {
 public:
     // 初期化 / 描画前後
-    void Initialize(WinApp* winApp);
+    // framesInFlight: CPUが先行してよいフレーム数（2～3）
+    void Initialize(WinApp* winApp, uint32_t framesInFlight = 2);
     void PreDraw();
     void PostDraw();
 
+    // GPUの処理がすべて終わるまで待つ（終了時・リソースをまとめて破棄する前に呼ぶ）
+    void WaitForGpu();
+
+    // 今のフレームのGPU処理が終わってからリソースを解放する（描画に使ったバッファの差し替えなど）
+    void RetireResource(Microsoft::WRL::ComPtr<ID3D12Resource> resource);
+    // 解放待ちのリソースの数・メモリ量
+    const DeferredReleaseQueue::Stats& GetRetireStats() const { return frameScheduler_.GetRetireStats(); }
+
+    // SRVヒープの番号の割り当て
+    // 常駐：テクスチャなど長く使うもの。FreeSrvIndex したものはGPUが使い終わってから再利用される
+    uint32_t AllocateSrvIndex();
+    void FreeSrvIndex(uint32_t index);
+    // 一時：今のフレームだけ使うもの（連続した count 個の先頭）。解放は要らない
+    uint32_t AllocateTransientSrvIndices(uint32_t count = 1);
+    const DescriptorAllocator::Stats& GetSrvStats() const { return srvAllocator_.GetStats(); }
+
     // SRV ハンドル取得
     D3D12_CPU_DESCRIPTOR_HANDLE GetSRVCPUDescriptorHandle(uint32_t index) const;
     D3D12_GPU_DESCRIPTOR_HANDLE GetSRVGPUDescriptorHandle(uint32_t index) const;
@@ -36,7 +64,34 @@ public:
     Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInBytes);
     Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResource(const DirectX::TexMetadata& metadata);
     Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages);
-    Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const std::wstring& profile);
+    // サブリソースのデータを直接指定して転送する（マップしたファイルの中を指していてもよい）
+    Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource* texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources);
+    // コンパイル結果は cache/shaders に残し、ソース・インクルード・引数が同じなら次回からそれを使う
+    // 複数のスレッドから同時に呼んでよい
+    // additionalArguments: 追加の引数（ShaderPermutation::BuildDefineArguments の #define など）。キャッシュのキーにも含まれる
+    Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const std::wstring& profile, const std::vector<std::wstring>& additionalArguments = {});
+    ShaderCache::Stats GetShaderCacheStats() const { return shaderCache_.GetStats(); }
+
+    // ルートシグネチャを作る（シリアライズした中身のハッシュを覚えておき、PSO のキーに使う）
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> CreateRootSignature(ID3DBlob* signatureBlob);
+    // PSO を作る。記述が同じものは作ったものを使い回し、前回までに作ったものはパイプラインライブラリから読み込む
+    // desc.pRootSignature は CreateRootSignature で作ったもの。複数のスレッドから同時に呼んでよい
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+    // 新しく作った PSO があれば、パイプラインライブラリを cache/pipelines.bin に書き出す（起動時の PSO を作り終えたら呼ぶ）
+    void SavePipelineLibrary();
+
+    // PSO 作成の統計
+    struct PipelineStats {
+        uint32_t createdCount = 0;    // ドライバでコンパイルした数
+        uint32_t libraryHitCount = 0; // パイプラインライブラリから読み込んだ数
+        uint32_t sharedCount = 0;     // 同じ記述の PSO を使い回した数
+    };
+    PipelineStats GetPipelineStats();
+
+    // フレーム内だけ使う一時データ（定数・頂点・インデックス）の領域を切り出す
+    // CreateBufferResource と違いリソースは作らない。GPUが使い終わったら次のフレーム以降で再利用される
+    // リングに入りきらないときだけ専用のバッファを作り、このフレームの終わりに RetireResource で手放す
+    UploadRingAllocator::Allocation AllocateUpload(size_t sizeInBytes, size_t alignment = UploadRingAllocator::kDefaultAlignment);
 
 private:
     void InitializeFixFPS();
@@ -50,8 +105,40 @@ private:
     void InitializeViewport();
     void InitializeScissorRect();
     void InitializeDXCCompiler();
+    void InitializePipelineLibrary();
     void InitializeImGui();
     void InitializeFence();
+    void InitializeUploadRing();
+
+    // フレームスケジューラ用のキュー（コマンドキューとフェンス）
+    class FrameQueue : public FrameScheduler::Queue {
+    public:
+        void Initialize(ID3D12CommandQueue* commandQueue, ID3D12Fence* fence, HANDLE fenceEvent);
+        void Signal(uint64_t fenceValue) override;
+        uint64_t GetCompletedFenceValue() override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+
+    private:
+        ID3D12CommandQueue* commandQueue_ = nullptr;
+        ID3D12Fence* fence_ = nullptr;
+        HANDLE fenceEvent_ = nullptr;
+    };
+
+    // アップロードリングのバックエンド（Map済みのアップロードバッファとフェンス）
+    class UploadRingBackend : public UploadRingAllocator::Backend {
+    public:
+        void Initialize(ID3D12Resource* resource, ID3D12Fence* fence, HANDLE fenceEvent);
+        uint8_t* GetMappedPointer() override { return mappedPointer_; }
+        uint64_t GetGpuAddress() override { return gpuAddress_; }
+        uint64_t GetCompletedFenceValue() override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+
+    private:
+        uint8_t* mappedPointer_ = nullptr;
+        uint64_t gpuAddress_ = 0;
+        ID3D12Fence* fence_ = nullptr;
+        HANDLE fenceEvent_ = nullptr;
+    };
 
     WinApp* winApp_ = nullptr;
 
@@ -61,7 +148,8 @@ private:
     // コマンドキュー（これがないとGPUが動きません）
     Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue_;
 
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator_;
+    // コマンドアロケータはフレームごとに持つ（GPUが使用中のものはResetできないため）
+    std::array<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>, FrameScheduler::kMaxFramesInFlight> commandAllocators_;
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
 
     // スワップチェーン & バックバッファ
@@ -76,21 +164,43 @@ private:
     Microsoft::WRL::ComPtr<ID3D12Resource> depthBuffer_;
     UINT dsvDescriptorSize_ = 0;
 
-    // SRV 用ヒープ
+    // SRV 用ヒープ（番号は srvAllocator_ が割り当てる）
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> srvDescriptorHeap_;
     UINT srvDescriptorSize_ = 0;
+    DescriptorAllocator srvAllocator_;
 
     // フェンス
     Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
-    UINT64 fenceVal_ = 0;
     HANDLE fenceEvent_ = nullptr;
 
+    // 複数フレーム同時処理
+    uint32_t framesInFlight_ = 2;
+    FrameQueue frameQueue_;
+    FrameScheduler frameScheduler_;
+
+    // 一時データ用アップロードリング
+    Microsoft::WRL::ComPtr<ID3D12Resource> uploadRingResource_;
+    UploadRingBackend uploadRingBackend_;
+    UploadRingAllocator uploadRing_;
+
     // ビューポート / シザー
     D3D12_VIEWPORT viewport_{};
     D3D12_RECT     scissorRect_{};
 
-    // DXC
-    Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils_;
-    Microsoft::WRL::ComPtr<IDxcCompiler3> dxcCompiler_;
-    Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler_;
+    // DXC（コンパイラ本体はスレッドごとに作るので、ここにはキャッシュだけを持つ）
+    ShaderCache shaderCache_;
+
+    // PSO のキーを作る（pipelineMutex_ を取った状態で呼ぶ）
+    uint64_t HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const;
+
+    // PSO（キーは記述を正規化したもののハッシュ）
+    std::mutex pipelineMutex_;
+    std::map<ID3D12RootSignature*, uint64_t> rootSignatureHashes_;
+    std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D12PipelineState>> pipelineStates_;
+    PipelineStats pipelineStats_;
+    // パイプラインライブラリ（ライブラリは読み込んだデータを参照し続けるので、データを先に宣言して後に解放する）
+    std::vector<uint8_t> pipelineLibraryData_;
+    Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> pipelineLibrary_;
+    uint64_t pipelineLibraryDeviceKey_ = 0; // GPU とドライバのバージョンのハッシュ（違えば前回のライブラリは使わない）
+    bool pipelineLibraryDirty_ = false;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 struct Material
 {
     float32_t4 color;
-    int32_t enableLighting;
+    int32_t enableLighting; // シェーダーでは読まない（LIGHTING のバリアントで選ぶ）。定数バッファの並びを変えないよう残す
     float32_t4x4 uvTransform;
 };
 
@@ -27,30 +27,38 @@ struct PixelShaderOutput
 
 
 
+// バリアント（ShaderPermutation）で切り替える機能
+// LIGHTING: 平行光源のライティング（gMaterial.enableLighting の代わり）
+// ALPHA_TEST: 完全に透明なピクセルを捨てる
+// UV_TRANSFORM: UV に gMaterial.uvTransform を掛ける（無ければ単位行列とみなす）
 PixelShaderOutput main(VertexShaderOutput input)
 {
     PixelShaderOutput output;
-    output.color = gMaterial.color;
     
+#ifdef UV_TRANSFORM
      // UV変換
     float4 transformedUV = mul(float32_t4(input.texcoord,0.0f, 1.0f), gMaterial.uvTransform);
-    
     float32_t4 textureColor = gTexture.Sample(gSampler, transformedUV.xy);
+#else
+    float32_t4 textureColor = gTexture.Sample(gSampler, input.texcoord);
+#endif
     
-    if (gMaterial.enableLighting != 0)//Lightingする場合
-    {
-        
-        float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
-        float cos = pow(NdotL * 0.5f + 0.5f, 2.0f);
-        output.color = gMaterial.color * textureColor * gDirectionalLight.color * cos * gDirectionalLight.intensity;
-       
-    }else{
+#ifdef LIGHTING
+    float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
+    float cos = pow(NdotL * 0.5f + 0.5f, 2.0f);
+    output.color = gMaterial.color * textureColor * gDirectionalLight.color * cos * gDirectionalLight.intensity;
+#else
+    output.color = gMaterial.color * textureColor;
+#endif
     
-        output.color = gMaterial.color * textureColor;
-        
+#ifdef ALPHA_TEST
+    // アルファテスト: 完全に透明なピクセルは描画しない
+    if (output.color.a == 0.0f)
+    {
+        discard;
     }
+#endif
     
     return output;
     
 }
-
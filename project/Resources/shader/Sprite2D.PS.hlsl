@@ -1,19 +1,15 @@
 #include "Sprite2D.hlsli"
 
-struct Material
+// SRVヒープ全体（バインドレス）。描画するテクスチャは番号で選ぶ
+Texture2D<float32_t4> gTextures[] : register(t0);
+SamplerState gSampler : register(s0);
+
+// 描画ごとの定数（ルート定数）
+struct DrawConstants
 {
-    float32_t4 color;
-    int32_t enableLighting; // スプライトでは使わないが、パディング合わせで残しておくのが安全
-    float32_t3 padding;
-    float32_t4x4 uvTransform;
+    uint32_t textureIndex; // SRVヒープの先頭からの番号
 };
-
-// Sprite.cppの実装に合わせて register(b0) に設定
-// (RootParam 0 に割り当てられていると仮定)
-ConstantBuffer<Material> gMaterial : register(b0);
-
-Texture2D<float32_t4> gTexture : register(t0);
-SamplerState gSampler : register(s0);
+ConstantBuffer<DrawConstants> gDrawConstants : register(b1);
 
 struct PixelShaderOutput
 {
@@ -24,20 +20,19 @@ PixelShaderOutput main(VertexShaderOutput input)
 {
     PixelShaderOutput output;
     
-    // UV変換 (必要なら)
-    float4 transformedUV = mul(float32_t4(input.texcoord, 0.0f, 1.0f), gMaterial.uvTransform);
-    
     // テクスチャサンプリング
-    float32_t4 textureColor = gTexture.Sample(gSampler, transformedUV.xy);
+    float32_t4 textureColor = gTextures[gDrawConstants.textureIndex].Sample(gSampler, input.texcoord);
     
-    // マテリアル色とテクスチャ色を合成
-    output.color = gMaterial.color * textureColor;
+    // 頂点色（スプライトの色）とテクスチャ色を合成
+    output.color = input.color * textureColor;
     
+#ifdef ALPHA_TEST
     // アルファテスト: 完全に透明なピクセルは描画しない
     if (output.color.a == 0.0f)
     {
         discard;
     }
+#endif
     
     return output;
-}
\ No newline at end of file
+}
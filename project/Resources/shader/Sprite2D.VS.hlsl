@@ -1,19 +1,18 @@
 #include "Sprite2D.hlsli"
 
-struct TransformationMatrix
+// 全スプライト共通のビュー・プロジェクション行列
+// 頂点はCPU側でワールド座標に変換済み（SpriteBatch）
+struct ViewProjection
 {
-    float32_t4x4 WVP;
-    float32_t4x4 World;
+    float32_t4x4 matrix;
 };
-
-// register(b1) から register(b0) に修正
-// 多くのルートシグネチャ設定では、VertexShader用のCBVは b0 から始まります
-ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
+ConstantBuffer<ViewProjection> gViewProjection : register(b0);
 
 struct VertexShaderInput
 {
     float32_t4 position : POSITION0;
     float32_t2 texcoord : TEXCOORD0;
+    float32_t4 color : COLOR0;
 };
 
 VertexShaderOutput main(VertexShaderInput input)
@@ -21,8 +20,9 @@ VertexShaderOutput main(VertexShaderInput input)
     VertexShaderOutput output;
     
     // 座標変換
-    output.position = mul(input.position, gTransformationMatrix.WVP);
+    output.position = mul(input.position, gViewProjection.matrix);
     output.texcoord = input.texcoord;
+    output.color = input.color;
     
     return output;
-}
\ No newline at end of file
+}
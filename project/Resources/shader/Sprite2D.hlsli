@@ -2,4 +2,5 @@ struct VertexShaderOutput
 {
     float32_t4 position : SV_POSITION; // システム用頂点座標
     float32_t2 texcoord : TEXCOORD0; // テクスチャ座標
-};
\ No newline at end of file
+    float32_t4 color : COLOR0; // 頂点カラー（スプライトの色）
+};
@@ -0,0 +1,31 @@
+#include "Sprite2DInstanced.hlsli"
+
+// SRVヒープ全体（バインドレス）。テクスチャはインスタンスごとに違うので NonUniformResourceIndex を付ける
+Texture2D<float32_t4> gTextures[] : register(t0);
+SamplerState gSampler : register(s0);
+
+struct PixelShaderOutput
+{
+    float32_t4 color : SV_Target0;
+};
+
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+
+    // テクスチャサンプリング
+    float32_t4 textureColor = gTextures[NonUniformResourceIndex(input.textureIndex)].Sample(gSampler, input.texcoord);
+
+    // スプライトの色とテクスチャ色を合成
+    output.color = input.color * textureColor;
+
+#ifdef ALPHA_TEST
+    // アルファテスト: 完全に透明なピクセルは描画しない
+    if (output.color.a == 0.0f)
+    {
+        discard;
+    }
+#endif
+
+    return output;
+}
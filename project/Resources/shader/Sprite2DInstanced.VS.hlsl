@@ -0,0 +1,50 @@
+#include "Sprite2DInstanced.hlsli"
+
+// 全スプライト共通のビュー・プロジェクション行列
+struct ViewProjection
+{
+    float32_t4x4 matrix;
+};
+ConstantBuffer<ViewProjection> gViewProjection : register(b0);
+
+// スプライト1枚分のデータ（C++ の SpriteInstance と同じ並び）
+struct SpriteInstance
+{
+    float32_t2 position;
+    float32_t2 size;
+    float32_t2 anchorPoint;
+    float32_t cosine;
+    float32_t sine;
+    float32_t4 uvRect; // 左, 上, 右, 下
+    float32_t4 color;
+    uint32_t textureIndex;
+    uint32_t3 padding;
+};
+StructuredBuffer<SpriteInstance> gInstances : register(t0, space1);
+
+// 四角形1枚（インデックス 0,1,2 / 1,3,2）を SV_InstanceID のスプライトとして描く
+// 計算は CPU 側の ExpandSpriteInstance と同じ
+VertexShaderOutput main(uint32_t vertexId : SV_VertexID, uint32_t instanceId : SV_InstanceID)
+{
+    SpriteInstance instance = gInstances[instanceId];
+
+    // bit1: 右か, bit0: 上か（0: 左下, 1: 左上, 2: 右下, 3: 右上）
+    bool isRight = (vertexId & 2) != 0;
+    bool isTop = (vertexId & 1) != 0;
+
+    // ローカル座標（アンカー考慮）→ 回転・平行移動
+    float32_t x = ((isRight ? 1.0f : 0.0f) - instance.anchorPoint.x) * instance.size.x;
+    float32_t y = ((isTop ? 0.0f : 1.0f) - instance.anchorPoint.y) * instance.size.y;
+    float32_t4 position = float32_t4(
+        x * instance.cosine - y * instance.sine + instance.position.x,
+        x * instance.sine + y * instance.cosine + instance.position.y,
+        0.0f,
+        1.0f);
+
+    VertexShaderOutput output;
+    output.position = mul(position, gViewProjection.matrix);
+    output.texcoord = float32_t2(isRight ? instance.uvRect.z : instance.uvRect.x, isTop ? instance.uvRect.y : instance.uvRect.w);
+    output.color = instance.color;
+    output.textureIndex = instance.textureIndex;
+    return output;
+}
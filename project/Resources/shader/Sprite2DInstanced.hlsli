@@ -0,0 +1,7 @@
+struct VertexShaderOutput
+{
+    float32_t4 position : SV_POSITION; // システム用頂点座標
+    float32_t2 texcoord : TEXCOORD0; // テクスチャ座標
+    float32_t4 color : COLOR0; // スプライトの色
+    nointerpolation uint32_t textureIndex : TEXTURE_INDEX0; // テクスチャのSRVの番号
+};
@@ -1,99 +1,56 @@
 #pragma once
 #include "SpriteCommon.h"
-#include "Matrix.h"
+#include "SpriteQuad.h"
 
 class Sprite {
 public:
     // 初期化（テクスチャ番号を指定）
     void Initialize(SpriteCommon* spriteCommon, uint32_t textureHandle = 0);
 
-    // 更新
+    // 更新（前回から何も変わっていなければ何もしない）
+    // 非同期読み込みでテクスチャが差し替わって大きさが変わっていれば、ここでサイズと UV を合わせ直す
     void Update();
 
-    // 描画
+    // 描画（SpriteCommon のバッチに登録する。実際の描画は SpriteCommon::PostDraw）
     void Draw();
 
     // --- ゲッター・セッター ---
 
     // 座標
-    const Vector2& GetPosition() const { return position_; }
-    void SetPosition(const Vector2& position) { position_ = position; }
+    const Vector2& GetPosition() const { return quad_.GetPosition(); }
+    void SetPosition(const Vector2& position) { quad_.SetPosition(position); }
 
     // 回転 (これが無いとエラーになります！)
-    float GetRotation() const { return rotation_; }
-    void SetRotation(float rotation) { rotation_ = rotation; }
+    float GetRotation() const { return quad_.GetRotation(); }
+    void SetRotation(float rotation) { quad_.SetRotation(rotation); }
 
     // サイズ（通常はテクスチャサイズが自動設定されますが、手動変更も可能）
-    const Vector2& GetSize() const { return size_; }
-    void SetSize(const Vector2& size) { size_ = size; }
+    const Vector2& GetSize() const { return quad_.GetSize(); }
+    void SetSize(const Vector2& size) { quad_.SetSize(size); }
 
     // 色
-    const Vector4& GetColor() const { return materialData_->color; }
-    void SetColor(const Vector4& color) { materialData_->color = color; }
+    const Vector4& GetColor() const { return quad_.GetColor(); }
+    void SetColor(const Vector4& color) { quad_.SetColor(color); }
 
     // テクスチャ変更
     void SetTexture(uint32_t textureHandle);
 
     // テクスチャ切り出し範囲（左上座標、サイズ）
-    void SetTextureRect(const Vector2& leftTop, const Vector2& size);
+    void SetTextureRect(const Vector2& leftTop, const Vector2& size) { quad_.SetTextureRect(leftTop, size); }
+    // テクスチャと切り出し範囲をまとめて設定する（SpriteCommon::LoadTextureAtlas の戻り値を渡す）
+    void SetTextureRegion(const SpriteCommon::TextureRegion& region);
 
     // アンカーポイント（0.5, 0.5で中心、0,0で左上）
-    void SetAnchorPoint(const Vector2& anchorPoint) { anchorPoint_ = anchorPoint; }
+    void SetAnchorPoint(const Vector2& anchorPoint) { quad_.SetAnchorPoint(anchorPoint); }
 
     // 左右・上下反転
-    void SetFlip(bool isFlipX, bool isFlipY) { isFlipX_ = isFlipX; isFlipY_ = isFlipY; }
-
-private:
-    // 頂点データの更新（サイズや切り取り範囲が変わったら呼ぶ）
-    void AdjustTextureRect();
+    void SetFlip(bool isFlipX, bool isFlipY) { quad_.SetFlip(isFlipX, isFlipY); }
 
 private:
     SpriteCommon* spriteCommon_ = nullptr;
 
-    struct VertexData {
-        Vector4 position;
-        Vector4 texcoord;
-    };
-
-    struct Material {
-        Vector4 color;
-        int32_t enableLighting;
-        float padding[3];
-        Matrix4x4 uvTransform;
-    };
-
-    struct TransformationMatrix {
-        Matrix4x4 WVP;
-        Matrix4x4 World;
-    };
-
-    // バッファリソース
-    Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
-    D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-    VertexData* vertexData_ = nullptr;
-
-    Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
-    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
-    uint32_t* indexData_ = nullptr;
-
-    Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
-    Material* materialData_ = nullptr;
-
-    Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource_;
-    TransformationMatrix* transformationMatrixData_ = nullptr;
-
-    Transform uvTransform_{ {1,1,1}, {0,0,0}, {0,0,0} };
-
-    // スプライトパラメータ
-    Vector2 position_ = { 0.0f, 0.0f };
-    float rotation_ = 0.0f;
-    Vector2 size_ = { 100.0f, 100.0f };
-    Vector2 anchorPoint_ = { 0.0f, 0.0f }; // デフォルトは左上
-    bool isFlipX_ = false;
-    bool isFlipY_ = false;
-
-    // テクスチャ関連
-    uint32_t textureHandle_ = 0; // 使っているテクスチャの番号
-    Vector2 textureLeftTop_ = { 0.0f, 0.0f }; // テクスチャの左上オフセット
-    Vector2 textureSize_ = { 100.0f, 100.0f }; // テクスチャの切り出しサイズ
+    // 使っているテクスチャの番号
+    uint32_t textureHandle_ = 0;
+    // パラメータと頂点（変わったところだけ Update で作り直す）
+    SpriteQuad quad_;
 };
\ No newline at end of file
@@ -1,16 +1,50 @@
 #include "SpriteCommon.h"
 #include "Logger.h"
+#include "MathConstexpr.h"
+#include "TextureDecoder.h"
+#include "JobGraph.h"
 #include <cassert>
+#include <algorithm>
+#include <climits>
 
-void SpriteCommon::Initialize(DirectXCommon* dxCommon) {
+namespace {
+    // 最初に確保しておくバッチのスプライト数
+    constexpr uint32_t kInitialBatchCapacity = 1024;
+
+    // デコード済み画像のキャッシュを置く場所（実行時のカレントディレクトリから）
+    constexpr char kTextureCacheDirectory[] = "cache/textures";
+
+    // 読み込み中のテクスチャの代わりに表示する色（灰色）
+    constexpr uint8_t kPlaceholderColor[4] = { 128, 128, 128, 255 };
+    // 代わりのテクスチャの大きさ（1x1）
+    constexpr Vector2 kPlaceholderSize = { 1.0f, 1.0f };
+
+    // 画面サイズの平行投影。原点は左上。（コンパイル時に計算される）
+    constexpr Matrix4x4 kViewProjectionMatrix = MathConstexpr::Multiply(
+        MathConstexpr::MakeIdentity4x4(),
+        MathConstexpr::MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f));
+}
+
+void SpriteCommon::Initialize(DirectXCommon* dxCommon, ThreadPool* threadPool) {
     assert(dxCommon);
     dxCommon_ = dxCommon;
+    textureCache_.Initialize(kTextureCacheDirectory);
+    asyncTextureLoader_.Initialize(threadPool, &textureCache_);
 
     // ① ルートシグネチャ作成
     CreateRootSignature();
 
     // ② グラフィックスパイプライン作成
-    CreateGraphicsPipelineState();
+    CreateGraphicsPipelineState(threadPool);
+
+    // ③ 全スプライト共通のビュー・プロジェクション行列
+    CreateViewProjectionResource();
+
+    // ④ バッチ用インデックスバッファ（足りなくなったら PostDraw で拡張する）
+    EnsureBatchCapacity(kInitialBatchCapacity);
+
+    // ⑤ 読み込み中に使う代わりのテクスチャ
+    CreatePlaceholderTexture();
 }
 
 void SpriteCommon::PreDraw() {
@@ -18,16 +52,131 @@ void SpriteCommon::PreDraw() {
 
     ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
 
-    // ルートシグネチャをセット
+    // 前のフレームの描画コマンドの統計を締める
+    commandRecorder_.EndFrame();
+
+    // ルートシグネチャをセット（ルートパラメータは未設定に戻るので、記録した値も忘れる）
     commandList->SetGraphicsRootSignature(rootSignature_.Get());
-    // パイプラインステートをセット
-    commandList->SetPipelineState(pipelineState_.Get());
+    recorderCommandList_.Initialize(commandList);
+    commandRecorder_.Reset(&recorderCommandList_);
+    // パイプラインステートをセット（設定に合うシェーダーのバリアント）
+    commandList->SetPipelineState(pipelineStates_[GetShaderFeatures()].Get());
     // プリミティブトポロジをセット
     commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     // SRVヒープの設定（テクスチャを使うために必須）
     ID3D12DescriptorHeap* ppHeaps[] = { dxCommon_->GetSrvHeap() };
     commandList->SetDescriptorHeaps(1, ppHeaps);
+
+    // 非同期で読み込み終わったテクスチャをまとめてGPUへ転送する
+    // （このフレームの描画より前にコマンドリストへ積むので、このフレームから使える）
+    ProcessCompletedTextureLoads();
+
+    // このフレームのスプライト受付開始
+    spriteBatch_.Begin();
+}
+
+void SpriteCommon::PostDraw() {
+    assert(dxCommon_);
+
+    // 更新の統計をこのフレームの分で締める
+    lastUpdateStats_ = currentUpdateStats_;
+    currentUpdateStats_ = {};
+
+    spriteBatch_.End();
+    uint32_t spriteCount = spriteBatch_.GetSpriteCount();
+    if (spriteCount == 0) {
+        return;
+    }
+
+    // 並べ替え済みの頂点を、このフレーム用にアップロードリングから切り出した領域へ書き込む
+    UploadRingAllocator::Allocation vertexAllocation = dxCommon_->AllocateUpload(sizeof(SpriteBatch::Vertex) * SpriteBatch::kVerticesPerSprite * spriteCount);
+    spriteBatch_.WriteVertices(static_cast<SpriteBatch::Vertex*>(vertexAllocation.cpuAddress));
+
+    DrawVertices(vertexAllocation.gpuAddress, spriteCount, spriteBatch_.GetDrawRuns());
+}
+
+void SpriteCommon::DrawSpriteSystem(SpriteSystem& spriteSystem, ThreadPool* threadPool) {
+    assert(dxCommon_);
+
+    // 読み込みが終わって大きさが変わったテクスチャがあれば合わせ直す
+    spriteSystem.SyncTextureSizes(textureSizes_);
+
+    uint32_t spriteCount = spriteSystem.GetCount();
+    if (spriteCount == 0) {
+        return;
+    }
+
+    // 全スプライトの頂点をアップロードリングの領域へ直接書き込む（中間の配列を通さない）
+    UploadRingAllocator::Allocation vertexAllocation = dxCommon_->AllocateUpload(sizeof(SpriteBatch::Vertex) * SpriteBatch::kVerticesPerSprite * spriteCount);
+    std::span<SpriteBatch::Vertex> vertices(static_cast<SpriteBatch::Vertex*>(vertexAllocation.cpuAddress), size_t(spriteCount) * SpriteBatch::kVerticesPerSprite);
+    spriteSystem.WriteVertices(vertices, threadPool);
+
+    spriteSystem.BuildDrawRuns(systemDrawRuns_);
+    DrawVertices(vertexAllocation.gpuAddress, spriteCount, systemDrawRuns_);
+}
+
+void SpriteCommon::DrawSpriteSystemInstanced(SpriteSystem& spriteSystem, ThreadPool* threadPool) {
+    assert(dxCommon_);
+
+    // 読み込みが終わって大きさが変わったテクスチャがあれば合わせ直す
+    spriteSystem.SyncTextureSizes(textureSizes_);
+
+    uint32_t spriteCount = spriteSystem.GetCount();
+    if (spriteCount == 0) {
+        return;
+    }
+
+    // スプライト1枚につき SpriteInstance 1つだけをアップロードする（頂点は頂点シェーダーが作る）
+    UploadRingAllocator::Allocation instanceAllocation = dxCommon_->AllocateUpload(sizeof(SpriteInstance) * spriteCount);
+    std::span<SpriteInstance> instances(static_cast<SpriteInstance*>(instanceAllocation.cpuAddress), spriteCount);
+    spriteSystem.WriteInstances(instances, textureSrvIndices_, threadPool);
+
+    ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+
+    // 四角形1枚分のインデックス（バッチ用のインデックスバッファの先頭を使う）
+    D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+    indexBufferView.BufferLocation = batchIndexResource_->GetGPUVirtualAddress();
+    indexBufferView.SizeInBytes = sizeof(uint32_t) * SpriteBatch::kIndicesPerSprite;
+    indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+    commandList->IASetIndexBuffer(&indexBufferView);
+
+    // テクスチャはインスタンスごとに持っているので、テクスチャが混ざっていても1回で描画できる
+    commandList->SetPipelineState(instancedPipelineStates_[GetShaderFeatures()].Get());
+    commandRecorder_.SetViewProjection(viewProjectionResource_->GetGPUVirtualAddress());
+    commandRecorder_.SetTextureTable(dxCommon_->GetSRVGPUDescriptorHandle(0).ptr);
+    commandRecorder_.DrawInstances(instanceAllocation.gpuAddress, spriteCount);
+
+    // バッチ描画用に戻しておく
+    commandList->SetPipelineState(pipelineStates_[GetShaderFeatures()].Get());
+}
+
+void SpriteCommon::DrawVertices(D3D12_GPU_VIRTUAL_ADDRESS vertexAddress, uint32_t spriteCount, const std::vector<SpriteBatch::DrawRun>& drawRuns) {
+    EnsureBatchCapacity(spriteCount);
+
+    ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+
+    D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+    vertexBufferView.BufferLocation = vertexAddress;
+    vertexBufferView.SizeInBytes = sizeof(SpriteBatch::Vertex) * SpriteBatch::kVerticesPerSprite * spriteCount;
+    vertexBufferView.StrideInBytes = sizeof(SpriteBatch::Vertex);
+
+    D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+    indexBufferView.BufferLocation = batchIndexResource_->GetGPUVirtualAddress();
+    indexBufferView.SizeInBytes = sizeof(uint32_t) * SpriteBatch::kIndicesPerSprite * spriteCount;
+    indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+    commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+    commandList->IASetIndexBuffer(&indexBufferView);
+
+    // ビュー・プロジェクション行列 (RootParam 0)
+    // SRVヒープ全体 (RootParam 1)。テクスチャはシェーダーがSRVの番号で引く
+    // （同じフレームで前に設定した値と同じなら、コマンドは積まれない）
+    commandRecorder_.SetViewProjection(viewProjectionResource_->GetGPUVirtualAddress());
+    commandRecorder_.SetTextureTable(dxCommon_->GetSRVGPUDescriptorHandle(0).ptr);
+
+    // テクスチャが同じ範囲ごとに1回だけ描画する（切り替えはSRVの番号 (RootParam 2) を変えるだけ）
+    commandRecorder_.DrawRuns(drawRuns, [this](uint32_t textureHandle) { return GetSrvIndex(textureHandle); });
 }
 
 // テクスチャ読み込み機能
@@ -39,23 +188,183 @@ uint32_t SpriteCommon::LoadTexture(const std::string& filePath) {
 
     assert(dxCommon_);
 
+    // クック済みの DDS があればそちらを読む
+    std::wstring resolvedPath = TextureDecoder::ResolveCookedPath(ConvertString(filePath));
+
+    // 中身が同じ画像を別のパスで読み込み済みなら、それを共有する（デコードも転送もしない）
+    uint64_t contentHash = TextureCache::HashFile(resolvedPath);
+    auto it = contentMap_.find(contentHash);
+    if (it != contentMap_.end()) {
+        textureMap_[filePath] = it->second;
+        return it->second;
+    }
+
     // 1. ファイルから画像を読み込む
-    DirectX::ScratchImage mipImages = dxCommon_->LoadTexture(filePath);
+    // DDS とキャッシュにあったものはマップして中身をそのまま転送し、それ以外はデコードしてキャッシュに残す
+    AsyncTextureLoader::Result result;
+    result.textureHandle = AllocateTextureHandle();
+    asyncTextureLoader_.Load(resolvedPath, contentHash, result);
+    assert(SUCCEEDED(result.hr));
+
+    // 2. リソース作成・転送・SRV作成
+    CompleteTextureLoad(result);
+    uint32_t textureHandle = result.textureHandle;
+
+    // マップに登録
+    textureMap_[filePath] = textureHandle;
+
+    return textureHandle;
+}
+
+uint32_t SpriteCommon::LoadTextureAsync(const std::string& filePath) {
+    if (textureMap_.contains(filePath)) {
+        return textureMap_[filePath];
+    }
+
+    // 読み込みが終わるまでは代わりのテクスチャを指しておく
+    uint32_t textureHandle = AllocateTextureHandle();
+    textureMap_[filePath] = textureHandle;
+    isTextureLoading_[textureHandle] = true;
+
+    // デコードとミップマップ生成はワーカースレッドで行う（クック済みの DDS があればそちらを読む）
+    asyncTextureLoader_.Request(textureHandle, TextureDecoder::ResolveCookedPath(ConvertString(filePath)));
+
+    return textureHandle;
+}
+
+std::vector<SpriteCommon::TextureRegion> SpriteCommon::LoadTextureAtlas(const std::vector<std::string>& filePaths, uint32_t pageSize) {
+    assert(dxCommon_);
+
+    // 1. 画像を読み込む（ミップマップはページごとに作るので、ここでは作らない）
+    std::vector<DirectX::ScratchImage> sourceImages(filePaths.size());
+    std::vector<const DirectX::Image*> images(filePaths.size());
+    for (size_t i = 0; i < filePaths.size(); ++i) {
+        HRESULT hr = TextureDecoder::Load(ConvertString(filePaths[i]), sourceImages[i]);
+        assert(SUCCEEDED(hr));
+        images[i] = sourceImages[i].GetImage(0, 0, 0);
+    }
+
+    // 2. ページに詰めて貼り付ける
+    TextureAtlas atlas;
+    HRESULT hr = atlas.Build(images, pageSize);
+    assert(SUCCEEDED(hr));
+
+    // 3. ページをテクスチャにする
+    std::vector<uint32_t> pageHandles;
+    for (const DirectX::ScratchImage& page : atlas.GetPages()) {
+        uint32_t textureHandle = AllocateTextureHandle();
+        CreateTexture(textureHandle, page);
+        pageHandles.push_back(textureHandle);
+    }
+
+    // 4. 画像ごとの切り出し範囲
+    std::vector<TextureRegion> regions;
+    regions.reserve(filePaths.size());
+    for (const TextureAtlas::Region& region : atlas.GetRegions()) {
+        regions.push_back({
+            pageHandles[region.page],
+            { float(region.x), float(region.y) },
+            { float(region.width), float(region.height) }
+        });
+    }
+    return regions;
+}
+
+bool SpriteCommon::IsTextureReady(uint32_t textureHandle) const {
+    assert(textureHandle < textureSrvIndices_.size());
+    return textureSrvIndices_[textureHandle] != placeholderSrvIndex_;
+}
+
+void SpriteCommon::UnloadTexture(uint32_t textureHandle) {
+    assert(textureHandle < textureSrvIndices_.size());
+
+    // もう一度読み込んだときに作り直されるよう、このパスの登録を消す
+    std::erase_if(textureMap_, [textureHandle](const auto& pair) { return pair.second == textureHandle; });
+
+    // 読み込み中なら、終わったときに結果を捨てるよう印を外す（ハンドルは代わりのテクスチャのまま）
+    if (isTextureLoading_[textureHandle]) {
+        isTextureLoading_[textureHandle] = false;
+        return;
+    }
+
+    uint32_t srvIndex = textureSrvIndices_[textureHandle];
+    if (srvIndex == placeholderSrvIndex_) {
+        return;
+    }
+
+    // ハンドルは代わりのテクスチャに戻す（番号は詰めないので、他のハンドルはそのまま使える）
+    Microsoft::WRL::ComPtr<ID3D12Resource> textureResource = std::move(textureResources_[textureHandle]);
+    textureResources_[textureHandle] = placeholderResource_;
+    textureSrvIndices_[textureHandle] = placeholderSrvIndex_;
+    textureSizes_[textureHandle] = kPlaceholderSize;
+
+    // 同じ中身で共有している別のハンドルがあれば、リソースとSRVは残し、中身のハッシュの登録もそちらに付け替える
+    auto shared = std::find(textureSrvIndices_.begin(), textureSrvIndices_.end(), srvIndex);
+    if (shared != textureSrvIndices_.end()) {
+        uint32_t sharedHandle = static_cast<uint32_t>(shared - textureSrvIndices_.begin());
+        for (auto& [contentHash, handle] : contentMap_) {
+            if (handle == textureHandle) {
+                handle = sharedHandle;
+            }
+        }
+        return;
+    }
+    std::erase_if(contentMap_, [textureHandle](const auto& pair) { return pair.second == textureHandle; });
+
+    // このフレームの描画がまだ使うかもしれないので、GPUが通過してから解放する
+    dxCommon_->RetireResource(textureResource);
+    dxCommon_->FreeSrvIndex(srvIndex);
+}
+
+uint32_t SpriteCommon::AllocateTextureHandle() {
+    uint32_t textureHandle = static_cast<uint32_t>(textureResources_.size());
+    textureResources_.push_back(placeholderResource_);
+    textureSrvIndices_.push_back(placeholderSrvIndex_);
+    textureSizes_.push_back(kPlaceholderSize);
+    isTextureLoading_.push_back(false);
+    return textureHandle;
+}
+
+void SpriteCommon::CreateTexture(uint32_t textureHandle, const DirectX::ScratchImage& mipImages) {
     const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
 
-    // 2. テクスチャリソースを作成
+    // 1. テクスチャリソースを作成
     Microsoft::WRL::ComPtr<ID3D12Resource> textureResource = dxCommon_->CreateTextureResource(metadata);
 
-    // 3. データをGPUに転送
+    // 2. データをGPUに転送
+    // 中間リソースはコピーが終わったら要らないので、このフレームのGPU処理が終わったら解放する
     Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = dxCommon_->UploadTextureData(textureResource.Get(), mipImages);
+    dxCommon_->RetireResource(intermediateResource);
+
+    // 3. SRV作成
+    RegisterTexture(textureHandle, textureResource, metadata);
+}
+
+void SpriteCommon::CreateTexture(uint32_t textureHandle, const MappedFile& mappedFile, const DdsLayout& ddsLayout) {
+    // 1. テクスチャリソースを作成
+    Microsoft::WRL::ComPtr<ID3D12Resource> textureResource = dxCommon_->CreateTextureResource(ddsLayout.metadata);
+
+    // 2. マップしたファイルの中を直接指して転送する
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    subresources.reserve(ddsLayout.subresources.size());
+    for (const DdsLayout::Subresource& subresource : ddsLayout.subresources) {
+        subresources.push_back({
+            mappedFile.GetData() + subresource.offset,
+            LONG_PTR(subresource.rowPitch),
+            LONG_PTR(subresource.slicePitch)
+        });
+    }
+    Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = dxCommon_->UploadTextureData(textureResource.Get(), subresources);
+    dxCommon_->RetireResource(intermediateResource);
 
-    // リストに登録
-    textureResources_.push_back(textureResource);
-    intermediateResources_.push_back(intermediateResource);
+    // 3. SRV作成
+    RegisterTexture(textureHandle, textureResource, ddsLayout.metadata);
+}
 
-    // 4. SRV（シェーダーリソースビュー）を作成
-    uint32_t index = srvIndex_;
-    srvIndex_++;
+void SpriteCommon::RegisterTexture(uint32_t textureHandle, const Microsoft::WRL::ComPtr<ID3D12Resource>& textureResource, const DirectX::TexMetadata& metadata) {
+    // SRV（シェーダーリソースビュー）を作成
+    // 代わりのテクスチャの SRV は前のフレームがまだ使っているかもしれないので、書き換えずに新しい番号を使う
+    uint32_t srvIndex = dxCommon_->AllocateSrvIndex();
 
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
     srvDesc.Format = metadata.format;
@@ -67,18 +376,106 @@ uint32_t SpriteCommon::LoadTexture(const std::string& filePath) {
     dxCommon_->GetDevice()->CreateShaderResourceView(
         textureResource.Get(),
         &srvDesc,
-        dxCommon_->GetSRVCPUDescriptorHandle(index)
+        dxCommon_->GetSRVCPUDescriptorHandle(srvIndex)
     );
 
-    // マップに登録
-    textureMap_[filePath] = index;
+    // ハンドルの指す先を差し替える
+    textureResources_[textureHandle] = textureResource;
+    textureSrvIndices_[textureHandle] = srvIndex;
+    textureSizes_[textureHandle] = { float(metadata.width), float(metadata.height) };
+}
+
+void SpriteCommon::CreatePlaceholderTexture() {
+    // 1x1 の単色画像
+    DirectX::ScratchImage image{};
+    HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1, 1, 1, 1);
+    assert(SUCCEEDED(hr));
+    std::copy(std::begin(kPlaceholderColor), std::end(kPlaceholderColor), image.GetPixels());
+
+    // 一度ハンドルとして作ってから、代わりのテクスチャとして覚えておく
+    uint32_t textureHandle = AllocateTextureHandle();
+    CreateTexture(textureHandle, image);
+    placeholderResource_ = textureResources_[textureHandle];
+    placeholderSrvIndex_ = textureSrvIndices_[textureHandle];
+    textureResources_.pop_back();
+    textureSrvIndices_.pop_back();
+    textureSizes_.pop_back();
+    isTextureLoading_.pop_back();
+}
+
+void SpriteCommon::ProcessCompletedTextureLoads() {
+    asyncTextureLoader_.CollectCompleted(completedTextureLoads_);
+    for (AsyncTextureLoader::Result& result : completedTextureLoads_) {
+        // 読み込み中に UnloadTexture されたものは捨てる
+        if (!isTextureLoading_[result.textureHandle]) {
+            continue;
+        }
+        isTextureLoading_[result.textureHandle] = false;
+        if (FAILED(result.hr)) {
+            // 読めなかったものは代わりのテクスチャのままにする
+            Logger::Log("SpriteCommon: failed to load texture (handle " + std::to_string(result.textureHandle) + ")\n");
+            continue;
+        }
+        CompleteTextureLoad(result);
+    }
+    // 転送し終えたので、マップしたファイルもここで閉じる
+    completedTextureLoads_.clear();
+}
+
+void SpriteCommon::CompleteTextureLoad(const AsyncTextureLoader::Result& result) {
+    // 中身が同じ画像が読み込み済みなら、リソースとSRVをそのまま指す
+    auto it = contentMap_.find(result.contentHash);
+    if (it != contentMap_.end()) {
+        textureResources_[result.textureHandle] = textureResources_[it->second];
+        textureSrvIndices_[result.textureHandle] = textureSrvIndices_[it->second];
+        textureSizes_[result.textureHandle] = textureSizes_[it->second];
+        return;
+    }
+
+    if (result.mappedFile.IsOpen()) {
+        CreateTexture(result.textureHandle, result.mappedFile, result.ddsLayout);
+    } else {
+        CreateTexture(result.textureHandle, result.mipImages);
+    }
+    if (result.contentHash != TextureCache::kInvalidKey) {
+        contentMap_[result.contentHash] = result.textureHandle;
+    }
+}
+
+uint32_t SpriteCommon::GetSrvIndex(uint32_t textureHandle) const {
+    assert(textureHandle < textureSrvIndices_.size());
+    return textureSrvIndices_[textureHandle];
+}
 
-    return index;
+void SpriteCommon::RecorderCommandList::Initialize(ID3D12GraphicsCommandList* commandList) {
+    assert(commandList);
+    commandList_ = commandList;
+}
+
+void SpriteCommon::RecorderCommandList::SetRootConstantBufferView(uint32_t rootParameterIndex, uint64_t gpuAddress) {
+    commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, gpuAddress);
+}
+
+void SpriteCommon::RecorderCommandList::SetRootDescriptorTable(uint32_t rootParameterIndex, uint64_t gpuDescriptorHandle) {
+    commandList_->SetGraphicsRootDescriptorTable(rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE{ gpuDescriptorHandle });
+}
+
+void SpriteCommon::RecorderCommandList::SetRoot32BitConstant(uint32_t rootParameterIndex, uint32_t value) {
+    commandList_->SetGraphicsRoot32BitConstant(rootParameterIndex, value, 0);
+}
+
+void SpriteCommon::RecorderCommandList::SetRootShaderResourceView(uint32_t rootParameterIndex, uint64_t gpuAddress) {
+    commandList_->SetGraphicsRootShaderResourceView(rootParameterIndex, gpuAddress);
+}
+
+void SpriteCommon::RecorderCommandList::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount, uint32_t indexStart) {
+    commandList_->DrawIndexedInstanced(indexCountPerInstance, instanceCount, indexStart, 0, 0);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE SpriteCommon::GetSrvHandleGPU(uint32_t textureIndex) {
-    // DirectXCommon経由でGPUハンドルを取得
-    return dxCommon_->GetSRVGPUDescriptorHandle(textureIndex);
+    // ハンドルから SRV の番号を引いて、DirectXCommon経由でGPUハンドルを取得
+    assert(textureIndex < textureSrvIndices_.size());
+    return dxCommon_->GetSRVGPUDescriptorHandle(textureSrvIndices_[textureIndex]);
 }
 
 D3D12_RESOURCE_DESC SpriteCommon::GetTextureResourceDesc(uint32_t textureIndex) {
@@ -86,34 +483,46 @@ D3D12_RESOURCE_DESC SpriteCommon::GetTextureResourceDesc(uint32_t textureIndex)
     return textureResources_[textureIndex]->GetDesc();
 }
 
+const Vector2& SpriteCommon::GetTextureSize(uint32_t textureHandle) const {
+    assert(textureHandle < textureSizes_.size());
+    return textureSizes_[textureHandle];
+}
 
-void SpriteCommon::CreateRootSignature() {
-    ID3D12Device* device = dxCommon_->GetDevice();
 
+void SpriteCommon::CreateRootSignature() {
     D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
     descriptionRootSignature.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
+    // SRVヒープ全体を t0 からの配列として見せる（バインドレス。サイズを決めない範囲は Resource Binding Tier 2 以上が必要）
     D3D12_DESCRIPTOR_RANGE descriptorRange[1] = {};
     descriptorRange[0].BaseShaderRegister = 0; // t0
-    descriptorRange[0].NumDescriptors = 1;
+    descriptorRange[0].NumDescriptors = UINT_MAX;
     descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-    descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+    descriptorRange[0].OffsetInDescriptorsFromTableStart = 0;
 
     // RootParameter
-    D3D12_ROOT_PARAMETER rootParameters[3] = {};
-    // 0: Material (CBV)
+    // 色と座標変換は頂点に焼き込むので、スプライトごとの定数バッファは持たない
+    D3D12_ROOT_PARAMETER rootParameters[4] = {};
+    // 並びは SpriteCommandRecorder::RootParameter と合わせる
+    // 0: ViewProjection (CBV)
     rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
     rootParameters[0].Descriptor.ShaderRegister = 0;
-    // 1: TransformationMatrix (CBV)
-    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-    rootParameters[1].Descriptor.ShaderRegister = 0;
-    // 2: Texture (DescriptorTable)
-    rootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    // 1: Texture (DescriptorTable。ヒープ全体)
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootParameters[1].DescriptorTable.pDescriptorRanges = descriptorRange;
+    rootParameters[1].DescriptorTable.NumDescriptorRanges = _countof(descriptorRange);
+    // 2: 描画するテクスチャのSRVの番号 (32bit 定数 b1)
+    rootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
     rootParameters[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-    rootParameters[2].DescriptorTable.pDescriptorRanges = descriptorRange;
-    rootParameters[2].DescriptorTable.NumDescriptorRanges = _countof(descriptorRange);
+    rootParameters[2].Constants.ShaderRegister = 1;
+    rootParameters[2].Constants.Num32BitValues = 1;
+    // 3: インスタンス描画のスプライトのデータ (StructuredBuffer t0, space1)
+    rootParameters[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+    rootParameters[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+    rootParameters[3].Descriptor.ShaderRegister = 0;
+    rootParameters[3].Descriptor.RegisterSpace = 1;
 
     descriptionRootSignature.pParameters = rootParameters;
     descriptionRootSignature.NumParameters = _countof(rootParameters);
@@ -138,24 +547,59 @@ void SpriteCommon::CreateRootSignature() {
         Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
         assert(false);
     }
-    hr = device->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
-    assert(SUCCEEDED(hr));
+    // PSO のキャッシュのキーに中身を使うので、DirectXCommon で作る
+    rootSignature_ = dxCommon_->CreateRootSignature(signatureBlob);
     if (signatureBlob) signatureBlob->Release();
     if (errorBlob) errorBlob->Release();
 }
 
-void SpriteCommon::CreateGraphicsPipelineState() {
-    ID3D12Device* device = dxCommon_->GetDevice();
-
-    // シェーダーのコンパイル (Sprite2D用)
-    Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob = dxCommon_->CompileShader(L"resources/shader/Sprite2D.VS.hlsl", L"vs_6_0");
-    assert(vertexShaderBlob != nullptr);
+void SpriteCommon::CreateGraphicsPipelineState(ThreadPool* threadPool) {
+    // シェーダーのコンパイルはすべて同時に進め、PSO は使うシェーダーが揃ったものから作る
+    // （CompileShader も DirectXCommon::CreateGraphicsPipelineState も、複数のスレッドから呼んでよい）
+    // 頂点シェーダーはバリアントが無いので1つずつ、ピクセルシェーダーは機能の組み合わせごとに作る
+    Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob;
+    Microsoft::WRL::ComPtr<IDxcBlob> instancedVertexShaderBlob;
+    std::array<Microsoft::WRL::ComPtr<IDxcBlob>, ShaderFeature::kVariantCount> pixelShaderBlobs;
+    std::array<Microsoft::WRL::ComPtr<IDxcBlob>, ShaderFeature::kVariantCount> instancedPixelShaderBlobs;
+
+    JobGraph jobGraph;
+    JobGraph::JobId compileVS = jobGraph.Add("Sprite2D.VS", [&]() {
+        vertexShaderBlob = dxCommon_->CompileShader(L"resources/shader/Sprite2D.VS.hlsl", L"vs_6_0");
+        assert(vertexShaderBlob != nullptr);
+    });
+    JobGraph::JobId compileInstancedVS = jobGraph.Add("Sprite2DInstanced.VS", [&]() {
+        instancedVertexShaderBlob = dxCommon_->CompileShader(L"resources/shader/Sprite2DInstanced.VS.hlsl", L"vs_6_0");
+        assert(instancedVertexShaderBlob != nullptr);
+    });
+
+    for (uint32_t features : ShaderPermutation::EnumerateVariants(kSpriteShaderFeatures)) {
+        std::string variantName = " [" + ShaderPermutation::BuildVariantName(features) + "]";
+        std::vector<std::wstring> defines = ShaderPermutation::BuildDefineArguments(features);
+
+        JobGraph::JobId compilePS = jobGraph.Add("Sprite2D.PS" + variantName, [&, features, defines]() {
+            pixelShaderBlobs[features] = dxCommon_->CompileShader(L"resources/shader/Sprite2D.PS.hlsl", L"ps_6_0", defines);
+            assert(pixelShaderBlobs[features] != nullptr);
+        });
+        JobGraph::JobId compileInstancedPS = jobGraph.Add("Sprite2DInstanced.PS" + variantName, [&, features, defines]() {
+            instancedPixelShaderBlobs[features] = dxCommon_->CompileShader(L"resources/shader/Sprite2DInstanced.PS.hlsl", L"ps_6_0", defines);
+            assert(instancedPixelShaderBlobs[features] != nullptr);
+        });
+
+        jobGraph.Add("Sprite2D PSO" + variantName, [&, features]() {
+            CreatePipelineState(vertexShaderBlob.Get(), pixelShaderBlobs[features].Get(), true, pipelineStates_[features]);
+        }, { compileVS, compilePS });
+        jobGraph.Add("Sprite2DInstanced PSO" + variantName, [&, features]() {
+            CreatePipelineState(instancedVertexShaderBlob.Get(), instancedPixelShaderBlobs[features].Get(), false, instancedPipelineStates_[features]);
+        }, { compileInstancedVS, compileInstancedPS });
+    }
 
-    Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob = dxCommon_->CompileShader(L"resources/shader/Sprite2D.PS.hlsl", L"ps_6_0");
-    assert(pixelShaderBlob != nullptr);
+    jobGraph.Run(threadPool);
+    Logger::Log("SpriteCommon: pipeline build\n" + jobGraph.BuildReport());
+}
 
-    // InputLayout
-    D3D12_INPUT_ELEMENT_DESC inputElementDescs[2] = {};
+void SpriteCommon::CreatePipelineState(IDxcBlob* vertexShader, IDxcBlob* pixelShader, bool useVertexInput, Microsoft::WRL::ComPtr<ID3D12PipelineState>& pipelineState) {
+    // InputLayout (SpriteBatch::Vertex に対応)
+    D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
     inputElementDescs[0].SemanticName = "POSITION";
     inputElementDescs[0].SemanticIndex = 0;
     inputElementDescs[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
@@ -166,15 +610,26 @@ void SpriteCommon::CreateGraphicsPipelineState() {
 
     inputElementDescs[1].SemanticName = "TEXCOORD";
     inputElementDescs[1].SemanticIndex = 0;
-    inputElementDescs[1].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+    inputElementDescs[1].Format = DXGI_FORMAT_R32G32_FLOAT;
     inputElementDescs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
     inputElementDescs[1].InputSlot = 0;
     inputElementDescs[1].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
     inputElementDescs[1].InstanceDataStepRate = 0;
 
+    inputElementDescs[2].SemanticName = "COLOR";
+    inputElementDescs[2].SemanticIndex = 0;
+    inputElementDescs[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+    inputElementDescs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+    inputElementDescs[2].InputSlot = 0;
+    inputElementDescs[2].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+    inputElementDescs[2].InstanceDataStepRate = 0;
+
+    // インスタンス描画用は頂点をシェーダーが SV_VertexID から作るので、入力レイアウトは無い
     D3D12_INPUT_LAYOUT_DESC inputLayoutDesc{};
-    inputLayoutDesc.pInputElementDescs = inputElementDescs;
-    inputLayoutDesc.NumElements = _countof(inputElementDescs);
+    if (useVertexInput) {
+        inputLayoutDesc.pInputElementDescs = inputElementDescs;
+        inputLayoutDesc.NumElements = _countof(inputElementDescs);
+    }
 
     // BlendState
     D3D12_BLEND_DESC blendDesc{};
@@ -202,8 +657,8 @@ void SpriteCommon::CreateGraphicsPipelineState() {
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc{};
     psoDesc.pRootSignature = rootSignature_.Get();
     psoDesc.InputLayout = inputLayoutDesc;
-    psoDesc.VS = { vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize() };
-    psoDesc.PS = { pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize() };
+    psoDesc.VS = { vertexShader->GetBufferPointer(), vertexShader->GetBufferSize() };
+    psoDesc.PS = { pixelShader->GetBufferPointer(), pixelShader->GetBufferSize() };
     psoDesc.BlendState = blendDesc;
     psoDesc.RasterizerState = rasterizerDesc;
     psoDesc.DepthStencilState = depthStencilDesc;
@@ -214,6 +669,52 @@ void SpriteCommon::CreateGraphicsPipelineState() {
     psoDesc.SampleDesc.Count = 1;
     psoDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 
-    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState_));
-    assert(SUCCEEDED(hr));
-}
\ No newline at end of file
+    // 同じ記述のものは使い回し、前回作ったものはパイプラインライブラリから読み込まれる
+    pipelineState = dxCommon_->CreateGraphicsPipelineState(psoDesc);
+}
+
+void SpriteCommon::CreateViewProjectionResource() {
+    viewProjectionResource_ = dxCommon_->CreateBufferResource(sizeof(Matrix4x4));
+    viewProjectionResource_->Map(0, nullptr, (void**)&viewProjectionData_);
+
+    // 既定の画面サイズの行列はビルド時に計算済みなので、書き込むだけ
+    *viewProjectionData_ = kViewProjectionMatrix;
+}
+
+void SpriteCommon::SetScreenSize(float width, float height) {
+    if (screenSize_ == Vector2{ width, height }) {
+        return;
+    }
+    screenSize_ = { width, height };
+
+    // 前のフレームがまだ古い行列を読んでいるかもしれないので、書き換えずに作り直す
+    dxCommon_->RetireResource(viewProjectionResource_);
+    viewProjectionResource_ = dxCommon_->CreateBufferResource(sizeof(Matrix4x4));
+    viewProjectionResource_->Map(0, nullptr, (void**)&viewProjectionData_);
+
+    Matrix4x4 viewMatrix = MatrixMath::MakeIdentity4x4();
+    Matrix4x4 projectionMatrix = MatrixMath::MakeOrthographicMatrix(0.0f, 0.0f, width, height, 0.0f, 100.0f);
+    *viewProjectionData_ = MatrixMath::Multiply(viewMatrix, projectionMatrix);
+}
+
+void SpriteCommon::EnsureBatchCapacity(uint32_t spriteCount) {
+    if (spriteCount <= batchCapacity_) {
+        return;
+    }
+    // 足りない場合は倍々で拡張する
+    uint32_t capacity = (std::max)(spriteCount, batchCapacity_ * 2);
+
+    // 古いバッファは前のフレームのGPU処理が使っているかもしれないので、完了後に解放する
+    if (batchIndexResource_) {
+        dxCommon_->RetireResource(batchIndexResource_);
+    }
+
+    // インデックスは並びが固定なので、確保したときに一度だけ書き込む
+    batchIndexResource_ = dxCommon_->CreateBufferResource(sizeof(uint32_t) * SpriteBatch::kIndicesPerSprite * capacity);
+    uint32_t* indexData = nullptr;
+    batchIndexResource_->Map(0, nullptr, (void**)&indexData);
+    SpriteBatch::WriteIndices(indexData, capacity);
+    batchIndexResource_->Unmap(0, nullptr);
+
+    batchCapacity_ = capacity;
+}
@@ -1,5 +1,14 @@
 #pragma once
 #include "DirectXCommon.h"
+#include "SpriteBatch.h"
+#include "SpriteSystem.h"
+#include "SpriteCommandRecorder.h"
+#include "AsyncTextureLoader.h"
+#include "TextureCache.h"
+#include "TextureAtlas.h"
+#include "ShaderPermutation.h"
+#include "Matrix.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
@@ -8,18 +17,80 @@
 
 class SpriteCommon {
 public:
-    void Initialize(DirectXCommon* dxCommon);
+    // threadPool を渡すと LoadTextureAsync のデコードをワーカースレッドで行う
+    void Initialize(DirectXCommon* dxCommon, ThreadPool* threadPool = nullptr);
 
-    // 描画前の準備
+    // 描画前の準備（スプライトバッチの受付開始）
     void PreDraw();
 
+    // 描画後の処理（溜めたスプライトをテクスチャごとにまとめて描画）
+    void PostDraw();
+
+    // SpriteSystem の全スプライトを描画する（PreDraw と PostDraw の間で呼ぶ）
+    // threadPool を渡すと頂点の書き込みを並列で行う
+    // 非同期読み込みでテクスチャの大きさが変わっていれば、描く前にスプライトのサイズと UV を合わせ直す
+    void DrawSpriteSystem(SpriteSystem& spriteSystem, ThreadPool* threadPool = nullptr);
+
+    // SpriteSystem の全スプライトをインスタンス描画する（PreDraw と PostDraw の間で呼ぶ）
+    // 頂点の代わりにスプライト1枚につき SpriteInstance 1つをアップロードし、テクスチャが混ざっていても1回の描画で済ませる
+    void DrawSpriteSystemInstanced(SpriteSystem& spriteSystem, ThreadPool* threadPool = nullptr);
+
+    // 画面サイズの変更（ビュー・プロジェクション行列を作り直す）
+    void SetScreenSize(float width, float height);
+
+    // 完全に透明なピクセルを捨てるか（既定は捨てる）。次の PreDraw・描画から使うシェーダーのバリアントが変わる
+    // スプライトは深度を書かないので、半透明の合成だけで足りるなら false にした方が速い
+    void SetAlphaTest(bool enable) { alphaTest_ = enable; }
+
+    // スプライト更新の統計（1フレーム分）
+    struct SpriteUpdateStats {
+        uint32_t updated = 0; // 頂点を作り直した数
+        uint32_t skipped = 0; // 変更が無く何もしなかった数
+    };
+    // Sprite::Update から呼ばれる
+    void CountSpriteUpdate(bool updated) { updated ? ++currentUpdateStats_.updated : ++currentUpdateStats_.skipped; }
+    // 直前のフレームの統計
+    const SpriteUpdateStats& GetSpriteUpdateStats() const { return lastUpdateStats_; }
+    // 直前のフレームで積んだ描画コマンド・ルートパラメータ設定の数
+    const SpriteCommandRecorder::Stats& GetDrawStats() const { return commandRecorder_.GetStats(); }
+
     // ★ テクスチャ読み込み（戻り値はテクスチャハンドル＝配列のインデックス）
+    // 別のパスでも中身が同じ画像を読み込み済みなら、同じテクスチャを共有する
     uint32_t LoadTexture(const std::string& filePath);
 
+    // 非同期のテクスチャ読み込み（ハンドルはすぐに返る）
+    // 読み込みが終わるまでは灰色の代わりのテクスチャで描画され、終わった次の PreDraw で差し替わる
+    // 差し替わるまでは GetTextureSize も代わりのテクスチャの大きさ（1x1）を返す。
+    // Sprite・SpriteSystem は差し替わったときに大きさを取り直す
+    uint32_t LoadTextureAsync(const std::string& filePath);
+
+    // テクスチャの一部分（アトラスに詰めた画像の位置）
+    struct TextureRegion {
+        uint32_t textureHandle;
+        Vector2 leftTop; // ピクセル
+        Vector2 size;    // ピクセル
+    };
+
+    // 小さな画像をまとめてアトラス（大きなテクスチャ）にして読み込む
+    // 戻り値は filePaths と同じ順。Sprite::SetTextureRegion にそのまま渡せる
+    // 同じアトラスに載ったスプライトは同じテクスチャなので、バッチで1回の描画にまとまる
+    std::vector<TextureRegion> LoadTextureAtlas(const std::vector<std::string>& filePaths, uint32_t pageSize = TextureAtlas::kDefaultPageSize);
+
+    // 読み込みが終わって本物のテクスチャになっているか
+    bool IsTextureReady(uint32_t textureHandle) const;
+
+    // テクスチャを解放する（ハンドルは代わりのテクスチャを指すようになる。SRVの番号はGPUが使い終わってから再利用される）
+    // 非同期で読み込み中なら、読み込み終わった結果は捨てる
+    void UnloadTexture(uint32_t textureHandle);
+
     // ★ ゲッター
     DirectXCommon* GetDxCommon() const { return dxCommon_; }
     ID3D12RootSignature* GetRootSignature() const { return rootSignature_.Get(); }
-    ID3D12PipelineState* GetPipelineState() const { return pipelineState_.Get(); }
+    ID3D12PipelineState* GetPipelineState() const { return pipelineStates_[GetShaderFeatures()].Get(); }
+    SpriteBatch* GetSpriteBatch() { return &spriteBatch_; }
+
+    // テクスチャのSRVの番号（SRVヒープの先頭からの位置。シェーダーはこの番号でテクスチャを引く）
+    uint32_t GetSrvIndex(uint32_t textureHandle) const;
 
     // 指定番号のSRVハンドル(GPU)を取得
     D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(uint32_t textureIndex);
@@ -27,25 +98,111 @@ public:
     // 指定番号のテクスチャ情報（幅・高さなど）を取得
     D3D12_RESOURCE_DESC GetTextureResourceDesc(uint32_t textureIndex);
 
+    // テクスチャのピクセルサイズ（読み込み中は代わりのテクスチャの大きさ）
+    const Vector2& GetTextureSize(uint32_t textureHandle) const;
+
 
 private:
     void CreateRootSignature();
-    void CreateGraphicsPipelineState();
+    // シェーダーのコンパイルと PSO 作成を threadPool で並列に行う（nullptr ならその場で順番に）
+    // ピクセルシェーダーは kSpriteShaderFeatures の組み合わせごとのバリアントを作る
+    void CreateGraphicsPipelineState(ThreadPool* threadPool);
+    // スプライト共通の設定で PSO を1つ作る。useVertexInput が false なら入力レイアウト無し
+    void CreatePipelineState(IDxcBlob* vertexShader, IDxcBlob* pixelShader, bool useVertexInput, Microsoft::WRL::ComPtr<ID3D12PipelineState>& pipelineState);
+    void CreateViewProjectionResource();
+
+    // テクスチャハンドルを1つ増やす（最初は代わりのテクスチャを指す）
+    uint32_t AllocateTextureHandle();
+    // 画像からリソースとSRVを作り、textureHandle の指す先にする
+    void CreateTexture(uint32_t textureHandle, const DirectX::ScratchImage& mipImages);
+    // マップした DDS ファイルから作る
+    void CreateTexture(uint32_t textureHandle, const MappedFile& mappedFile, const DdsLayout& ddsLayout);
+    // 転送済みのリソースにSRVを作り、textureHandle の指す先にする
+    void RegisterTexture(uint32_t textureHandle, const Microsoft::WRL::ComPtr<ID3D12Resource>& textureResource, const DirectX::TexMetadata& metadata);
+    void CreatePlaceholderTexture();
+    // 非同期で読み込み終わったテクスチャをGPUへ転送する
+    void ProcessCompletedTextureLoads();
+    // 読み込んだ画像を result.textureHandle の指す先にする（中身が同じテクスチャがあればそれを共有する）
+    void CompleteTextureLoad(const AsyncTextureLoader::Result& result);
+
+    // アップロード済みの頂点（spriteCount 枚分）を drawRuns ごとに描画する
+    void DrawVertices(D3D12_GPU_VIRTUAL_ADDRESS vertexAddress, uint32_t spriteCount, const std::vector<SpriteBatch::DrawRun>& drawRuns);
+
+    // バッチ用のインデックスバッファを spriteCount 枚分以上確保する
+    void EnsureBatchCapacity(uint32_t spriteCount);
+
+    // SpriteCommandRecorder が積むコマンドリスト
+    class RecorderCommandList : public SpriteCommandRecorder::CommandList {
+    public:
+        void Initialize(ID3D12GraphicsCommandList* commandList);
+        void SetRootConstantBufferView(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+        void SetRootDescriptorTable(uint32_t rootParameterIndex, uint64_t gpuDescriptorHandle) override;
+        void SetRoot32BitConstant(uint32_t rootParameterIndex, uint32_t value) override;
+        void SetRootShaderResourceView(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+        void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount, uint32_t indexStart) override;
+
+    private:
+        ID3D12GraphicsCommandList* commandList_ = nullptr;
+    };
 
     DirectXCommon* dxCommon_ = nullptr;
 
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-    Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+    // PSO はシェーダーのバリアント（ShaderFeature の組み合わせ）ごとに持ち、機能ビットで引く
+    // スプライトのシェーダーが対応しているのは kSpriteShaderFeatures だけなので、それ以外は空
+    static constexpr uint32_t kSpriteShaderFeatures = ShaderFeature::kAlphaTest;
+    std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, ShaderFeature::kVariantCount> pipelineStates_;
+    // インスタンス描画用（ルートシグネチャは共通）
+    std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, ShaderFeature::kVariantCount> instancedPipelineStates_;
+    bool alphaTest_ = true;
+    // 今の設定で使うバリアント
+    uint32_t GetShaderFeatures() const { return alphaTest_ ? ShaderFeature::kAlphaTest : ShaderFeature::kNone; }
+
+    // スプライトバッチ
+    SpriteBatch spriteBatch_;
+    // 全スプライト共有のインデックスバッファ（並びは固定。頂点は毎フレームアップロードリングから切り出す）
+    Microsoft::WRL::ComPtr<ID3D12Resource> batchIndexResource_;
+    uint32_t batchCapacity_ = 0;
+    // ルートパラメータの設定と描画を積む（同じ値の設定を省く）
+    RecorderCommandList recorderCommandList_;
+    SpriteCommandRecorder commandRecorder_;
+    // DrawSpriteSystem 用の描画範囲（毎フレーム確保し直さないよう使い回す）
+    std::vector<SpriteBatch::DrawRun> systemDrawRuns_;
+
+    // ビュー・プロジェクション行列（全スプライト共通。画面サイズが変わったときだけ作り直す）
+    Microsoft::WRL::ComPtr<ID3D12Resource> viewProjectionResource_;
+    Matrix4x4* viewProjectionData_ = nullptr;
+    Vector2 screenSize_ = { float(WinApp::kClientWidth), float(WinApp::kClientHeight) };
+
+    SpriteUpdateStats currentUpdateStats_;
+    SpriteUpdateStats lastUpdateStats_;
 
     // ★ テクスチャ管理用のコンテナ
     // テクスチャリソースの配列
     std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> textureResources_;
-    // テクスチャアップロード用の中間リソース（転送が終わるまで保持しておく必要がある）
-    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> intermediateResources_;
+
+    // テクスチャハンドル → SRVの番号（読み込み中は代わりのテクスチャの番号）
+    std::vector<uint32_t> textureSrvIndices_;
+
+    // テクスチャハンドル → ピクセルサイズ（毎フレーム GetDesc を呼ばずに済むよう持っておく）
+    std::vector<Vector2> textureSizes_;
+
+    // テクスチャハンドル → 非同期読み込みの結果を待っているか（読み込み中に解放されたら外し、結果を捨てる）
+    std::vector<uint8_t> isTextureLoading_;
+
+    // 読み込み中に使う代わりのテクスチャ
+    Microsoft::WRL::ComPtr<ID3D12Resource> placeholderResource_;
+    uint32_t placeholderSrvIndex_ = 0;
+
+    // デコード済み画像のディスクキャッシュ（次回の起動から WIC とミップマップ生成を省く）
+    TextureCache textureCache_;
+
+    // 非同期読み込み
+    AsyncTextureLoader asyncTextureLoader_;
+    std::vector<AsyncTextureLoader::Result> completedTextureLoads_;
 
     // パスとインデックスの対応マップ（同じ画像を何度も読み込まないように）
     std::map<std::string, uint32_t> textureMap_;
-
-    // 次に使うSRVインデックス（0番目はImGuiなどが使うかもしれないので1から始める等の調整可能。今回は0から）
-    uint32_t srvIndex_ = 0;
+    // 中身のハッシュとインデックスの対応マップ（パスが違っても同じ画像なら共有する。読み込み済みのものだけ入る）
+    std::map<uint64_t, uint32_t> contentMap_;
 };
\ No newline at end of file
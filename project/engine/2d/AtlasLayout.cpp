@@ -0,0 +1,41 @@
+#include "AtlasLayout.h"
+#include <algorithm>
+#include <numeric>
+
+bool AtlasLayout::Build(const std::vector<Size>& sizes, uint32_t pageSize, uint32_t padding) {
+    regions_.assign(sizes.size(), {});
+    packers_.clear();
+
+    // 1. 高い順（同じなら幅の広い順）に並べる
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+        if (sizes[a].height != sizes[b].height) {
+            return sizes[a].height > sizes[b].height;
+        }
+        return sizes[a].width > sizes[b].width;
+    });
+
+    // 2. 置き場所を決める（今あるページに入らなければページを増やす）
+    for (size_t index : order) {
+        uint32_t width = sizes[index].width;
+        uint32_t height = sizes[index].height;
+
+        AtlasPacker::Rect rect;
+        uint32_t page = 0;
+        for (; page < packers_.size(); ++page) {
+            if (packers_[page].Insert(width, height, rect)) {
+                break;
+            }
+        }
+        if (page == packers_.size()) {
+            packers_.emplace_back();
+            packers_.back().Initialize(pageSize, pageSize, padding);
+            if (!packers_.back().Insert(width, height, rect)) {
+                return false;
+            }
+        }
+        regions_[index] = { page, rect.x, rect.y, rect.width, rect.height };
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "AtlasPacker.h"
+#include <cstdint>
+#include <vector>
+
+// 四角形の一覧を、必要なだけページを増やしながら AtlasPacker で詰める（TextureAtlas の置き場所決め）
+// 画像は扱わず位置だけを決める（D3D12 にも DirectXTex にも依存しない）
+class AtlasLayout {
+public:
+    // 四角形がどのページのどこに入ったか（ピクセル）
+    struct Region {
+        uint32_t page;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    struct Size {
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // sizes を pageSize x pageSize のページに詰める（padding は AtlasPacker と同じ）
+    // 大きい順に詰めると隙間が少なくなるので、渡した順ではなく高さの順に置く（Region は sizes と同じ順）
+    // ページより大きいものがあれば false
+    bool Build(const std::vector<Size>& sizes, uint32_t pageSize, uint32_t padding = 2);
+
+    const std::vector<Region>& GetRegions() const { return regions_; }
+    uint32_t GetPageCount() const { return uint32_t(packers_.size()); }
+    // ページごとの詰め込み率（四角形の面積の合計 / ページの面積）
+    float GetOccupancy(uint32_t page) const { return packers_[page].GetOccupancy(); }
+
+private:
+    std::vector<Region> regions_;
+    std::vector<AtlasPacker> packers_;
+};
@@ -0,0 +1,105 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <cassert>
+
+void AtlasPacker::Initialize(uint32_t width, uint32_t height, uint32_t padding) {
+    assert(width > 0 && height > 0);
+    width_ = width;
+    height_ = height;
+    padding_ = padding;
+    usedArea_ = 0;
+    nodes_.clear();
+    nodes_.push_back({ 0, 0, width });
+}
+
+bool AtlasPacker::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+    uint32_t x = nodes_[index].x;
+    if (x + width > width_) {
+        return false;
+    }
+
+    // 置く幅にかかる区間のうち、一番高いところに乗せる
+    y = 0;
+    uint32_t remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        assert(i < nodes_.size());
+        y = (std::max)(y, nodes_[i].y);
+        if (y + height > height_) {
+            return false;
+        }
+        remaining -= (std::min)(remaining, nodes_[i].width);
+    }
+    return true;
+}
+
+bool AtlasPacker::Insert(uint32_t width, uint32_t height, Rect& rect) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+    if (width > width_ || height > height_) {
+        return false;
+    }
+    // 右端・下端に接するものは隙間がなくてもよいので、はみ出す分だけ削る
+    uint32_t paddedWidth = (std::min)(width + padding_, width_);
+    uint32_t paddedHeight = (std::min)(height + padding_, height_);
+
+    // 上端が一番低くなる場所を選ぶ（同じなら、下の区間が狭いほうにして隙間を残しにくくする）
+    size_t bestIndex = nodes_.size();
+    uint32_t bestTop = UINT32_MAX;
+    uint32_t bestNodeWidth = UINT32_MAX;
+    uint32_t bestY = 0;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        uint32_t y;
+        if (!Fit(i, paddedWidth, paddedHeight, y)) {
+            continue;
+        }
+        uint32_t top = y + paddedHeight;
+        if (top < bestTop || (top == bestTop && nodes_[i].width < bestNodeWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestNodeWidth = nodes_[i].width;
+            bestY = y;
+        }
+    }
+    if (bestIndex == nodes_.size()) {
+        return false;
+    }
+
+    // 新しい区間を入れて、その下に隠れた区間を削る・縮める
+    Node newNode = { nodes_[bestIndex].x, bestY + paddedHeight, paddedWidth };
+    nodes_.insert(nodes_.begin() + bestIndex, newNode);
+
+    uint32_t newRight = newNode.x + newNode.width;
+    for (size_t i = bestIndex + 1; i < nodes_.size();) {
+        Node& node = nodes_[i];
+        if (node.x >= newRight) {
+            break;
+        }
+        uint32_t overlap = newRight - node.x;
+        if (overlap >= node.width) {
+            nodes_.erase(nodes_.begin() + i);
+            continue;
+        }
+        node.x += overlap;
+        node.width -= overlap;
+        break;
+    }
+
+    // 同じ高さで隣り合う区間をまとめる
+    for (size_t i = 0; i + 1 < nodes_.size();) {
+        if (nodes_[i].y == nodes_[i + 1].y) {
+            nodes_[i].width += nodes_[i + 1].width;
+            nodes_.erase(nodes_.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    rect = { newNode.x, bestY, width, height };
+    usedArea_ += uint64_t(width) * height;
+    return true;
+}
+
+float AtlasPacker::GetOccupancy() const {
+    return float(double(usedArea_) / (double(width_) * double(height_)));
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 四角形を1枚の大きな領域（アトラスのページ）に詰め込む（スカイライン法・左下優先）
+// 詰めた部分の上端を「スカイライン」として折れ線で持ち、一番低い位置に置ける場所を探す。
+// 画像は扱わず位置だけを決める（D3D12 にも DirectXTex にも依存しない）
+class AtlasPacker {
+public:
+    struct Rect {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    // padding は四角形どうしの間にあける隙間（ピクセル）。隣の画像の色がにじまないようにする
+    void Initialize(uint32_t width, uint32_t height, uint32_t padding = 2);
+
+    // width x height を置く場所を探して rect に入れる。入らなければ false
+    bool Insert(uint32_t width, uint32_t height, Rect& rect);
+
+    uint32_t GetWidth() const { return width_; }
+    uint32_t GetHeight() const { return height_; }
+    // 置いた四角形の面積の合計 / ページの面積（隙間は含まない）
+    float GetOccupancy() const;
+
+private:
+    // スカイラインの1区間（x から width の幅が高さ y まで埋まっている）
+    struct Node {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    // nodes_[index] の左端に width x height を置いたときの y。置けなければ false
+    bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t padding_ = 0;
+    uint64_t usedArea_ = 0;
+    std::vector<Node> nodes_;
+};
@@ -0,0 +1,56 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cassert>
+
+void SpriteBatch::Begin() {
+    // clear() は容量を残すので、毎フレームの再確保は起きない
+    vertices_.clear();
+    sortKeys_.clear();
+    drawRuns_.clear();
+}
+
+void SpriteBatch::Add(uint32_t textureHandle, const Vertex (&vertices)[kVerticesPerSprite]) {
+    uint32_t order = static_cast<uint32_t>(sortKeys_.size());
+    sortKeys_.push_back((static_cast<uint64_t>(textureHandle) << 32) | order);
+    vertices_.insert(vertices_.end(), vertices, vertices + kVerticesPerSprite);
+}
+
+void SpriteBatch::End() {
+    drawRuns_.clear();
+    if (sortKeys_.empty()) {
+        return;
+    }
+
+    // 同じテクスチャしか使っていない場合など、既に並んでいればソートしない
+    if (!std::is_sorted(sortKeys_.begin(), sortKeys_.end())) {
+        std::sort(sortKeys_.begin(), sortKeys_.end());
+    }
+
+    // テクスチャが切り替わる位置で描画範囲を区切る
+    for (uint32_t i = 0; i < sortKeys_.size(); ++i) {
+        uint32_t textureHandle = static_cast<uint32_t>(sortKeys_[i] >> 32);
+        if (drawRuns_.empty() || drawRuns_.back().textureHandle != textureHandle) {
+            drawRuns_.push_back({ textureHandle, i * kIndicesPerSprite, 0 });
+        }
+        drawRuns_.back().indexCount += kIndicesPerSprite;
+    }
+}
+
+void SpriteBatch::WriteVertices(Vertex* dst) const {
+    assert(dst);
+    for (uint64_t key : sortKeys_) {
+        uint32_t order = static_cast<uint32_t>(key & 0xffffffffu);
+        std::copy_n(&vertices_[static_cast<size_t>(order) * kVerticesPerSprite], kVerticesPerSprite, dst);
+        dst += kVerticesPerSprite;
+    }
+}
+
+void SpriteBatch::WriteIndices(uint32_t* dst, uint32_t spriteCount) {
+    assert(dst);
+    for (uint32_t i = 0; i < spriteCount; ++i) {
+        uint32_t base = i * kVerticesPerSprite;
+        dst[0] = base + 0; dst[1] = base + 1; dst[2] = base + 2;
+        dst[3] = base + 1; dst[4] = base + 3; dst[5] = base + 2;
+        dst += kIndicesPerSprite;
+    }
+}
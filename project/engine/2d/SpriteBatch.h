@@ -0,0 +1,53 @@
+#pragma once
+#include "Struct.h"
+#include <cstdint>
+#include <vector>
+
+// スプライトをまとめて描画するためのバッチ
+// 1フレーム分のスプライトを集めてテクスチャ順に並べ替え、
+// 1本の頂点列と「テクスチャごとの描画範囲」のリストを作る（D3D12には依存しない）
+class SpriteBatch {
+public:
+    // バッチ描画用の頂点（座標はワールド座標、色は頂点ごとに持つ）
+    struct Vertex {
+        Vector4 position;
+        Vector2 texcoord;
+        Vector4 color;
+    };
+
+    // 同じテクスチャが連続する範囲（1回の DrawIndexedInstanced に対応）
+    struct DrawRun {
+        uint32_t textureHandle;
+        uint32_t indexStart;
+        uint32_t indexCount;
+    };
+
+    static constexpr uint32_t kVerticesPerSprite = 4;
+    static constexpr uint32_t kIndicesPerSprite = 6;
+
+    // フレーム開始（前フレームの内容を破棄）
+    void Begin();
+
+    // スプライト1枚分の頂点を登録
+    void Add(uint32_t textureHandle, const Vertex (&vertices)[kVerticesPerSprite]);
+
+    // 登録を締め切り、テクスチャ順に並べ替えて描画範囲を作る
+    void End();
+
+    // 並べ替え後の頂点列を書き込む（dst には GetSpriteCount() * 4 頂点分の領域が必要）
+    void WriteVertices(Vertex* dst) const;
+
+    // スプライト spriteCount 枚分のインデックス（0,1,2 / 1,3,2 の繰り返し）を書き込む
+    static void WriteIndices(uint32_t* dst, uint32_t spriteCount);
+
+    uint32_t GetSpriteCount() const { return static_cast<uint32_t>(sortKeys_.size()); }
+    const std::vector<DrawRun>& GetDrawRuns() const { return drawRuns_; }
+
+private:
+    // 登録順の頂点（スプライト i の頂点は [i * 4, i * 4 + 4)）
+    std::vector<Vertex> vertices_;
+    // 並べ替えキー（上位32bit: テクスチャハンドル、下位32bit: 登録順）
+    // 登録順を含めることで、同じテクスチャ同士の前後関係は保たれる
+    std::vector<uint64_t> sortKeys_;
+    std::vector<DrawRun> drawRuns_;
+};
@@ -0,0 +1,84 @@
+#include "SpriteCommandRecorder.h"
+#include <cassert>
+
+void SpriteCommandRecorder::Reset(CommandList* commandList) {
+    assert(commandList);
+    commandList_ = commandList;
+    for (bool& isSet : isRootValueSet_) {
+        isSet = false;
+    }
+}
+
+void SpriteCommandRecorder::SetViewProjection(uint64_t gpuAddress) {
+    if (ShouldSet(kRootViewProjection, gpuAddress)) {
+        commandList_->SetRootConstantBufferView(kRootViewProjection, gpuAddress);
+    }
+}
+
+void SpriteCommandRecorder::SetTextureTable(uint64_t gpuDescriptorHandle) {
+    if (ShouldSet(kRootTextureTable, gpuDescriptorHandle)) {
+        commandList_->SetRootDescriptorTable(kRootTextureTable, gpuDescriptorHandle);
+    }
+}
+
+void SpriteCommandRecorder::DrawRuns(const std::vector<SpriteBatch::DrawRun>& drawRuns, const std::function<uint32_t(uint32_t textureHandle)>& srvIndexOf) {
+    assert(commandList_);
+
+    // まだ積んでいない描画（SRVが同じで続いている範囲をまとめていく）
+    uint32_t pendingSrvIndex = 0;
+    uint32_t pendingStart = 0;
+    uint32_t pendingCount = 0;
+
+    auto flush = [&]() {
+        if (pendingCount == 0) {
+            return;
+        }
+        if (ShouldSet(kRootTextureIndex, pendingSrvIndex)) {
+            commandList_->SetRoot32BitConstant(kRootTextureIndex, pendingSrvIndex);
+        }
+        commandList_->DrawIndexedInstanced(pendingCount, 1, pendingStart);
+        ++currentStats_.drawCalls;
+        pendingCount = 0;
+    };
+
+    for (const SpriteBatch::DrawRun& run : drawRuns) {
+        // ハンドルが違っても、読み込み中（代わりのテクスチャ）や中身が同じ画像なら同じSRVを指している
+        uint32_t srvIndex = srvIndexOf(run.textureHandle);
+        if (pendingCount > 0 && srvIndex == pendingSrvIndex && pendingStart + pendingCount == run.indexStart) {
+            pendingCount += run.indexCount;
+            ++currentStats_.mergedRuns;
+            continue;
+        }
+        flush();
+        pendingSrvIndex = srvIndex;
+        pendingStart = run.indexStart;
+        pendingCount = run.indexCount;
+    }
+    flush();
+}
+
+void SpriteCommandRecorder::DrawInstances(uint64_t instanceBuffer, uint32_t instanceCount) {
+    if (ShouldSet(kRootInstanceBuffer, instanceBuffer)) {
+        commandList_->SetRootShaderResourceView(kRootInstanceBuffer, instanceBuffer);
+    }
+    // 四角形1枚分のインデックスを繰り返す
+    commandList_->DrawIndexedInstanced(SpriteBatch::kIndicesPerSprite, instanceCount, 0);
+    ++currentStats_.drawCalls;
+}
+
+void SpriteCommandRecorder::EndFrame() {
+    lastStats_ = currentStats_;
+    currentStats_ = {};
+}
+
+bool SpriteCommandRecorder::ShouldSet(RootParameter rootParameter, uint64_t value) {
+    assert(commandList_);
+    if (isRootValueSet_[rootParameter] && rootValues_[rootParameter] == value) {
+        ++currentStats_.skippedChanges;
+        return false;
+    }
+    rootValues_[rootParameter] = value;
+    isRootValueSet_[rootParameter] = true;
+    ++currentStats_.rootParameterChanges;
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "SpriteBatch.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// スプライト描画のルートパラメータ設定と描画コマンドを積む
+// 前回と同じ値のルートパラメータは積まず、SRVが同じになる隣り合った描画範囲は1回の描画にまとめる。
+// D3D12への依存は CommandList に閉じ込めてある（積まれたコマンドを数えるだけの偽物でも動かせる）
+class SpriteCommandRecorder {
+public:
+    // コマンドリストの実体
+    class CommandList {
+    public:
+        virtual ~CommandList() = default;
+        virtual void SetRootConstantBufferView(uint32_t rootParameterIndex, uint64_t gpuAddress) = 0;
+        virtual void SetRootDescriptorTable(uint32_t rootParameterIndex, uint64_t gpuDescriptorHandle) = 0;
+        virtual void SetRoot32BitConstant(uint32_t rootParameterIndex, uint32_t value) = 0;
+        virtual void SetRootShaderResourceView(uint32_t rootParameterIndex, uint64_t gpuAddress) = 0;
+        virtual void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount, uint32_t indexStart) = 0;
+    };
+
+    // SpriteCommon のルートシグネチャの並び
+    enum RootParameter : uint32_t {
+        kRootViewProjection, // CBV (b0)
+        kRootTextureTable,   // SRVヒープ全体 (t0～)
+        kRootTextureIndex,   // 描画するテクスチャのSRVの番号（32bit 定数 b1）
+        kRootInstanceBuffer, // インスタンス描画のスプライトのデータ (t0, space1)
+        kRootParameterCount,
+    };
+
+    // 1フレーム分の統計
+    struct Stats {
+        uint32_t rootParameterChanges = 0; // 実際に積んだルートパラメータの設定
+        uint32_t skippedChanges = 0;       // 前回と同じ値だったので積まなかった設定
+        uint32_t drawCalls = 0;
+        uint32_t mergedRuns = 0;           // 前の描画にまとめた描画範囲
+    };
+
+    // ルートシグネチャを設定した直後に呼ぶ（設定済みの値を忘れる。GPU側でも未設定に戻るため）
+    void Reset(CommandList* commandList);
+
+    void SetViewProjection(uint64_t gpuAddress);
+    void SetTextureTable(uint64_t gpuDescriptorHandle);
+
+    // 描画範囲ごとに描画する（srvIndexOf はテクスチャハンドルからSRVの番号を引く）
+    void DrawRuns(const std::vector<SpriteBatch::DrawRun>& drawRuns, const std::function<uint32_t(uint32_t textureHandle)>& srvIndexOf);
+
+    // instanceBuffer の instanceCount 枚のスプライトを1回で描画する（テクスチャはインスタンスごとに持つ）
+    void DrawInstances(uint64_t instanceBuffer, uint32_t instanceCount);
+
+    // フレームの区切り（統計を締める）
+    void EndFrame();
+    // 直前のフレームの統計
+    const Stats& GetStats() const { return lastStats_; }
+
+private:
+    // 値が変わったときだけ積む
+    bool ShouldSet(RootParameter rootParameter, uint64_t value);
+
+    CommandList* commandList_ = nullptr;
+
+    // ルートパラメータごとの最後に積んだ値
+    uint64_t rootValues_[kRootParameterCount]{};
+    bool isRootValueSet_[kRootParameterCount]{};
+
+    Stats currentStats_;
+    Stats lastStats_;
+};
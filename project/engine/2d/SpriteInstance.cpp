@@ -0,0 +1,26 @@
+#include "SpriteInstance.h"
+
+void ExpandSpriteInstance(const SpriteInstance& instance, SpriteBatch::Vertex (&vertices)[SpriteBatch::kVerticesPerSprite]) {
+    for (uint32_t vertexId = 0; vertexId < SpriteBatch::kVerticesPerSprite; ++vertexId) {
+        // bit1: 右か, bit0: 上か（シェーダーと同じ判定）
+        bool isRight = (vertexId & 2) != 0;
+        bool isTop = (vertexId & 1) != 0;
+
+        // ローカル座標（アンカー考慮）
+        float x = ((isRight ? 1.0f : 0.0f) - instance.anchorPoint.x) * instance.size.x;
+        float y = ((isTop ? 0.0f : 1.0f) - instance.anchorPoint.y) * instance.size.y;
+
+        // 回転・平行移動
+        vertices[vertexId].position = {
+            x * instance.cosine - y * instance.sine + instance.position.x,
+            x * instance.sine + y * instance.cosine + instance.position.y,
+            0.0f,
+            1.0f
+        };
+        vertices[vertexId].texcoord = {
+            isRight ? instance.uvRect.z : instance.uvRect.x,
+            isTop ? instance.uvRect.y : instance.uvRect.w
+        };
+        vertices[vertexId].color = instance.color;
+    }
+}
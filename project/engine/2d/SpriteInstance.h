@@ -0,0 +1,24 @@
+#pragma once
+#include "SpriteBatch.h"
+#include "Struct.h"
+#include <cstdint>
+
+// インスタンス描画でスプライト1枚分のデータ（Sprite2DInstanced.VS.hlsl の SpriteInstance と同じ並び）
+// 頂点は作らず、シェーダーが SV_VertexID（四隅のどれか）からその場で作る
+struct SpriteInstance {
+    Vector2 position;    // ワールド座標
+    Vector2 size;        // 表示サイズ（ピクセル）
+    Vector2 anchorPoint; // 0,0 で左上、1,1 で右下
+    float cosine;        // 回転の cos / sin（シェーダーで三角関数を呼ばない）
+    float sine;
+    Vector4 uvRect;      // 左, 上, 右, 下（反転済み）
+    Vector4 color;
+    uint32_t textureIndex; // テクスチャのSRVの番号（バインドレス）
+    uint32_t padding[3];   // 16バイト境界にそろえる
+};
+static_assert(sizeof(SpriteInstance) == 80, "Sprite2DInstanced.VS.hlsl の SpriteInstance と大きさを合わせる");
+
+// 頂点シェーダーと同じ計算で、インスタンス1つを4頂点に展開する（CPU側の参照実装）
+// 並びは SpriteBatch の頂点と同じ（0: 左下, 1: 左上, 2: 右下, 3: 右上）なので、
+// SpriteSystem::WriteVertices や Sprite::Update の結果とそのまま比べられる
+void ExpandSpriteInstance(const SpriteInstance& instance, SpriteBatch::Vertex (&vertices)[SpriteBatch::kVerticesPerSprite]);
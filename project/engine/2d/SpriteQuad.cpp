@@ -0,0 +1,122 @@
+#include "SpriteQuad.h"
+#include <utility>
+
+void SpriteQuad::SetTexture(const Vector2& fullTextureSize) {
+    // スプライトのサイズを画像のサイズに合わせる
+    fullTextureSize_ = fullTextureSize;
+    textureSize_ = fullTextureSize_;
+    size_ = textureSize_; // 表示サイズも画像サイズに合わせる
+    textureLeftTop_ = { 0.0f, 0.0f }; // 切り出し位置リセット
+    rectFitsTexture_ = true;
+    sizeFitsTexture_ = true;
+
+    // 頂点データは次の Update で作り直す
+    dirtyFlags_ |= kDirtyVertices;
+}
+
+void SpriteQuad::SetTextureRect(const Vector2& leftTop, const Vector2& size) {
+    textureLeftTop_ = leftTop;
+    textureSize_ = size;
+    size_ = size; // 表示サイズも合わせる
+    rectFitsTexture_ = false;
+    sizeFitsTexture_ = false;
+
+    // 頂点データは次の Update で作り直す
+    dirtyFlags_ |= kDirtyVertices;
+}
+
+void SpriteQuad::AdjustTextureRect() {
+    // テクスチャ全体のサイズ
+    float texWidth = fullTextureSize_.x;
+    float texHeight = fullTextureSize_.y;
+
+    // UV座標の計算
+    float left = textureLeftTop_.x / texWidth;
+    float right = (textureLeftTop_.x + textureSize_.x) / texWidth;
+    float top = textureLeftTop_.y / texHeight;
+    float bottom = (textureLeftTop_.y + textureSize_.y) / texHeight;
+
+    // 左右反転
+    if (isFlipX_) std::swap(left, right);
+    // 上下反転
+    if (isFlipY_) std::swap(top, bottom);
+
+    // 頂点位置の計算（アンカーポイント考慮）
+    float leftPos = -anchorPoint_.x * size_.x;
+    float rightPos = (1.0f - anchorPoint_.x) * size_.x;
+    float topPos = -anchorPoint_.y * size_.y;
+    float bottomPos = (1.0f - anchorPoint_.y) * size_.y;
+
+    // 0: 左下
+    localVertices_[0].position = { leftPos,  bottomPos, 0.0f, 1.0f };
+    localVertices_[0].texcoord = { left,     bottom };
+    // 1: 左上
+    localVertices_[1].position = { leftPos,  topPos,    0.0f, 1.0f };
+    localVertices_[1].texcoord = { left,     top };
+    // 2: 右下
+    localVertices_[2].position = { rightPos, bottomPos, 0.0f, 1.0f };
+    localVertices_[2].texcoord = { right,    bottom };
+    // 3: 右上
+    localVertices_[3].position = { rightPos, topPos,    0.0f, 1.0f };
+    localVertices_[3].texcoord = { right,    top };
+}
+
+void SpriteQuad::ApplyTextureSize(const Vector2& fullTextureSize) {
+    fullTextureSize_ = fullTextureSize;
+    if (rectFitsTexture_) {
+        textureSize_ = fullTextureSize;
+    }
+    if (sizeFitsTexture_) {
+        size_ = fullTextureSize;
+    }
+    // 切り出し範囲を指定していても UV は全体の大きさで割るので、頂点は作り直す
+    dirtyFlags_ |= kDirtyVertices;
+}
+
+bool SpriteQuad::Update(const Vector2& fullTextureSize) {
+    // 非同期読み込みのテクスチャが差し替わって大きさが変わっていたら合わせ直す
+    if (fullTextureSize_ != fullTextureSize) {
+        ApplyTextureSize(fullTextureSize);
+    }
+
+    // 何も変わっていなければ前回の頂点をそのまま使う
+    if (dirtyFlags_ == 0) {
+        return false;
+    }
+
+    // サイズ・切り出し範囲などが変わっていればローカル頂点を作り直す
+    if (dirtyFlags_ & kDirtyVertices) {
+        AdjustTextureRect();
+    }
+
+    // ワールド行列の計算
+    if (dirtyFlags_ & kDirtyTransform) {
+        Matrix4x4 rotateMatrix = MatrixMath::MakeRotateZMatrix(rotation_);
+        Matrix4x4 translateMatrix = MatrixMath::MakeTranslateMatrix({ position_.x, position_.y, 0.0f });
+        worldMatrix_ = MatrixMath::Multiply(rotateMatrix, translateMatrix);
+    }
+
+    // 頂点をワールド座標に変換しておく（ビュー・プロジェクションは SpriteCommon が全スプライト共通で掛ける）
+    // スプライトは z = 0, w = 1 の平面なので、x, y だけ計算すればよい
+    if (dirtyFlags_ & (kDirtyTransform | kDirtyVertices)) {
+        for (uint32_t i = 0; i < SpriteBatch::kVerticesPerSprite; ++i) {
+            const Vector4& local = localVertices_[i].position;
+            worldVertices_[i].position = {
+                local.x * worldMatrix_.m[0][0] + local.y * worldMatrix_.m[1][0] + worldMatrix_.m[3][0],
+                local.x * worldMatrix_.m[0][1] + local.y * worldMatrix_.m[1][1] + worldMatrix_.m[3][1],
+                0.0f,
+                1.0f
+            };
+            worldVertices_[i].texcoord = localVertices_[i].texcoord;
+        }
+    }
+
+    if (dirtyFlags_ & kDirtyColor) {
+        for (uint32_t i = 0; i < SpriteBatch::kVerticesPerSprite; ++i) {
+            worldVertices_[i].color = color_;
+        }
+    }
+
+    dirtyFlags_ = 0;
+    return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "SpriteBatch.h"
+#include "Matrix.h"
+#include <cstdint>
+
+// スプライト1枚分のパラメータと頂点（D3D12 に依存しない部分）
+// Sprite が1つずつ持ち、変わったところだけ頂点を作り直す
+class SpriteQuad {
+public:
+    // 頂点の更新（前回から何も変わっていなければ何もしない）
+    // fullTextureSize はテクスチャ全体の大きさ。前回と違えば、画像に合わせているサイズと UV を合わせ直す
+    // 戻り値は頂点を作り直したかどうか
+    bool Update(const Vector2& fullTextureSize);
+
+    // ワールド座標の頂点（SpriteBatch::kVerticesPerSprite 個。ビュー・プロジェクションは掛けていない）
+    auto GetVertices() const -> const SpriteBatch::Vertex (&)[SpriteBatch::kVerticesPerSprite] { return worldVertices_; }
+
+    // --- ゲッター・セッター ---
+
+    const Vector2& GetPosition() const { return position_; }
+    void SetPosition(const Vector2& position) {
+        if (position_ == position) return;
+        position_ = position;
+        dirtyFlags_ |= kDirtyTransform;
+    }
+
+    float GetRotation() const { return rotation_; }
+    void SetRotation(float rotation) {
+        if (rotation_ == rotation) return;
+        rotation_ = rotation;
+        dirtyFlags_ |= kDirtyTransform;
+    }
+
+    const Vector2& GetSize() const { return size_; }
+    void SetSize(const Vector2& size) {
+        sizeFitsTexture_ = false;
+        if (size_ == size) return;
+        size_ = size;
+        dirtyFlags_ |= kDirtyVertices;
+    }
+
+    const Vector4& GetColor() const { return color_; }
+    void SetColor(const Vector4& color) {
+        if (color_ == color) return;
+        color_ = color;
+        dirtyFlags_ |= kDirtyColor;
+    }
+
+    void SetAnchorPoint(const Vector2& anchorPoint) {
+        if (anchorPoint_ == anchorPoint) return;
+        anchorPoint_ = anchorPoint;
+        dirtyFlags_ |= kDirtyVertices;
+    }
+
+    void SetFlip(bool isFlipX, bool isFlipY) {
+        if (isFlipX_ == isFlipX && isFlipY_ == isFlipY) return;
+        isFlipX_ = isFlipX;
+        isFlipY_ = isFlipY;
+        dirtyFlags_ |= kDirtyVertices;
+    }
+
+    // テクスチャを変えたとき。切り出し範囲と表示サイズを画像全体に戻す
+    void SetTexture(const Vector2& fullTextureSize);
+
+    // テクスチャ切り出し範囲（左上座標、サイズ）。表示サイズも合わせる
+    void SetTextureRect(const Vector2& leftTop, const Vector2& size);
+
+private:
+    // ローカル座標の頂点を作り直す（サイズや切り取り範囲が変わったら Update から呼ばれる）
+    void AdjustTextureRect();
+
+    // テクスチャ全体の大きさが変わったときに、画像に合わせている切り出し範囲・表示サイズを合わせ直す
+    void ApplyTextureSize(const Vector2& fullTextureSize);
+
+    // 変更フラグ（Update で変わった部分だけ作り直す）
+    enum DirtyFlag : uint32_t {
+        kDirtyTransform = 1 << 0, // 座標・回転
+        kDirtyVertices = 1 << 1,  // サイズ・アンカー・切り出し範囲・反転・テクスチャ
+        kDirtyColor = 1 << 2,     // 色
+        kDirtyAll = kDirtyTransform | kDirtyVertices | kDirtyColor,
+    };
+
+private:
+    // ローカル座標の頂点（AdjustTextureRect で作る）
+    SpriteBatch::Vertex localVertices_[SpriteBatch::kVerticesPerSprite]{};
+    // ワールド座標の頂点（Update で作る）
+    SpriteBatch::Vertex worldVertices_[SpriteBatch::kVerticesPerSprite]{};
+    // ワールド行列（座標・回転が変わったときだけ作り直す）
+    Matrix4x4 worldMatrix_{};
+    uint32_t dirtyFlags_ = kDirtyAll;
+
+    // スプライトパラメータ
+    Vector2 position_ = { 0.0f, 0.0f };
+    float rotation_ = 0.0f;
+    Vector2 size_ = { 100.0f, 100.0f };
+    Vector2 anchorPoint_ = { 0.0f, 0.0f }; // デフォルトは左上
+    bool isFlipX_ = false;
+    bool isFlipY_ = false;
+    Vector4 color_ = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白
+
+    // テクスチャ関連
+    Vector2 textureLeftTop_ = { 0.0f, 0.0f }; // テクスチャの左上オフセット
+    Vector2 textureSize_ = { 100.0f, 100.0f }; // テクスチャの切り出しサイズ
+    Vector2 fullTextureSize_ = { 1.0f, 1.0f }; // テクスチャ全体の大きさ（最後に見たもの）
+    bool rectFitsTexture_ = true; // 切り出し範囲が画像全体（SetTextureRect で外れる）
+    bool sizeFitsTexture_ = true; // 表示サイズが画像の大きさ（SetSize・SetTextureRect で外れる）
+};
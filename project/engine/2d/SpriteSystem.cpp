@@ -0,0 +1,355 @@
+#include "SpriteSystem.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+template <typename Func>
+void SpriteSystem::ForEachArray(Func&& func) {
+    func(denseToSlot_);
+    func(positionX_);
+    func(positionY_);
+    func(cos_);
+    func(sin_);
+    func(sizeX_);
+    func(sizeY_);
+    func(anchorX_);
+    func(anchorY_);
+    func(uvLeft_);
+    func(uvTop_);
+    func(uvRight_);
+    func(uvBottom_);
+    func(color_);
+    func(textureHandle_);
+    func(rotation_);
+    func(textureSize_);
+    func(textureLeftTop_);
+    func(textureRectSize_);
+    func(flip_);
+    func(textureFit_);
+}
+
+SpriteSystem::Handle SpriteSystem::Create(uint32_t textureHandle, const Vector2& textureSize) {
+    // 空いているスロットがあれば再利用する
+    uint32_t slotIndex;
+    if (!freeSlots_.empty()) {
+        slotIndex = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slotIndex = static_cast<uint32_t>(slots_.size());
+        slots_.push_back({});
+    }
+
+    uint32_t dense = GetCount();
+    slots_[slotIndex].dense = dense;
+
+    denseToSlot_.push_back(slotIndex);
+    positionX_.push_back(0.0f);
+    positionY_.push_back(0.0f);
+    cos_.push_back(1.0f);
+    sin_.push_back(0.0f);
+    sizeX_.push_back(textureSize.x);
+    sizeY_.push_back(textureSize.y);
+    anchorX_.push_back(0.0f);
+    anchorY_.push_back(0.0f);
+    uvLeft_.push_back(0.0f);
+    uvTop_.push_back(0.0f);
+    uvRight_.push_back(1.0f);
+    uvBottom_.push_back(1.0f);
+    color_.push_back({ 1.0f, 1.0f, 1.0f, 1.0f });
+    textureHandle_.push_back(textureHandle);
+    rotation_.push_back(0.0f);
+    textureSize_.push_back(textureSize);
+    textureLeftTop_.push_back({ 0.0f, 0.0f });
+    textureRectSize_.push_back(textureSize);
+    flip_.push_back(0);
+    textureFit_.push_back(kFitRect | kFitSize);
+
+    // 前回見た大きさと違えば、次の SyncTextureSizes で確かめる
+    if (textureHandle >= knownTextureSizes_.size()) {
+        knownTextureSizes_.resize(textureHandle + 1, kUnknownTextureSize);
+    }
+    if (knownTextureSizes_[textureHandle] != textureSize) {
+        knownTextureSizes_[textureHandle] = kUnknownTextureSize;
+    }
+
+    return { slotIndex, slots_[slotIndex].generation };
+}
+
+void SpriteSystem::Destroy(Handle handle) {
+    uint32_t dense = ToDense(handle);
+    uint32_t last = GetCount() - 1;
+
+    // 末尾の要素を穴に移して詰める（移したスプライトのスロットも付け替える）
+    if (dense != last) {
+        slots_[denseToSlot_[last]].dense = dense;
+    }
+    ForEachArray([dense](auto& array) {
+        array[dense] = array.back();
+        array.pop_back();
+    });
+
+    // 古いハンドルが使えなくなるよう世代を進める
+    Slot& slot = slots_[handle.index];
+    slot.dense = kInvalidIndex;
+    ++slot.generation;
+    freeSlots_.push_back(handle.index);
+}
+
+bool SpriteSystem::IsValid(Handle handle) const {
+    return handle.index < slots_.size()
+        && slots_[handle.index].generation == handle.generation
+        && slots_[handle.index].dense != kInvalidIndex;
+}
+
+void SpriteSystem::Clear() {
+    // 発行済みのハンドルをすべて無効にする
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].dense != kInvalidIndex) {
+            slots_[i].dense = kInvalidIndex;
+            ++slots_[i].generation;
+            freeSlots_.push_back(i);
+        }
+    }
+    ForEachArray([](auto& array) { array.clear(); });
+    knownTextureSizes_.clear();
+}
+
+uint32_t SpriteSystem::ToDense(Handle handle) const {
+    assert(IsValid(handle));
+    return slots_[handle.index].dense;
+}
+
+Vector2 SpriteSystem::GetPosition(Handle handle) const {
+    uint32_t dense = ToDense(handle);
+    return { positionX_[dense], positionY_[dense] };
+}
+
+void SpriteSystem::SetPosition(Handle handle, const Vector2& position) {
+    uint32_t dense = ToDense(handle);
+    positionX_[dense] = position.x;
+    positionY_[dense] = position.y;
+}
+
+float SpriteSystem::GetRotation(Handle handle) const {
+    return rotation_[ToDense(handle)];
+}
+
+void SpriteSystem::SetRotation(Handle handle, float rotation) {
+    uint32_t dense = ToDense(handle);
+    rotation_[dense] = rotation;
+    cos_[dense] = std::cos(rotation);
+    sin_[dense] = std::sin(rotation);
+}
+
+Vector2 SpriteSystem::GetSize(Handle handle) const {
+    uint32_t dense = ToDense(handle);
+    return { sizeX_[dense], sizeY_[dense] };
+}
+
+void SpriteSystem::SetSize(Handle handle, const Vector2& size) {
+    uint32_t dense = ToDense(handle);
+    sizeX_[dense] = size.x;
+    sizeY_[dense] = size.y;
+    textureFit_[dense] &= ~kFitSize;
+}
+
+void SpriteSystem::SetAnchorPoint(Handle handle, const Vector2& anchorPoint) {
+    uint32_t dense = ToDense(handle);
+    anchorX_[dense] = anchorPoint.x;
+    anchorY_[dense] = anchorPoint.y;
+}
+
+const Vector4& SpriteSystem::GetColor(Handle handle) const {
+    return color_[ToDense(handle)];
+}
+
+void SpriteSystem::SetColor(Handle handle, const Vector4& color) {
+    color_[ToDense(handle)] = color;
+}
+
+void SpriteSystem::SetTextureRect(Handle handle, const Vector2& leftTop, const Vector2& size) {
+    uint32_t dense = ToDense(handle);
+    textureLeftTop_[dense] = leftTop;
+    textureRectSize_[dense] = size;
+    sizeX_[dense] = size.x; // 表示サイズも合わせる
+    sizeY_[dense] = size.y;
+    textureFit_[dense] = 0;
+    UpdateTexcoord(dense);
+}
+
+void SpriteSystem::SetFlip(Handle handle, bool isFlipX, bool isFlipY) {
+    uint32_t dense = ToDense(handle);
+    flip_[dense] = static_cast<uint8_t>((isFlipX ? 1 : 0) | (isFlipY ? 2 : 0));
+    UpdateTexcoord(dense);
+}
+
+void SpriteSystem::SyncTextureSizes(std::span<const Vector2> textureSizes) {
+    // 大きさが変わったテクスチャがあるか（スプライトの数ではなくテクスチャの数だけ見る）
+    size_t textureCount = (std::min)(textureSizes.size(), knownTextureSizes_.size());
+    bool changed = false;
+    for (size_t textureHandle = 0; textureHandle < textureCount; ++textureHandle) {
+        if (knownTextureSizes_[textureHandle] != textureSizes[textureHandle]) {
+            knownTextureSizes_[textureHandle] = textureSizes[textureHandle];
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+
+    for (uint32_t dense = 0; dense < GetCount(); ++dense) {
+        uint32_t textureHandle = textureHandle_[dense];
+        if (textureHandle < textureSizes.size() && textureSize_[dense] != textureSizes[textureHandle]) {
+            ApplyTextureSize(dense, textureSizes[textureHandle]);
+        }
+    }
+}
+
+void SpriteSystem::ApplyTextureSize(uint32_t dense, const Vector2& textureSize) {
+    textureSize_[dense] = textureSize;
+    if (textureFit_[dense] & kFitRect) {
+        textureRectSize_[dense] = textureSize;
+    }
+    if (textureFit_[dense] & kFitSize) {
+        sizeX_[dense] = textureSize.x;
+        sizeY_[dense] = textureSize.y;
+    }
+    UpdateTexcoord(dense);
+}
+
+void SpriteSystem::UpdateTexcoord(uint32_t dense) {
+    // Sprite::AdjustTextureRect と同じ計算
+    const Vector2& textureSize = textureSize_[dense];
+    const Vector2& leftTop = textureLeftTop_[dense];
+    const Vector2& rectSize = textureRectSize_[dense];
+    float left = leftTop.x / textureSize.x;
+    float right = (leftTop.x + rectSize.x) / textureSize.x;
+    float top = leftTop.y / textureSize.y;
+    float bottom = (leftTop.y + rectSize.y) / textureSize.y;
+
+    if (flip_[dense] & 1) std::swap(left, right);
+    if (flip_[dense] & 2) std::swap(top, bottom);
+
+    uvLeft_[dense] = left;
+    uvTop_[dense] = top;
+    uvRight_[dense] = right;
+    uvBottom_[dense] = bottom;
+}
+
+void SpriteSystem::WriteVertices(std::span<SpriteBatch::Vertex> dst, ThreadPool* threadPool) const {
+    uint32_t count = GetCount();
+    assert(dst.size() >= size_t(count) * SpriteBatch::kVerticesPerSprite);
+
+    if (threadPool) {
+        threadPool->ParallelFor(count, kGrainSize, [this, &dst](uint32_t begin, uint32_t end) {
+            WriteVerticesRange(dst.data(), begin, end);
+        });
+    } else {
+        WriteVerticesRange(dst.data(), 0, count);
+    }
+}
+
+void SpriteSystem::WriteVerticesRange(SpriteBatch::Vertex* dst, uint32_t begin, uint32_t end) const {
+    // 小さなブロックごとに ①角の座標を SoA のまま計算 → ②頂点として書き出す の2段階で処理する
+    // ①は配列どうしの単純な計算だけなので、コンパイラが SIMD 命令にまとめられる
+    constexpr uint32_t kBlockSize = 64;
+    float cornerX[SpriteBatch::kVerticesPerSprite][kBlockSize];
+    float cornerY[SpriteBatch::kVerticesPerSprite][kBlockSize];
+
+    for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += kBlockSize) {
+        uint32_t blockCount = (std::min)(kBlockSize, end - blockBegin);
+
+        const float* positionX = positionX_.data() + blockBegin;
+        const float* positionY = positionY_.data() + blockBegin;
+        const float* cosine = cos_.data() + blockBegin;
+        const float* sine = sin_.data() + blockBegin;
+        const float* sizeX = sizeX_.data() + blockBegin;
+        const float* sizeY = sizeY_.data() + blockBegin;
+        const float* anchorX = anchorX_.data() + blockBegin;
+        const float* anchorY = anchorY_.data() + blockBegin;
+
+        // ① ローカル座標（アンカー考慮）を回転・平行移動する
+        // x' = x * cos - y * sin + px,  y' = x * sin + y * cos + py
+        for (uint32_t i = 0; i < blockCount; ++i) {
+            float leftPos = -anchorX[i] * sizeX[i];
+            float rightPos = (1.0f - anchorX[i]) * sizeX[i];
+            float topPos = -anchorY[i] * sizeY[i];
+            float bottomPos = (1.0f - anchorY[i]) * sizeY[i];
+
+            float c = cosine[i];
+            float s = sine[i];
+            // 0: 左下
+            cornerX[0][i] = leftPos * c - bottomPos * s + positionX[i];
+            cornerY[0][i] = leftPos * s + bottomPos * c + positionY[i];
+            // 1: 左上
+            cornerX[1][i] = leftPos * c - topPos * s + positionX[i];
+            cornerY[1][i] = leftPos * s + topPos * c + positionY[i];
+            // 2: 右下
+            cornerX[2][i] = rightPos * c - bottomPos * s + positionX[i];
+            cornerY[2][i] = rightPos * s + bottomPos * c + positionY[i];
+            // 3: 右上
+            cornerX[3][i] = rightPos * c - topPos * s + positionX[i];
+            cornerY[3][i] = rightPos * s + topPos * c + positionY[i];
+        }
+
+        // ② 頂点を先頭から順に書き出す（書き込み専用メモリなので読み返さない）
+        SpriteBatch::Vertex* out = dst + size_t(blockBegin) * SpriteBatch::kVerticesPerSprite;
+        for (uint32_t i = 0; i < blockCount; ++i) {
+            uint32_t dense = blockBegin + i;
+            float left = uvLeft_[dense];
+            float top = uvTop_[dense];
+            float right = uvRight_[dense];
+            float bottom = uvBottom_[dense];
+            const Vector4& color = color_[dense];
+
+            out[0] = { { cornerX[0][i], cornerY[0][i], 0.0f, 1.0f }, { left, bottom }, color };
+            out[1] = { { cornerX[1][i], cornerY[1][i], 0.0f, 1.0f }, { left, top }, color };
+            out[2] = { { cornerX[2][i], cornerY[2][i], 0.0f, 1.0f }, { right, bottom }, color };
+            out[3] = { { cornerX[3][i], cornerY[3][i], 0.0f, 1.0f }, { right, top }, color };
+            out += SpriteBatch::kVerticesPerSprite;
+        }
+    }
+}
+
+void SpriteSystem::WriteInstances(std::span<SpriteInstance> dst, std::span<const uint32_t> srvIndices, ThreadPool* threadPool) const {
+    uint32_t count = GetCount();
+    assert(dst.size() >= count);
+
+    if (threadPool) {
+        threadPool->ParallelFor(count, kGrainSize, [this, &dst, srvIndices](uint32_t begin, uint32_t end) {
+            WriteInstancesRange(dst.data(), srvIndices, begin, end);
+        });
+    } else {
+        WriteInstancesRange(dst.data(), srvIndices, 0, count);
+    }
+}
+
+void SpriteSystem::WriteInstancesRange(SpriteInstance* dst, std::span<const uint32_t> srvIndices, uint32_t begin, uint32_t end) const {
+    // 角の計算はシェーダーが行うので、配列から集めて詰めるだけ（頂点の 1/4 以下の量になる）
+    for (uint32_t dense = begin; dense < end; ++dense) {
+        assert(textureHandle_[dense] < srvIndices.size());
+        dst[dense] = {
+            { positionX_[dense], positionY_[dense] },
+            { sizeX_[dense], sizeY_[dense] },
+            { anchorX_[dense], anchorY_[dense] },
+            cos_[dense],
+            sin_[dense],
+            { uvLeft_[dense], uvTop_[dense], uvRight_[dense], uvBottom_[dense] },
+            color_[dense],
+            srvIndices[textureHandle_[dense]],
+            {}
+        };
+    }
+}
+
+void SpriteSystem::BuildDrawRuns(std::vector<SpriteBatch::DrawRun>& drawRuns) const {
+    drawRuns.clear();
+    uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (drawRuns.empty() || drawRuns.back().textureHandle != textureHandle_[i]) {
+            drawRuns.push_back({ textureHandle_[i], i * SpriteBatch::kIndicesPerSprite, 0 });
+        }
+        drawRuns.back().indexCount += SpriteBatch::kIndicesPerSprite;
+    }
+}
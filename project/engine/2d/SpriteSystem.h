@@ -0,0 +1,132 @@
+#pragma once
+#include "SpriteBatch.h"
+#include "SpriteInstance.h"
+#include "Struct.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class ThreadPool;
+
+// 大量のスプライトをまとめて管理する（Sprite を1枚ずつ new する代わりに使う）
+// 座標・回転・サイズなどを種類ごとの配列（SoA）に詰めて持ち、Update で全スプライトの頂点を一度に作る。
+// スプライトはハンドルで指す。削除すると配列の穴は末尾の要素で埋めるが、ハンドルは変わらない。
+// D3D12には依存しない（頂点の書き込み先は呼び出し側が渡す）
+class SpriteSystem {
+public:
+    // スプライトを指すハンドル（削除済みのスロットが再利用されても generation で見分ける）
+    struct Handle {
+        uint32_t index = kInvalidIndex;
+        uint32_t generation = 0;
+    };
+    static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+    // 生成（textureSize はテクスチャ全体のピクセルサイズ。表示サイズと切り出し範囲も画像全体になる）
+    Handle Create(uint32_t textureHandle, const Vector2& textureSize);
+    void Destroy(Handle handle);
+    bool IsValid(Handle handle) const;
+    void Clear();
+
+    uint32_t GetCount() const { return static_cast<uint32_t>(positionX_.size()); }
+
+    // --- 各種パラメータ ---
+    Vector2 GetPosition(Handle handle) const;
+    void SetPosition(Handle handle, const Vector2& position);
+    float GetRotation(Handle handle) const;
+    void SetRotation(Handle handle, float rotation);
+    Vector2 GetSize(Handle handle) const;
+    void SetSize(Handle handle, const Vector2& size);
+    void SetAnchorPoint(Handle handle, const Vector2& anchorPoint);
+    const Vector4& GetColor(Handle handle) const;
+    void SetColor(Handle handle, const Vector4& color);
+    // テクスチャの切り出し範囲（ピクセル）。表示サイズも合わせる
+    void SetTextureRect(Handle handle, const Vector2& leftTop, const Vector2& size);
+    void SetFlip(Handle handle, bool isFlipX, bool isFlipY);
+
+    // テクスチャの大きさを合わせ直す（textureSizes はテクスチャハンドル → ピクセルサイズ）
+    // 非同期読み込みで代わりのテクスチャから差し替わったときなど、大きさが変わったテクスチャを使うスプライトだけ直す。
+    // 切り出し範囲を指定していなければ画像全体に、表示サイズを指定していなければ画像の大きさになる
+    void SyncTextureSizes(std::span<const Vector2> textureSizes);
+
+    // 全スプライトの頂点を dst に書き込む（dst には GetCount() * 4 頂点分の領域が必要）
+    // dst はアップロードヒープ（書き込み専用のメモリ）を想定して、先頭から順に書くだけで読み返さない
+    // threadPool を渡すとブロックごとに並列で処理する
+    void WriteVertices(std::span<SpriteBatch::Vertex> dst, ThreadPool* threadPool = nullptr) const;
+
+    // 全スプライトをインスタンス描画用のデータとして dst に書き込む（dst には GetCount() 個分の領域が必要）
+    // srvIndices はテクスチャハンドル → SRVの番号の表（インスタンスにはSRVの番号を書く）
+    void WriteInstances(std::span<SpriteInstance> dst, std::span<const uint32_t> srvIndices, ThreadPool* threadPool = nullptr) const;
+
+    // 同じテクスチャが連続する範囲を作る（生成順のまま並べるので、同じテクスチャは続けて生成すると効率がよい）
+    void BuildDrawRuns(std::vector<SpriteBatch::DrawRun>& drawRuns) const;
+
+private:
+    // 1回の並列処理で受け持つスプライト数
+    static constexpr uint32_t kGrainSize = 4096;
+
+    // [begin, end) の頂点を書き込む
+    void WriteVerticesRange(SpriteBatch::Vertex* dst, uint32_t begin, uint32_t end) const;
+
+    // [begin, end) のインスタンスを書き込む
+    void WriteInstancesRange(SpriteInstance* dst, std::span<const uint32_t> srvIndices, uint32_t begin, uint32_t end) const;
+
+    // ハンドルから詰めた配列の位置を引く
+    uint32_t ToDense(Handle handle) const;
+
+    // 切り出し範囲と反転から UV を作り直す
+    void UpdateTexcoord(uint32_t dense);
+
+    // テクスチャ全体の大きさを textureSize にする（画像に合わせている切り出し範囲・表示サイズも変える）
+    void ApplyTextureSize(uint32_t dense, const Vector2& textureSize);
+
+    // textureFit_ のビット
+    enum TextureFit : uint8_t {
+        kFitRect = 1 << 0, // 切り出し範囲が画像全体（SetTextureRect で外れる）
+        kFitSize = 1 << 1, // 表示サイズが画像の大きさ（SetSize・SetTextureRect で外れる）
+    };
+
+    // まだ SyncTextureSizes で確かめていないテクスチャの大きさ
+    static constexpr Vector2 kUnknownTextureSize = { -1.0f, -1.0f };
+
+    // 詰めた配列すべてに func(配列) を行う（生成・削除で要素数をそろえるため）
+    template <typename Func>
+    void ForEachArray(Func&& func);
+
+    // ハンドルのスロット（dense は詰めた配列での位置）
+    struct Slot {
+        uint32_t dense = kInvalidIndex;
+        uint32_t generation = 0;
+    };
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    // 詰めた配列の位置 → スロット番号
+    std::vector<uint32_t> denseToSlot_;
+
+    // --- 毎フレーム読む値（SoA）---
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    // 回転は cos / sin にしておき、Update で三角関数を呼ばない
+    std::vector<float> cos_;
+    std::vector<float> sin_;
+    std::vector<float> sizeX_;
+    std::vector<float> sizeY_;
+    std::vector<float> anchorX_;
+    std::vector<float> anchorY_;
+    std::vector<float> uvLeft_;
+    std::vector<float> uvTop_;
+    std::vector<float> uvRight_;
+    std::vector<float> uvBottom_;
+    std::vector<Vector4> color_;
+    std::vector<uint32_t> textureHandle_;
+
+    // --- 設定するときだけ使う値 ---
+    std::vector<float> rotation_;
+    std::vector<Vector2> textureSize_;
+    std::vector<Vector2> textureLeftTop_;
+    std::vector<Vector2> textureRectSize_;
+    std::vector<uint8_t> flip_; // bit0: 左右反転, bit1: 上下反転
+    std::vector<uint8_t> textureFit_; // TextureFit の組み合わせ
+
+    // テクスチャハンドル → 前回の SyncTextureSizes で見た大きさ（変わっていなければスプライトを見ずに済ませる）
+    std::vector<Vector2> knownTextureSizes_;
+};
@@ -0,0 +1,59 @@
+#include "TextureAtlas.h"
+#include <cstring>
+
+HRESULT TextureAtlas::Build(const std::vector<const DirectX::Image*>& images, uint32_t pageSize) {
+    pages_.clear();
+
+    // 1. 置き場所を決める（高い順に詰め、入らなければページを増やす）
+    std::vector<AtlasLayout::Size> sizes(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        sizes[i] = { uint32_t(images[i]->width), uint32_t(images[i]->height) };
+    }
+    if (!layout_.Build(sizes, pageSize)) {
+        return E_INVALIDARG;
+    }
+    const std::vector<Region>& regions = layout_.GetRegions();
+
+    // 2. ページを作って画像を貼る（隙間は透明）
+    std::vector<DirectX::ScratchImage> baseImages(layout_.GetPageCount());
+    for (DirectX::ScratchImage& baseImage : baseImages) {
+        HRESULT hr = baseImage.Initialize2D(kPageFormat, pageSize, pageSize, 1, 1);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        std::memset(baseImage.GetPixels(), 0, baseImage.GetPixelsSize());
+    }
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        // 形式が違えばページの形式に変換する
+        // （sRGB の印が付いていないだけの RGBA8 は、中身は同じとみなしてそのまま貼る）
+        const DirectX::Image* source = images[i];
+        DirectX::ScratchImage converted;
+        if (DirectX::MakeSRGB(source->format) != kPageFormat) {
+            HRESULT hr = DirectX::Convert(*source, kPageFormat, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+            if (FAILED(hr)) {
+                return hr;
+            }
+            source = converted.GetImage(0, 0, 0);
+        }
+
+        const Region& region = regions[i];
+        const DirectX::Image* destination = baseImages[region.page].GetImage(0, 0, 0);
+        size_t rowBytes = size_t(region.width) * 4;
+        for (uint32_t row = 0; row < region.height; ++row) {
+            std::memcpy(destination->pixels + (region.y + row) * destination->rowPitch + size_t(region.x) * 4,
+                source->pixels + row * source->rowPitch,
+                rowBytes);
+        }
+    }
+
+    // 3. ページごとにミップマップを作る
+    pages_.resize(baseImages.size());
+    for (size_t page = 0; page < baseImages.size(); ++page) {
+        HRESULT hr = DirectX::GenerateMipMaps(*baseImages[page].GetImage(0, 0, 0), DirectX::TEX_FILTER_SRGB, 0, pages_[page]);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+    return S_OK;
+}
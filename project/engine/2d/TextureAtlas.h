@@ -0,0 +1,33 @@
+#pragma once
+#include "AtlasLayout.h"
+#include <cstdint>
+#include <vector>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+// 小さな画像をいくつかの大きな画像（ページ）にまとめる
+// 同じページに載ったスプライトは同じテクスチャになるので、SRV を1つしか使わず、まとめて描画できる。
+// 画像の合成までを CPU で行い、GPU への転送は呼び出し側（SpriteCommon）が行う
+class TextureAtlas {
+public:
+    // 元の画像がどのページのどこに入ったか（ピクセル）
+    using Region = AtlasLayout::Region;
+
+    static constexpr uint32_t kDefaultPageSize = 2048;
+    // ページの形式（これ以外の画像は変換してから貼る）
+    static constexpr DXGI_FORMAT kPageFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+    // images をページに詰めて貼り付け、ページごとにミップマップを作る
+    // 大きい順に詰めると隙間が少なくなるので、渡した順ではなく高さの順に置く（Region は images と同じ順）
+    // ページより大きい画像があれば失敗する
+    HRESULT Build(const std::vector<const DirectX::Image*>& images, uint32_t pageSize = kDefaultPageSize);
+
+    const std::vector<Region>& GetRegions() const { return layout_.GetRegions(); }
+    const std::vector<DirectX::ScratchImage>& GetPages() const { return pages_; }
+    // ページごとの詰め込み率（画像の面積の合計 / ページの面積）
+    float GetOccupancy(uint32_t page) const { return layout_.GetOccupancy(page); }
+
+private:
+    AtlasLayout layout_;
+    std::vector<DirectX::ScratchImage> pages_;
+};
@@ -0,0 +1,29 @@
+#include "DeferredReleaseQueue.h"
+#include <algorithm>
+#include <cassert>
+
+void DeferredReleaseQueue::Push(uint64_t fenceValue, uint64_t sizeInBytes, std::function<void()> release) {
+    assert(entries_.empty() || entries_.back().fenceValue <= fenceValue);
+    entries_.push_back({ fenceValue, sizeInBytes, std::move(release) });
+
+    ++stats_.pendingCount;
+    stats_.pendingBytes += sizeInBytes;
+    stats_.peakPendingBytes = (std::max)(stats_.peakPendingBytes, stats_.pendingBytes);
+}
+
+void DeferredReleaseQueue::Process(uint64_t completedFenceValue) {
+    while (!entries_.empty() && entries_.front().fenceValue <= completedFenceValue) {
+        // release の中で Push が呼ばれても壊れないよう、取り出してから呼ぶ
+        Entry entry = std::move(entries_.front());
+        entries_.pop_front();
+
+        --stats_.pendingCount;
+        stats_.pendingBytes -= entry.sizeInBytes;
+        ++stats_.releasedCount;
+        stats_.releasedBytes += entry.sizeInBytes;
+
+        if (entry.release) {
+            entry.release();
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+// GPUがまだ使っているかもしれないものを、フェンス値に紐付けて預かっておく
+// フェンスがその値を通過したら release を呼んで解放する（D3D12には依存しない）
+class DeferredReleaseQueue {
+public:
+    // 預かっている量と、これまでに解放した量
+    struct Stats {
+        uint64_t pendingCount = 0;
+        uint64_t pendingBytes = 0;
+        uint64_t peakPendingBytes = 0;
+        uint64_t releasedCount = 0;
+        uint64_t releasedBytes = 0;
+    };
+
+    // fenceValue は単調増加で渡すこと。sizeInBytes は統計用（分からなければ 0）
+    void Push(uint64_t fenceValue, uint64_t sizeInBytes, std::function<void()> release);
+
+    // completedFenceValue までに預けたものを解放する
+    void Process(uint64_t completedFenceValue);
+
+    // 一番古い預かり物のフェンス値（空なら 0）
+    uint64_t GetOldestFenceValue() const { return entries_.empty() ? 0 : entries_.front().fenceValue; }
+    size_t GetPendingCount() const { return entries_.size(); }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    struct Entry {
+        uint64_t fenceValue;
+        uint64_t sizeInBytes;
+        std::function<void()> release;
+    };
+
+    // フェンス値の昇順に並ぶ
+    std::deque<Entry> entries_;
+    Stats stats_;
+};
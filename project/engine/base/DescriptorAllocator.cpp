@@ -0,0 +1,56 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+void DescriptorAllocator::Initialize(uint32_t persistentCapacity, uint32_t transientCapacityPerFrame, uint32_t frameCount) {
+    assert(frameCount >= 1);
+    persistentCapacity_ = persistentCapacity;
+    transientCapacity_ = transientCapacityPerFrame;
+    frameCount_ = frameCount;
+
+    nextPersistent_ = 0;
+    freeList_.clear();
+    isAllocated_.assign(persistentCapacity, 0);
+    stats_ = {};
+    BeginFrame(0);
+}
+
+uint32_t DescriptorAllocator::AllocatePersistent() {
+    uint32_t index;
+    if (!freeList_.empty()) {
+        index = freeList_.back();
+        freeList_.pop_back();
+    } else if (nextPersistent_ < persistentCapacity_) {
+        index = nextPersistent_++;
+    } else {
+        return kInvalidIndex;
+    }
+
+    isAllocated_[index] = 1;
+    ++stats_.persistentUsed;
+    stats_.persistentPeak = (std::max)(stats_.persistentPeak, stats_.persistentUsed);
+    return index;
+}
+
+void DescriptorAllocator::FreePersistent(uint32_t index) {
+    assert(index < persistentCapacity_);
+    assert(isAllocated_[index]);
+    isAllocated_[index] = 0;
+    --stats_.persistentUsed;
+    freeList_.push_back(index);
+}
+
+void DescriptorAllocator::BeginFrame(uint32_t frameIndex) {
+    assert(frameIndex < frameCount_);
+    transientBase_ = persistentCapacity_ + transientCapacity_ * frameIndex;
+    stats_.transientUsed = 0;
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count) {
+    if (count > transientCapacity_ - stats_.transientUsed) {
+        return kInvalidIndex;
+    }
+    uint32_t index = transientBase_ + stats_.transientUsed;
+    stats_.transientUsed += count;
+    return index;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// シェーダーから見えるデスクリプタヒープ1つ分の番号を割り当てる（D3D12には依存しない。番号だけを扱う）
+// ヒープの前半を「常駐領域」、後半をフレームごとの「一時領域」に分けて使う。
+//   [0, persistentCapacity)                               : 常駐（テクスチャのSRVなど。解放した番号は再利用する）
+//   [persistentCapacity + frame * transientCapacity, ...) : フレーム frame の一時領域（毎フレーム先頭から積むだけ）
+// 番号はヒープの先頭からの位置そのものなので、シェーダーはヒープ全体をテーブルにして番号で引ける（バインドレス）
+class DescriptorAllocator {
+public:
+    static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+    // 使用状況
+    struct Stats {
+        uint32_t persistentUsed = 0;
+        uint32_t persistentPeak = 0;
+        uint32_t transientUsed = 0; // 今のフレームの分
+    };
+
+    // frameCount は同時に処理するフレーム数（一時領域をその数だけ用意する）
+    void Initialize(uint32_t persistentCapacity, uint32_t transientCapacityPerFrame, uint32_t frameCount);
+
+    // 常駐領域から1つ割り当てる。空きが無ければ kInvalidIndex
+    uint32_t AllocatePersistent();
+    // 常駐領域の番号を返す（すぐに再利用されるので、GPUが使い終わってから呼ぶこと）
+    void FreePersistent(uint32_t index);
+
+    // フレームの始まり：frameIndex の一時領域を空にする（そのスロットのGPU処理が終わってから呼ぶ）
+    void BeginFrame(uint32_t frameIndex);
+    // 今のフレームの一時領域から連続した count 個を割り当て、先頭の番号を返す。足りなければ kInvalidIndex
+    uint32_t AllocateTransient(uint32_t count = 1);
+
+    // ヒープに必要なデスクリプタ数
+    uint32_t GetCapacity() const { return persistentCapacity_ + transientCapacity_ * frameCount_; }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    uint32_t persistentCapacity_ = 0;
+    uint32_t transientCapacity_ = 0;
+    uint32_t frameCount_ = 0;
+
+    // まだ一度も使っていない番号の先頭（ここから先は freeList_ に入れずに済ませる）
+    uint32_t nextPersistent_ = 0;
+    // 解放された番号（最後に解放したものから再利用する）
+    std::vector<uint32_t> freeList_;
+    // 番号ごとの使用中フラグ（二重解放の検出用）
+    std::vector<uint8_t> isAllocated_;
+
+    // 今のフレームの一時領域の先頭
+    uint32_t transientBase_ = 0;
+
+    Stats stats_;
+};
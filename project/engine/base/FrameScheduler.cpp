@@ -0,0 +1,48 @@
+#include "FrameScheduler.h"
+#include <cassert>
+
+void FrameScheduler::Initialize(Queue* queue, uint32_t framesInFlight) {
+    assert(queue);
+    assert(framesInFlight >= 1 && framesInFlight <= kMaxFramesInFlight);
+    queue_ = queue;
+    framesInFlight_ = framesInFlight;
+    frameIndex_ = 0;
+    lastSignaledValue_ = queue_->GetCompletedFenceValue();
+    slotFenceValues_.fill(lastSignaledValue_);
+    // 前の預かり物があれば、フェンスを作り直す前にすべて終わっているはず
+    retireQueue_.Process(UINT64_MAX);
+}
+
+uint64_t FrameScheduler::EndFrame() {
+    assert(queue_);
+    uint64_t fenceValue = ++lastSignaledValue_;
+    queue_->Signal(fenceValue);
+    slotFenceValues_[frameIndex_] = fenceValue;
+
+    frameIndex_ = (frameIndex_ + 1) % framesInFlight_;
+    return fenceValue;
+}
+
+uint32_t FrameScheduler::BeginFrame() {
+    assert(queue_);
+    // このスロットを前回使ったフレームが終わっていなければ待つ（それより新しいフレームは待たない）
+    uint64_t slotFenceValue = slotFenceValues_[frameIndex_];
+    if (queue_->GetCompletedFenceValue() < slotFenceValue) {
+        queue_->WaitForFenceValue(slotFenceValue);
+    }
+    retireQueue_.Process(queue_->GetCompletedFenceValue());
+    return frameIndex_;
+}
+
+void FrameScheduler::Retire(std::function<void()> release, uint64_t sizeInBytes) {
+    retireQueue_.Push(GetCurrentFenceValue(), sizeInBytes, std::move(release));
+}
+
+void FrameScheduler::WaitForIdle() {
+    assert(queue_);
+    // 今のフレームに預けた分も解放できるよう、フェンスを1つ進めてから待つ
+    uint64_t fenceValue = ++lastSignaledValue_;
+    queue_->Signal(fenceValue);
+    queue_->WaitForFenceValue(fenceValue);
+    retireQueue_.Process(fenceValue);
+}
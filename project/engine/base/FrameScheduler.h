@@ -0,0 +1,64 @@
+#pragma once
+#include "DeferredReleaseQueue.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+
+// 複数フレームを同時にGPUへ投げるためのフェンス管理
+// フレームごとにスロット（コマンドアロケータなど）を持ち、スロットを再利用するときだけ
+// そのスロットが前回使われたフレームのフェンスを待つ。
+// 使い終わったリソースは「今のフレームのフェンス値」に紐付けて預かり、GPUが通過したら解放する。
+// D3D12への依存は Queue に閉じ込めてある（シミュレーション用のキューでも動かせる）
+class FrameScheduler {
+public:
+    // コマンドキューとフェンスの実体
+    class Queue {
+    public:
+        virtual ~Queue() = default;
+        // キューの末尾でフェンスに fenceValue を書き込む
+        virtual void Signal(uint64_t fenceValue) = 0;
+        // GPUが完了したフェンス値
+        virtual uint64_t GetCompletedFenceValue() = 0;
+        // 指定のフェンス値に達するまで待つ
+        virtual void WaitForFenceValue(uint64_t fenceValue) = 0;
+    };
+
+    // 同時に処理できるフレーム数の上限
+    static constexpr uint32_t kMaxFramesInFlight = 3;
+
+    // framesInFlight は 1 ～ kMaxFramesInFlight
+    void Initialize(Queue* queue, uint32_t framesInFlight);
+
+    // フレームの終わり：フェンスを発行して次のスロットへ進む。発行したフェンス値を返す
+    uint64_t EndFrame();
+
+    // フレームの始まり：今のスロットが前回使われたフレームの完了を待つ。スロット番号を返す
+    uint32_t BeginFrame();
+
+    // 今のフレームのGPU処理が終わったら release を呼ぶ（ComPtr などをキャプチャして渡す）
+    // sizeInBytes は統計用（解放されるメモリ量。分からなければ 0）
+    void Retire(std::function<void()> release, uint64_t sizeInBytes = 0);
+
+    // 発行済みのフレームをすべて待ち、預かっているものをすべて解放する
+    void WaitForIdle();
+
+    uint32_t GetFramesInFlight() const { return framesInFlight_; }
+    uint32_t GetFrameIndex() const { return frameIndex_; }
+    // 今のフレームの終わりで発行される予定のフェンス値
+    uint64_t GetCurrentFenceValue() const { return lastSignaledValue_ + 1; }
+    uint64_t GetLastSignaledFenceValue() const { return lastSignaledValue_; }
+    size_t GetPendingRetireCount() const { return retireQueue_.GetPendingCount(); }
+    const DeferredReleaseQueue::Stats& GetRetireStats() const { return retireQueue_.GetStats(); }
+
+private:
+    Queue* queue_ = nullptr;
+    uint32_t framesInFlight_ = 2;
+    uint32_t frameIndex_ = 0;
+    uint64_t lastSignaledValue_ = 0;
+
+    // スロットごとの「最後に使われたフレームのフェンス値」
+    std::array<uint64_t, kMaxFramesInFlight> slotFenceValues_{};
+
+    // GPUが使い終わるのを待っている預かり物
+    DeferredReleaseQueue retireQueue_;
+};
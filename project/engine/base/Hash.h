@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ハッシュ関数
+namespace Hash {
+
+    // xxHash64（ファイルの中身の比較・キャッシュのキーに使う。暗号用ではない）
+    uint64_t XXH64(const void* data, size_t size, uint64_t seed = 0);
+
+}
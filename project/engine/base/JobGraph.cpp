@@ -0,0 +1,85 @@
+#include "JobGraph.h"
+#include "ThreadPool.h"
+#include <cassert>
+#include <cstdio>
+
+JobGraph::JobId JobGraph::Add(std::string name, std::function<void()> func, const std::vector<JobId>& dependencies) {
+    JobId jobId = static_cast<JobId>(jobs_.size());
+    auto job = std::make_unique<Job>();
+    job->name = std::move(name);
+    job->func = std::move(func);
+    job->dependencyCount = static_cast<uint32_t>(dependencies.size());
+    for (JobId dependency : dependencies) {
+        // 先に追加した仕事にしか依存できないので、循環はできない
+        assert(dependency < jobId);
+        jobs_[dependency]->dependents.push_back(jobId);
+    }
+    jobs_.push_back(std::move(job));
+    return jobId;
+}
+
+void JobGraph::Run(ThreadPool* threadPool) {
+    threadPool_ = threadPool;
+    startTime_ = std::chrono::steady_clock::now();
+    timings_.assign(jobs_.size(), {});
+    finishedCount_ = 0;
+    for (std::unique_ptr<Job>& job : jobs_) {
+        job->remainingDependencies = job->dependencyCount;
+    }
+
+    // 依存の無い仕事から始める（残りは終わった仕事が投げる）
+    for (JobId jobId = 0; jobId < jobs_.size(); ++jobId) {
+        if (jobs_[jobId]->dependencyCount == 0) {
+            Schedule(jobId);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]() { return finishedCount_ == jobs_.size(); });
+    totalMs_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime_).count();
+}
+
+void JobGraph::Schedule(JobId jobId) {
+    if (threadPool_) {
+        threadPool_->Submit([this, jobId]() { Execute(jobId); });
+    } else {
+        Execute(jobId);
+    }
+}
+
+void JobGraph::Execute(JobId jobId) {
+    Job& job = *jobs_[jobId];
+
+    auto begin = std::chrono::steady_clock::now();
+    job.func();
+    auto end = std::chrono::steady_clock::now();
+    // timings_ は仕事ごとに別の要素なので、ロックしなくてよい
+    timings_[jobId] = {
+        job.name,
+        std::chrono::duration<double, std::milli>(begin - startTime_).count(),
+        std::chrono::duration<double, std::milli>(end - begin).count()
+    };
+
+    // 最後の依存が終わった仕事を投げる
+    for (JobId dependent : job.dependents) {
+        if (--jobs_[dependent]->remainingDependencies == 0) {
+            Schedule(dependent);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++finishedCount_;
+    condition_.notify_all();
+}
+
+std::string JobGraph::BuildReport() const {
+    std::string report;
+    char line[256];
+    for (const Timing& timing : timings_) {
+        std::snprintf(line, sizeof(line), "  %-40s start %8.2f ms  took %8.2f ms\n", timing.name.c_str(), timing.startMs, timing.durationMs);
+        report += line;
+    }
+    std::snprintf(line, sizeof(line), "  total %.2f ms\n", totalMs_);
+    report += line;
+    return report;
+}
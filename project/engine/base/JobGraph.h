@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// 依存関係のある仕事をまとめて並列に実行する（シェーダーのコンパイル → PSO 作成 など）
+// 依存している仕事がすべて終わったものから ThreadPool に投げる。仕事ごとの開始・終了時刻も記録する
+// D3D12には依存しない
+class JobGraph {
+public:
+    using JobId = uint32_t;
+
+    // 仕事1つ分の時間（Run を呼んだ時刻からのミリ秒）
+    struct Timing {
+        std::string name;
+        double startMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    // 仕事を追加する。dependencies はこの仕事より前に終わっている必要がある仕事（先に Add したもの）
+    JobId Add(std::string name, std::function<void()> func, const std::vector<JobId>& dependencies = {});
+
+    // すべての仕事を実行し、終わるまで待つ（threadPool が nullptr なら追加した順にその場で実行する）
+    // ワーカースレッドの中から呼ばないこと（自分の仕事の完了を待って止まる）
+    void Run(ThreadPool* threadPool);
+
+    // Run の結果
+    const std::vector<Timing>& GetTimings() const { return timings_; }
+    double GetTotalMs() const { return totalMs_; }
+    // 仕事ごとの時間を並べた文字列（ログ用）
+    std::string BuildReport() const;
+
+private:
+    struct Job {
+        std::string name;
+        std::function<void()> func;
+        std::vector<JobId> dependents; // この仕事を待っている仕事
+        uint32_t dependencyCount = 0;
+        std::atomic<uint32_t> remainingDependencies = 0;
+    };
+
+    // job を実行し、待っていた仕事のうち準備ができたものを投げる
+    void Execute(JobId jobId);
+    void Schedule(JobId jobId);
+
+    std::vector<std::unique_ptr<Job>> jobs_;
+    std::vector<Timing> timings_;
+    double totalMs_ = 0.0;
+
+    // Run の間だけ使う
+    ThreadPool* threadPool_ = nullptr;
+    std::chrono::steady_clock::time_point startTime_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    uint32_t finishedCount_ = 0;
+};
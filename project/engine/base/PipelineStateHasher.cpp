@@ -0,0 +1,49 @@
+#include "PipelineStateHasher.h"
+#include "Hash.h"
+#include <cstring>
+
+namespace {
+    // nullptr の文字列の長さの代わりに積む値
+    constexpr uint32_t kNullStringMarker = 0xFFFFFFFFu;
+}
+
+void PipelineStateHasher::AddUInt32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        bytes_.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void PipelineStateHasher::AddUInt64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        bytes_.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void PipelineStateHasher::AddFloat(float value) {
+    if (value == 0.0f) {
+        value = 0.0f;
+    }
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    AddUInt32(bits);
+}
+
+void PipelineStateHasher::AddBytes(const void* data, size_t size) {
+    AddUInt64(size);
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    bytes_.insert(bytes_.end(), begin, begin + size);
+}
+
+void PipelineStateHasher::AddString(const char* text) {
+    if (!text) {
+        AddUInt32(kNullStringMarker);
+        return;
+    }
+    size_t length = std::strlen(text);
+    AddUInt32(static_cast<uint32_t>(length));
+    bytes_.insert(bytes_.end(), text, text + length);
+}
+
+uint64_t PipelineStateHasher::Finish() const {
+    return Hash::XXH64(bytes_.data(), bytes_.size());
+}
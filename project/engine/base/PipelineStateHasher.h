@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// PSO の記述を正規化したバイト列にしてハッシュを取る（同じ内容の PSO をまとめる・ディスクのキャッシュの名前にする）
+// ポインタは積まず、指している中身（シェーダーのバイトコード・セマンティクス名など）を積む。
+// 値はすべて幅を固定したリトルエンディアンで積むので、同じ内容なら実行ごと・環境ごとに同じハッシュになる。
+// 何を積むか（使われない項目を省くなど）は呼ぶ側が決める
+// D3D12には依存しない
+class PipelineStateHasher {
+public:
+    void AddUInt32(uint32_t value);
+    void AddUInt64(uint64_t value);
+    void AddBool(bool value) { AddUInt32(value ? 1 : 0); }
+    // -0.0f は 0.0f として積む
+    void AddFloat(float value);
+    // 長さ付きで積む（隣の項目と区切りがずれて同じ並びになることはない）
+    void AddBytes(const void* data, size_t size);
+    // nullptr と "" は別のものとして積む
+    void AddString(const char* text);
+
+    // ここまでに積んだものの xxHash64
+    uint64_t Finish() const;
+
+    // 積んだバイト列（確認用）
+    const std::vector<uint8_t>& GetBytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
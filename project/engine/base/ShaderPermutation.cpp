@@ -0,0 +1,76 @@
+#include "ShaderPermutation.h"
+#include <cassert>
+
+namespace {
+    // ビットの順に並べた #define 名
+    constexpr const char* kDefineNames[ShaderFeature::kCount] = {
+        "LIGHTING",
+        "ALPHA_TEST",
+        "UV_TRANSFORM",
+    };
+}
+
+const char* ShaderPermutation::GetDefineName(uint32_t featureBit) {
+    for (uint32_t i = 0; i < ShaderFeature::kCount; ++i) {
+        if (featureBit == (1u << i)) {
+            return kDefineNames[i];
+        }
+    }
+    assert(false && "unknown shader feature");
+    return "";
+}
+
+std::vector<std::wstring> ShaderPermutation::BuildDefineArguments(uint32_t features) {
+    assert((features & ~ShaderFeature::kAll) == 0);
+
+    std::vector<std::wstring> arguments;
+    for (uint32_t i = 0; i < ShaderFeature::kCount; ++i) {
+        if (features & (1u << i)) {
+            // 名前は ASCII なのでそのまま広げてよい
+            std::string name = kDefineNames[i];
+            arguments.push_back(L"-D");
+            arguments.push_back(std::wstring(name.begin(), name.end()) + L"=1");
+        }
+    }
+    return arguments;
+}
+
+std::vector<uint32_t> ShaderPermutation::EnumerateVariants(uint32_t supportedFeatures) {
+    assert((supportedFeatures & ~ShaderFeature::kAll) == 0);
+
+    // supportedFeatures の部分集合を小さい順にたどる
+    std::vector<uint32_t> variants;
+    uint32_t features = 0;
+    do {
+        variants.push_back(features);
+        features = (features - supportedFeatures) & supportedFeatures;
+    } while (features != 0);
+    return variants;
+}
+
+std::string ShaderPermutation::BuildVariantName(uint32_t features) {
+    std::string name;
+    for (uint32_t i = 0; i < ShaderFeature::kCount; ++i) {
+        if (features & (1u << i)) {
+            if (!name.empty()) {
+                name += '|';
+            }
+            name += kDefineNames[i];
+        }
+    }
+    return name.empty() ? "none" : name;
+}
+
+uint32_t ShaderPermutation::SelectMaterialFeatures(bool enableLighting, bool hasUvTransform, bool alphaTest) {
+    uint32_t features = ShaderFeature::kNone;
+    if (enableLighting) {
+        features |= ShaderFeature::kLighting;
+    }
+    if (hasUvTransform) {
+        features |= ShaderFeature::kUvTransform;
+    }
+    if (alphaTest) {
+        features |= ShaderFeature::kAlphaTest;
+    }
+    return features;
+}
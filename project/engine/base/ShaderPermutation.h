@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// シェーダーの機能。ビット1つにつき #define を1つ付けてコンパイルし、使わない機能の計算はバリアントごと省く
+namespace ShaderFeature {
+    constexpr uint32_t kNone = 0;
+    constexpr uint32_t kLighting = 1u << 0;    // LIGHTING: 平行光源のライティング
+    constexpr uint32_t kAlphaTest = 1u << 1;   // ALPHA_TEST: 完全に透明なピクセルを捨てる
+    constexpr uint32_t kUvTransform = 1u << 2; // UV_TRANSFORM: UV に行列を掛ける
+
+    constexpr uint32_t kCount = 3;
+    // 機能の組み合わせの数（バリアントを機能ビットで引く配列の大きさ）
+    constexpr uint32_t kVariantCount = 1u << kCount;
+    constexpr uint32_t kAll = kVariantCount - 1;
+}
+
+// 機能ビットとコンパイラの引数・名前の変換
+// DXC・D3D12には依存しない
+namespace ShaderPermutation {
+
+    // 機能1つ分の #define 名（LIGHTING など）。featureBit はビット1つだけ
+    const char* GetDefineName(uint32_t featureBit);
+
+    // DXC に渡す引数（-D LIGHTING=1 ...）。ビットの小さい順に並ぶので、同じ組み合わせなら同じ引数（＝同じキャッシュのキー）になる
+    std::vector<std::wstring> BuildDefineArguments(uint32_t features);
+
+    // supportedFeatures の組み合わせすべて（機能無しを含む 2^n 個。小さい順）
+    std::vector<uint32_t> EnumerateVariants(uint32_t supportedFeatures);
+
+    // ログ用の名前（"LIGHTING|ALPHA_TEST"、機能無しなら "none"）
+    std::string BuildVariantName(uint32_t features);
+
+    // マテリアルの設定から要る機能だけを選ぶ
+    // hasUvTransform: UV の行列が単位行列でないか / alphaTest: 抜きのあるテクスチャを使うか
+    uint32_t SelectMaterialFeatures(bool enableLighting, bool hasUvTransform, bool alphaTest);
+
+}
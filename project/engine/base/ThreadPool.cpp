@@ -0,0 +1,115 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+ThreadPool::~ThreadPool() {
+    Finalize();
+}
+
+void ThreadPool::Initialize(uint32_t threadCount) {
+    assert(workers_.empty());
+    if (threadCount == 0) {
+        uint32_t hardwareCount = std::thread::hardware_concurrency();
+        threadCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+    }
+
+    isStopping_ = false;
+    workers_.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerMain, this);
+    }
+}
+
+void ThreadPool::Finalize() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+    // ワーカーがいなければその場で実行する
+    if (workers_.empty()) {
+        job();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& func) {
+    if (count == 0) {
+        return;
+    }
+    grainSize = (std::max)(grainSize, 1u);
+    uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    // 1チャンクしかなければ分ける意味がない
+    if (chunkCount == 1 || workers_.empty()) {
+        func(0, count);
+        return;
+    }
+
+    // ワーカーは ParallelFor が戻った後に起きることもあるので、共有データはヒープに置く
+    struct Shared {
+        std::atomic<uint32_t> nextChunk = 0;
+        std::atomic<uint32_t> doneChunks = 0;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto shared = std::make_shared<Shared>();
+
+    // 空いているチャンクを取っては処理する（早く終わったスレッドが多く取る）
+    auto runChunks = [shared, count, grainSize, chunkCount, &func]() {
+        uint32_t done = 0;
+        for (uint32_t chunk = shared->nextChunk++; chunk < chunkCount; chunk = shared->nextChunk++) {
+            uint32_t begin = chunk * grainSize;
+            uint32_t end = (std::min)(begin + grainSize, count);
+            func(begin, end);
+            ++done;
+        }
+        if (done > 0 && shared->doneChunks.fetch_add(done) + done == chunkCount) {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->condition.notify_all();
+        }
+    };
+
+    // 呼び出し元も働くので、ワーカーに頼むのは (チャンク数 - 1) 人まで
+    uint32_t helperCount = (std::min)(GetThreadCount(), chunkCount - 1);
+    for (uint32_t i = 0; i < helperCount; ++i) {
+        Submit(runChunks);
+    }
+    runChunks();
+
+    // 他のスレッドが持っているチャンクの完了を待つ
+    // （func はこの関数の引数なので、全チャンクが終わるまで戻ってはいけない）
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->condition.wait(lock, [&shared, chunkCount]() { return shared->doneChunks.load() == chunkCount; });
+}
+
+void ThreadPool::WorkerMain() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return isStopping_ || !jobs_.empty(); });
+            // 止めるときも、積まれている仕事は最後までやる
+            if (jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ワーカースレッドをあらかじめ起こしておき、仕事（関数）を投げて実行してもらう
+// 毎フレーム std::thread を作ると生成コストが大きいので、エンジン全体で1つを使い回す
+class ThreadPool {
+public:
+    ThreadPool() = default;
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // threadCount が 0 なら「論理コア数 - 1」（呼び出し元のスレッドも仕事をするため）
+    void Initialize(uint32_t threadCount = 0);
+
+    // 残っている仕事を終わらせてからワーカーを止める
+    void Finalize();
+
+    // 仕事を投げる（終わりを待たない）
+    void Submit(std::function<void()> job);
+
+    // [0, count) を grainSize 個ずつに分けて並列に func(begin, end) を呼び、全部終わるまで待つ
+    // 呼び出し元のスレッドも分担するので、ワーカーが0人でも動く
+    void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+private:
+    void WorkerMain();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool isStopping_ = false;
+};
@@ -0,0 +1,81 @@
+#include "UploadRingAllocator.h"
+#include <cassert>
+
+namespace {
+    uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+void UploadRingAllocator::Initialize(Backend* backend, uint64_t capacity) {
+    assert(backend);
+    assert(capacity > 0 && capacity % kDefaultAlignment == 0);
+    backend_ = backend;
+    capacity_ = capacity;
+    head_ = 0;
+    tail_ = 0;
+    frames_.clear();
+}
+
+UploadRingAllocator::Allocation UploadRingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+    assert(backend_);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    assert(size > 0);
+    // 1回分がリングに入りきらない
+    if (size > capacity_) {
+        return {};
+    }
+
+    while (true) {
+        // 位置を揃え、末尾をはみ出す場合は先頭に折り返す
+        uint64_t offset = AlignUp(head_ % capacity_, alignment);
+        uint64_t start = head_ - head_ % capacity_ + offset;
+        if (offset + size > capacity_) {
+            start = head_ - head_ % capacity_ + capacity_;
+            offset = 0;
+        }
+        uint64_t end = start + size;
+
+        if (end - tail_ <= capacity_) {
+            head_ = end;
+
+            Allocation allocation;
+            allocation.cpuAddress = backend_->GetMappedPointer() + offset;
+            allocation.gpuAddress = backend_->GetGpuAddress() + offset;
+            allocation.offset = offset;
+            allocation.size = size;
+            return allocation;
+        }
+
+        // 空きが無い：まず完了済みのフレームを回収し、それでも足りなければ最も古いフレームを待つ
+        uint64_t oldTail = tail_;
+        Retire(backend_->GetCompletedFenceValue());
+        if (tail_ == oldTail) {
+            // 今のフレームだけでリングを使い切っている（待っても空かない）
+            if (frames_.empty()) {
+                return {};
+            }
+            backend_->WaitForFenceValue(frames_.front().fenceValue);
+            Retire(backend_->GetCompletedFenceValue());
+        }
+    }
+}
+
+void UploadRingAllocator::FinishFrame(uint64_t fenceValue) {
+    assert(frames_.empty() || frames_.back().fenceValue <= fenceValue);
+    frames_.push_back({ fenceValue, head_ });
+    // 毎フレーム少しずつ回収しておく
+    Retire(backend_->GetCompletedFenceValue());
+}
+
+void UploadRingAllocator::Retire(uint64_t completedFenceValue) {
+    while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue) {
+        tail_ = frames_.front().end;
+        frames_.pop_front();
+    }
+    // 使用中の領域が無ければ先頭に戻しておくと、折り返しによる無駄が減る
+    if (frames_.empty() && tail_ == head_) {
+        head_ = 0;
+        tail_ = 0;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+// アップロードヒープ用のリングアロケータ
+// Mapしたままの大きなバッファ1本から、フレームごとの一時データ（定数バッファ・頂点・インデックス）を切り出す。
+// 切り出した領域はフレーム終了時のフェンス値と結び付け、GPUがそのフェンスを通過したら再利用する。
+// D3D12への依存は Backend に閉じ込めてある（偽のフェンスを使えばD3D12なしで動かせる）
+class UploadRingAllocator {
+public:
+    // バッファとフェンスの実体
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+        // Map済みバッファの先頭（CPU側）
+        virtual uint8_t* GetMappedPointer() = 0;
+        // バッファの先頭（GPU仮想アドレス）
+        virtual uint64_t GetGpuAddress() = 0;
+        // GPUが完了したフェンス値
+        virtual uint64_t GetCompletedFenceValue() = 0;
+        // 指定のフェンス値に達するまで待つ
+        virtual void WaitForFenceValue(uint64_t fenceValue) = 0;
+    };
+
+    // 切り出した領域（切り出せなかったときは cpuAddress が nullptr）
+    struct Allocation {
+        void* cpuAddress = nullptr;
+        uint64_t gpuAddress = 0;
+        uint64_t offset = 0; // バッファ先頭からのオフセット
+        uint64_t size = 0;
+
+        bool IsValid() const { return cpuAddress != nullptr; }
+    };
+
+    // 定数バッファの配置に必要なアラインメント (D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+    static constexpr uint64_t kDefaultAlignment = 256;
+
+    // capacity は kDefaultAlignment の倍数であること
+    void Initialize(Backend* backend, uint64_t capacity);
+
+    // size バイトを切り出す。空きが無ければ古いフレームの完了を待つ
+    // size が容量を超える・今のフレームだけでリングを使い切っている（待っても空かない）ときは失敗を返す
+    // 失敗したら呼ぶ側で専用のバッファを用意すること
+    Allocation Allocate(uint64_t size, uint64_t alignment = kDefaultAlignment);
+
+    // ここまでに切り出した領域を fenceValue のフレームのものとして締める
+    void FinishFrame(uint64_t fenceValue);
+
+    // 使用中のバイト数（GPU完了待ちのフレーム分も含む）
+    uint64_t GetUsedSize() const { return head_ - tail_; }
+    uint64_t GetCapacity() const { return capacity_; }
+
+private:
+    // GPUが使い終わったフレームの領域を解放する
+    void Retire(uint64_t completedFenceValue);
+
+    // フレームの終端（フェンス値と、そのフレームで使った領域の終わり）
+    struct FrameMarker {
+        uint64_t fenceValue;
+        uint64_t end;
+    };
+
+    Backend* backend_ = nullptr;
+    uint64_t capacity_ = 0;
+
+    // 先頭・末尾は折り返さずに増え続ける値で持ち、実際の位置は capacity_ の剰余で求める
+    uint64_t head_ = 0; // 次に切り出す位置
+    uint64_t tail_ = 0; // まだGPUが使っている最も古い位置
+
+    std::deque<FrameMarker> frames_;
+};
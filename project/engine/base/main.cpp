@@ -4,6 +4,8 @@
 #include "Input.h"
 #include "SpriteCommon.h"
 #include "Sprite.h"
+#include "SpriteSystem.h"
+#include "ThreadPool.h"
 
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     WinApp* winApp = new WinApp();
@@ -13,9 +15,15 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     Input* input = new Input();
     input->Initialize(winApp);
 
+    // --- ワーカースレッド ---
+    ThreadPool* threadPool = new ThreadPool();
+    threadPool->Initialize();
+
     // --- SpriteCommon 初期化 ---
     SpriteCommon* spriteCommon = new SpriteCommon();
-    spriteCommon->Initialize(dxCommon);
+    spriteCommon->Initialize(dxCommon, threadPool);
+    // 起動時の PSO は作り終えたので、新しく作ったものがあれば次回のために書き出す
+    dxCommon->SavePipelineLibrary();
 
     // --- テクスチャ読み込み ---
     // LoadTextureはテクスチャハンドル（番号）を返す
@@ -35,6 +43,19 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     sprite2->SetTextureRect({ 0.0f, 0.0f }, { 200.0f, 100.0f }); // 左上から200x100だけ切り取る
     sprite2->SetAnchorPoint({ 0.5f, 0.5f }); // 中心を原点にする
 
+    // 3つ目以降：SpriteSystem でまとめて管理する小さなスプライトの列
+    SpriteSystem* spriteSystem = new SpriteSystem();
+    // 非同期読み込みのテクスチャでも、差し替わったときに描画の前で合わせ直される
+    Vector2 textureSize = spriteCommon->GetTextureSize(textureHandleMonster);
+    std::vector<SpriteSystem::Handle> smallSprites;
+    for (uint32_t i = 0; i < 32; ++i) {
+        SpriteSystem::Handle handle = spriteSystem->Create(textureHandleMonster, textureSize);
+        spriteSystem->SetSize(handle, { 32.0f, 32.0f });
+        spriteSystem->SetAnchorPoint(handle, { 0.5f, 0.5f });
+        spriteSystem->SetPosition(handle, { 40.0f + 38.0f * i, 660.0f });
+        smallSprites.push_back(handle);
+    }
+
     while (true) {
         if (winApp->ProcessMessage()) break;
         input->Update();
@@ -46,21 +67,34 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 
         sprite2->Update();
 
+        for (size_t i = 0; i < smallSprites.size(); ++i) {
+            float rotation = spriteSystem->GetRotation(smallSprites[i]);
+            spriteSystem->SetRotation(smallSprites[i], rotation + 0.01f * float(i + 1));
+        }
+
         // --- 描画 ---
         dxCommon->PreDraw();
         spriteCommon->PreDraw(); // 共通設定ON
 
         sprite1->Draw();
         sprite2->Draw();
+        spriteCommon->DrawSpriteSystemInstanced(*spriteSystem, threadPool);
+
+        spriteCommon->PostDraw(); // バッチに溜めたスプライトをまとめて描画
 
         dxCommon->PostDraw();
     }
 
+    // 複数フレームを同時に処理しているので、GPUが終わってから解放する
+    dxCommon->WaitForGpu();
+
     delete sprite1;
     delete sprite2;
+    delete spriteSystem;
     delete spriteCommon;
     delete input;
     delete dxCommon;
+    delete threadPool;
     delete winApp;
 
     return 0;
@@ -0,0 +1,89 @@
+#include "AsyncTextureLoader.h"
+#include "TextureCache.h"
+#include "TextureDecoder.h"
+#include "ThreadPool.h"
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    // ワーカーが this を使っているうちに消えないようにする
+    WaitAll();
+}
+
+void AsyncTextureLoader::Initialize(ThreadPool* threadPool, const TextureCache* textureCache) {
+    threadPool_ = threadPool;
+    textureCache_ = textureCache;
+}
+
+void AsyncTextureLoader::Request(uint32_t textureHandle, std::wstring filePath) {
+    ++pendingCount_;
+    if (!threadPool_) {
+        Decode(textureHandle, filePath);
+        return;
+    }
+    threadPool_->Submit([this, textureHandle, filePath = std::move(filePath)]() {
+        Decode(textureHandle, filePath);
+    });
+}
+
+void AsyncTextureLoader::Decode(uint32_t textureHandle, const std::wstring& filePath) {
+    Result result;
+    result.textureHandle = textureHandle;
+    if (decoder_) {
+        decoder_(filePath, result);
+    } else {
+        // 同じ中身の画像がすでにあるかはメインスレッドが contentHash で調べる
+        Load(filePath, TextureCache::HashFile(filePath), result);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.push_back(std::move(result));
+    // ロックの中で減らすので、WaitAll が 0 を見たときには結果が completed_ に入っている
+    --pendingCount_;
+    condition_.notify_all();
+}
+
+void AsyncTextureLoader::Load(const std::wstring& filePath, uint64_t contentHash, Result& result) const {
+    result.contentHash = contentHash;
+
+    // 1. そのまま転送できる DDS ならマップするだけにする
+    bool isMapped = false;
+    if (TextureDecoder::IsDdsPath(filePath) && result.mappedFile.Open(filePath)) {
+        isMapped = result.ddsLayout.Parse(result.mappedFile.GetData(), result.mappedFile.GetSize());
+        if (!isMapped) {
+            result.mappedFile.Close();
+        }
+    }
+
+    // 2. 前回デコードしたものがキャッシュにあればそれをマップする
+    if (!isMapped && textureCache_) {
+        isMapped = textureCache_->Open(contentHash, result.mappedFile, result.ddsLayout);
+    }
+
+    if (isMapped) {
+        // メインスレッドで転送するときにページの読み込みを待たないよう、ここで一度触っておく
+        constexpr size_t kPageSize = 4096;
+        volatile uint8_t touch = 0;
+        for (size_t offset = 0; offset < result.mappedFile.GetSize(); offset += kPageSize) {
+            touch = touch + result.mappedFile.GetData()[offset];
+        }
+        return;
+    }
+
+    // 3. デコードして、次回のためにキャッシュに残す（保存に失敗しても読み込みは成功扱い）
+    result.hr = TextureDecoder::Decode(filePath, result.mipImages);
+    if (SUCCEEDED(result.hr) && textureCache_ && !TextureDecoder::IsDdsPath(filePath)) {
+        textureCache_->Store(contentHash, result.mipImages);
+    }
+}
+
+void AsyncTextureLoader::CollectCompleted(std::vector<Result>& results) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Result& result : completed_) {
+        results.push_back(std::move(result));
+    }
+    completed_.clear();
+}
+
+void AsyncTextureLoader::WaitAll() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]() { return pendingCount_.load() == 0; });
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "DdsLayout.h"
+#include "MappedFile.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+class TextureCache;
+class ThreadPool;
+
+// テクスチャのデコードとミップマップ生成をワーカースレッドで行う
+// 要求はすぐに戻り、終わったものはメインスレッドが CollectCompleted で受け取る（GPUへの転送は受け取った側が行う）
+// D3D12には依存しない
+class AsyncTextureLoader {
+public:
+    // デコードが終わった画像
+    // DDS とキャッシュにあったものはデコードせずにファイルをマップしたまま返す（mappedFile が開いていればこちら）
+    struct Result {
+        uint32_t textureHandle = 0;
+        uint64_t contentHash = 0; // 元ファイルの中身のハッシュ（TextureCache のキー。同じ画像の判定にも使う）
+        HRESULT hr = S_OK;
+        DirectX::ScratchImage mipImages;
+        MappedFile mappedFile;
+        DdsLayout ddsLayout;
+    };
+
+    // 1枚分を読み込む関数（result の textureHandle 以外を埋める）
+    using Decoder = std::function<void(const std::wstring& filePath, Result& result)>;
+
+    ~AsyncTextureLoader();
+
+    // threadPool が nullptr なら Request の中でその場でデコードする
+    // textureCache を渡すと、デコードした画像を保存し、次からはそれを読む
+    void Initialize(ThreadPool* threadPool, const TextureCache* textureCache = nullptr);
+
+    // 読み込みを差し替える（テストでファイルを読まない偽物を使うとき）。空なら下の Load を使う
+    // Request より前に呼ぶ
+    void SetDecoder(Decoder decoder) { decoder_ = std::move(decoder); }
+
+    // textureHandle は呼び出し側が決めた番号（結果にそのまま入って返ってくる）
+    void Request(uint32_t textureHandle, std::wstring filePath);
+
+    // 終わったものを results の末尾に移す（メインスレッドから呼ぶ）
+    void CollectCompleted(std::vector<Result>& results);
+
+    // 投げた要求がすべて終わるまで待つ
+    void WaitAll();
+
+    // デコード中（まだ CollectCompleted で受け取れない）の数
+    uint32_t GetPendingCount() const { return pendingCount_.load(); }
+
+    // 呼び出したスレッドでその場で読み込む（同期読み込み用。contentHash は TextureCache::HashFile で取ったもの）
+    // DDS → マップ、キャッシュにある → マップ、どちらでもない → デコードしてキャッシュに保存 の順に試す
+    void Load(const std::wstring& filePath, uint64_t contentHash, Result& result) const;
+
+private:
+    void Decode(uint32_t textureHandle, const std::wstring& filePath);
+
+    ThreadPool* threadPool_ = nullptr;
+    const TextureCache* textureCache_ = nullptr;
+    Decoder decoder_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<Result> completed_;
+    std::atomic<uint32_t> pendingCount_ = 0;
+};
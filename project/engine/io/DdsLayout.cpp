@@ -0,0 +1,75 @@
+#include "DdsLayout.h"
+#include "externals/DirectXTex/DDS.h"
+#include <cstring>
+
+bool DdsLayout::Parse(const uint8_t* data, size_t size) {
+    subresources.clear();
+
+    // 1. ヘッダー
+    if (size < sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER)) {
+        return false;
+    }
+    uint32_t magic;
+    std::memcpy(&magic, data, sizeof(magic));
+    if (magic != DirectX::DDS_MAGIC) {
+        return false;
+    }
+    DirectX::DDS_HEADER header;
+    std::memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+
+    bool hasDx10Header = (header.ddspf.flags & DDS_FOURCC) && header.ddspf.fourCC == MAKEFOURCC('D', 'X', '1', '0');
+    size_t dataOffset = sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + (hasDx10Header ? sizeof(DirectX::DDS_HEADER_DXT10) : 0);
+
+    // 形式・サイズなどは DirectXTex に解釈してもらう
+    if (FAILED(DirectX::GetMetadataFromDDSMemory(data, size, DirectX::DDS_FLAGS_NONE, metadata))) {
+        return false;
+    }
+
+    // 古い形式の中には読み込み時に変換が必要なものがある（24bit RGB など）ので、
+    // ファイルのバイト列がそのまま使えると分かっているものだけにする
+    if (!hasDx10Header && !DirectX::IsCompressed(metadata.format)) {
+        return false;
+    }
+    if (metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D) {
+        return false;
+    }
+    if (!HasValidBlockSize(metadata)) {
+        return false;
+    }
+
+    // 2. サブリソースの並び（配列要素ごとに、全ミップマップが続く）
+    size_t offset = dataOffset;
+    subresources.reserve(metadata.arraySize * metadata.mipLevels);
+    for (size_t item = 0; item < metadata.arraySize; ++item) {
+        size_t width = metadata.width;
+        size_t height = metadata.height;
+        for (size_t mip = 0; mip < metadata.mipLevels; ++mip) {
+            size_t rowPitch;
+            size_t slicePitch;
+            if (FAILED(DirectX::ComputePitch(metadata.format, width, height, rowPitch, slicePitch))) {
+                subresources.clear();
+                return false;
+            }
+            subresources.push_back({ offset, rowPitch, slicePitch });
+            offset += slicePitch;
+
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+    }
+
+    // 3. ファイルが途中で切れていないか
+    if (offset > size) {
+        subresources.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DdsLayout::HasValidBlockSize(const DirectX::TexMetadata& metadata) {
+    if (!DirectX::IsCompressed(metadata.format)) {
+        return true;
+    }
+    // 小さいミップは 4 の倍数でなくてよい（ブロックの一部だけを使う）
+    return metadata.width % 4 == 0 && metadata.height % 4 == 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+// メモリ上の DDS ファイルから、各サブリソース（ミップマップ・配列要素）の位置を調べる
+// ピクセルはコピーせず、ファイルの中を指すオフセットだけを作る（D3D12には依存しない）
+struct DdsLayout {
+    // サブリソース1つ分（ファイル先頭からの位置）
+    struct Subresource {
+        size_t offset;
+        size_t rowPitch;
+        size_t slicePitch;
+    };
+
+    DirectX::TexMetadata metadata{};
+    // D3D12 のサブリソース番号の順（配列要素ごとに、ミップマップの大きい順）
+    std::vector<Subresource> subresources;
+
+    // data を DDS として解析する
+    // 変換なしでそのまま GPU に渡せる形式（DX10 拡張ヘッダー付き、またはブロック圧縮）の2Dテクスチャだけを受け付け、
+    // それ以外（古い形式で変換が要るもの・ボリュームテクスチャ・下の HasValidBlockSize を満たさないものなど）は false を返す
+    bool Parse(const uint8_t* data, size_t size);
+
+    // D3D12 で作れる大きさか（ブロック圧縮の形式は、最上位のミップの幅・高さが 4 の倍数でないと作れない）
+    static bool HasValidBlockSize(const DirectX::TexMetadata& metadata);
+};
@@ -0,0 +1,671 @@
+#include "ModelLoader.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    // 並列に読むときのチャンクの大きさの下限（これより小さいファイルは分けない）
+    constexpr size_t kMinChunkSize = 1024 * 1024;
+    // スレッド1つあたりのチャンクの数（行の中身の偏りをならす）
+    constexpr size_t kChunksPerThread = 4;
+    // 頂点を並列に書き込むときの分担の単位
+    constexpr uint32_t kVertexGrainSize = 4096;
+    // チャンクをまたいで重複を除くときの、スレッド1つあたりの表の数
+    constexpr uint32_t kShardsPerThread = 2;
+
+    // v/vt/vn の番号の組（無いものは kMissing）
+    struct CornerKey {
+        static constexpr uint32_t kMissing = UINT32_MAX;
+
+        uint32_t position;
+        uint32_t texcoord;
+        uint32_t normal;
+
+        bool operator==(const CornerKey& other) const = default;
+    };
+
+    uint64_t HashCornerKey(const CornerKey& key) {
+        return (uint64_t(key.position) * 0x9E3779B97F4A7C15ull) ^ (uint64_t(key.texcoord) * 0xC2B2AE3D27D4EB4Full) ^ (uint64_t(key.normal) * 0x165667B19E3779F9ull);
+    }
+
+    struct CornerKeyHash {
+        size_t operator()(const CornerKey& key) const {
+            uint64_t hash = HashCornerKey(key);
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+    // どの表に入れるか（表の中のバケットに使われる下位のビットとは別の、最上位の16ビットで選ぶ）
+    uint32_t SelectShard(const CornerKey& key, uint32_t shardCount) {
+        return static_cast<uint32_t>(HashCornerKey(key) >> 48) % shardCount;
+    }
+
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    void SkipSpaces(const char*& p, const char* end) {
+        while (p < end && IsSpace(*p)) {
+            ++p;
+        }
+    }
+
+    // 空白で区切られた次の語（無ければ空）
+    std::string_view NextToken(const char*& p, const char* end) {
+        SkipSpaces(p, end);
+        const char* begin = p;
+        while (p < end && !IsSpace(*p)) {
+            ++p;
+        }
+        return std::string_view(begin, static_cast<size_t>(p - begin));
+    }
+
+    // 行の残り（前後の空白を除く）。ファイル名に空白が入っていてもよいように
+    std::string_view RestOfLine(const char* p, const char* end) {
+        SkipSpaces(p, end);
+        while (end > p && IsSpace(end[-1])) {
+            --end;
+        }
+        return std::string_view(p, static_cast<size_t>(end - p));
+    }
+
+    bool ParseFloat(const char*& p, const char* end, float& value) {
+        SkipSpaces(p, end);
+        // from_chars は先頭の '+' を受け付けない
+        if (p < end && *p == '+') {
+            ++p;
+        }
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        p = result.ptr;
+        return true;
+    }
+
+    // OBJ の番号（1 始まり、負なら後ろから）を 0 始まりにする
+    // 負の番号はこのチャンクで読んだ数（count）から数えるので、relative を立てて返す（前のチャンクを指していれば一旦負になる）。
+    // 正の番号は、まだ読んでいないもの（後ろの行）を指していないかを確かめるため、読んだ数より何個先か（ahead）の最大を取っておく。
+    // 範囲の確認は、全チャンクの数がわかってから ResolveChunk で行う
+    bool ParseIndex(std::string_view text, size_t count, uint32_t& index, bool& relative, int64_t& ahead) {
+        int64_t value = 0;
+        std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (result.ec != std::errc() || result.ptr != text.data() + text.size() || value == 0 || value > int64_t(UINT32_MAX) || value < -int64_t(UINT32_MAX)) {
+            return false;
+        }
+        relative = value < 0;
+        if (relative) {
+            index = static_cast<uint32_t>(static_cast<int64_t>(count) + value);
+        } else {
+            index = static_cast<uint32_t>(value - 1);
+            ahead = (std::max)(ahead, value - 1 - static_cast<int64_t>(count));
+        }
+        return true;
+    }
+
+    // 負の番号を使った面の頂点（どの番号かを kRelative* のビットで持つ）
+    struct RelativeCorner {
+        static constexpr uint32_t kRelativePosition = 1u << 0;
+        static constexpr uint32_t kRelativeTexcoord = 1u << 1;
+        static constexpr uint32_t kRelativeNormal = 1u << 2;
+
+        uint32_t corner; // Chunk::corners の番号
+        uint32_t mask;
+    };
+
+    // o / usemtl / mtllib（面との前後関係を保つため、その行より前に積んだインデックスの数を持つ）
+    struct ChunkEvent {
+        enum class Type {
+            kObject,
+            kUseMaterial,
+            kMaterialLibrary,
+        };
+        Type type;
+        uint32_t indexPosition; // チャンクの中での位置
+        std::string name;
+    };
+
+    // ファイルを行の区切りで分けた1つ分。各スレッドはここにだけ書く
+    struct Chunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        bool succeeded = true;
+
+        // ParseChunk: 読んだもの（x の反転などは済ませてある）
+        std::vector<Vector4> positions;
+        std::vector<Vector2> texcoords;
+        std::vector<Vector3> normals;
+        std::vector<CornerKey> corners;   // 面の頂点（ファイルの順）
+        std::vector<uint32_t> faceSizes;  // 面ごとの頂点の数
+        std::vector<RelativeCorner> relativeCorners;
+        std::vector<ChunkEvent> events;
+        uint32_t indexCount = 0;          // 三角形に分けたときのインデックスの数
+
+        // 正の番号が、このチャンクで読んだ数より何個先を指していたか（前のチャンクまでの数以上なら、後ろの行を指している）
+        int64_t positionAhead = INT64_MIN;
+        int64_t texcoordAhead = INT64_MIN;
+        int64_t normalAhead = INT64_MIN;
+
+        // 前のチャンクまでの数（プレフィックス和）
+        uint32_t positionBase = 0;
+        uint32_t texcoordBase = 0;
+        uint32_t normalBase = 0;
+        uint32_t indexBase = 0;
+
+        // ResolveChunk: チャンクの中で重複を除いたもの
+        std::vector<CornerKey> uniqueCorners;   // 初めて出てきた順
+        std::vector<uint32_t> cornerVertices;   // corners ごとの uniqueCorners の番号
+
+        // チャンクをまたいで重複を除いたもの（チャンクが1つなら空で、uniqueCorners をそのまま頂点にする）
+        std::vector<uint64_t> firstOccurrences; // uniqueCorners ごとの、ファイルで初めて出てきた場所（チャンクの番号 << 32 | uniqueCorners の番号）
+        std::vector<uint32_t> uniqueToVertex;   // uniqueCorners ごとの全体の頂点番号
+        uint32_t newVertexCount = 0;            // このチャンクで初めて出てきた組の数
+        uint32_t vertexBase = 0;                // その最初の頂点番号（プレフィックス和）
+    };
+
+    // "v", "v/vt", "v//vn", "v/vt/vn" を読む
+    bool ParseCorner(std::string_view token, Chunk& chunk, CornerKey& key, uint32_t& relativeMask) {
+        key = { CornerKey::kMissing, CornerKey::kMissing, CornerKey::kMissing };
+        relativeMask = 0;
+        bool relative = false;
+
+        size_t firstSlash = token.find('/');
+        if (!ParseIndex(token.substr(0, firstSlash), chunk.positions.size(), key.position, relative, chunk.positionAhead)) {
+            return false;
+        }
+        relativeMask |= relative ? RelativeCorner::kRelativePosition : 0;
+        if (firstSlash == std::string_view::npos) {
+            return true;
+        }
+        std::string_view rest = token.substr(firstSlash + 1);
+        size_t secondSlash = rest.find('/');
+        std::string_view texcoord = rest.substr(0, secondSlash);
+        if (!texcoord.empty()) {
+            if (!ParseIndex(texcoord, chunk.texcoords.size(), key.texcoord, relative, chunk.texcoordAhead)) {
+                return false;
+            }
+            relativeMask |= relative ? RelativeCorner::kRelativeTexcoord : 0;
+        }
+        if (secondSlash == std::string_view::npos) {
+            return true;
+        }
+        if (!ParseIndex(rest.substr(secondSlash + 1), chunk.normals.size(), key.normal, relative, chunk.normalAhead)) {
+            return false;
+        }
+        relativeMask |= relative ? RelativeCorner::kRelativeNormal : 0;
+        return true;
+    }
+
+    // 1行ずつ取り出す（改行とコメントは含まない）
+    bool NextLine(const char*& p, const char* end, const char*& lineBegin, const char*& lineEnd) {
+        if (p >= end) {
+            return false;
+        }
+        lineBegin = p;
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        lineEnd = newline ? newline : end;
+        p = newline ? newline + 1 : end;
+
+        const char* comment = static_cast<const char*>(std::memchr(lineBegin, '#', static_cast<size_t>(lineEnd - lineBegin)));
+        if (comment) {
+            lineEnd = comment;
+        }
+        return true;
+    }
+
+    // o / usemtl の位置（インデックスの数）でメッシュとサブメッシュを区切る
+    class MeshBuilder {
+    public:
+        explicit MeshBuilder(ModelLoader::ModelData& model) : model_(model) {}
+
+        // o: 新しいオブジェクト
+        void BeginMesh(std::string_view name, uint32_t indexPosition) {
+            EnsureMesh(indexPosition);
+            EndSubmesh(indexPosition);
+            model_.meshes.push_back({ std::string(name), {} });
+            BeginSubmesh(indexPosition);
+        }
+
+        // usemtl: 同じオブジェクトの中でマテリアルを切り替える
+        void SetMaterial(uint32_t materialIndex, uint32_t indexPosition) {
+            EnsureMesh(indexPosition);
+            materialIndex_ = materialIndex;
+            if (model_.meshes.empty()) {
+                return;
+            }
+            EndSubmesh(indexPosition);
+            BeginSubmesh(indexPosition);
+        }
+
+        void Finish(uint32_t indexPosition) {
+            EnsureMesh(indexPosition);
+            EndSubmesh(indexPosition);
+            std::erase_if(model_.meshes, [](const ModelLoader::Mesh& mesh) { return mesh.submeshes.empty(); });
+        }
+
+    private:
+        // o より前に面があれば、名前の無いオブジェクトを1つ作ってそこに入れる
+        void EnsureMesh(uint32_t indexPosition) {
+            if (model_.meshes.empty() && indexPosition > 0) {
+                model_.meshes.push_back({ std::string(), {} });
+                BeginSubmesh(0);
+            }
+        }
+
+        void BeginSubmesh(uint32_t indexPosition) {
+            model_.meshes.back().submeshes.push_back({ indexPosition, 0, materialIndex_ });
+        }
+
+        // 今のサブメッシュを閉じる（面が無ければ消す）
+        void EndSubmesh(uint32_t indexPosition) {
+            if (model_.meshes.empty() || model_.meshes.back().submeshes.empty()) {
+                return;
+            }
+            std::vector<ModelLoader::Submesh>& submeshes = model_.meshes.back().submeshes;
+            submeshes.back().indexCount = indexPosition - submeshes.back().indexStart;
+            if (submeshes.back().indexCount == 0) {
+                submeshes.pop_back();
+            }
+        }
+
+        ModelLoader::ModelData& model_;
+        uint32_t materialIndex_ = ModelLoader::kNoMaterial;
+    };
+
+    // チャンク1つ分の行を読む
+    void ParseChunk(Chunk& chunk) {
+        // 1行およそ32文字として、面の頂点の配列をあらかじめ確保しておく
+        size_t estimatedLines = static_cast<size_t>(chunk.end - chunk.begin) / 32;
+        chunk.corners.reserve(estimatedLines);
+        chunk.faceSizes.reserve(estimatedLines / 3);
+
+        const char* p = chunk.begin;
+        const char* lineBegin = nullptr;
+        const char* lineEnd = nullptr;
+        while (NextLine(p, chunk.end, lineBegin, lineEnd)) {
+            const char* cursor = lineBegin;
+            std::string_view keyword = NextToken(cursor, lineEnd);
+
+            if (keyword == "v") {
+                Vector4 position{ 0.0f, 0.0f, 0.0f, 1.0f };
+                if (!ParseFloat(cursor, lineEnd, position.x) || !ParseFloat(cursor, lineEnd, position.y) || !ParseFloat(cursor, lineEnd, position.z)) {
+                    chunk.succeeded = false;
+                    return;
+                }
+                position.x *= -1.0f;
+                chunk.positions.push_back(position);
+            } else if (keyword == "vt") {
+                Vector2 texcoord{};
+                if (!ParseFloat(cursor, lineEnd, texcoord.x) || !ParseFloat(cursor, lineEnd, texcoord.y)) {
+                    chunk.succeeded = false;
+                    return;
+                }
+                texcoord.y = 1.0f - texcoord.y;
+                chunk.texcoords.push_back(texcoord);
+            } else if (keyword == "vn") {
+                Vector3 normal{};
+                if (!ParseFloat(cursor, lineEnd, normal.x) || !ParseFloat(cursor, lineEnd, normal.y) || !ParseFloat(cursor, lineEnd, normal.z)) {
+                    chunk.succeeded = false;
+                    return;
+                }
+                normal.x *= -1.0f;
+                chunk.normals.push_back(normal);
+            } else if (keyword == "f") {
+                uint32_t faceSize = 0;
+                for (std::string_view token = NextToken(cursor, lineEnd); !token.empty(); token = NextToken(cursor, lineEnd)) {
+                    CornerKey key{};
+                    uint32_t relativeMask = 0;
+                    if (!ParseCorner(token, chunk, key, relativeMask)) {
+                        chunk.succeeded = false;
+                        return;
+                    }
+                    if (relativeMask != 0) {
+                        chunk.relativeCorners.push_back({ static_cast<uint32_t>(chunk.corners.size()), relativeMask });
+                    }
+                    chunk.corners.push_back(key);
+                    ++faceSize;
+                }
+                if (faceSize < 3) {
+                    chunk.succeeded = false;
+                    return;
+                }
+                chunk.faceSizes.push_back(faceSize);
+                chunk.indexCount += (faceSize - 2) * 3;
+            } else if (keyword == "o") {
+                chunk.events.push_back({ ChunkEvent::Type::kObject, chunk.indexCount, std::string(RestOfLine(cursor, lineEnd)) });
+            } else if (keyword == "usemtl") {
+                chunk.events.push_back({ ChunkEvent::Type::kUseMaterial, chunk.indexCount, std::string(RestOfLine(cursor, lineEnd)) });
+            } else if (keyword == "mtllib") {
+                chunk.events.push_back({ ChunkEvent::Type::kMaterialLibrary, chunk.indexCount, std::string(RestOfLine(cursor, lineEnd)) });
+            }
+            // g, s などは使わない
+        }
+    }
+
+    // 負の番号を全体の番号に直して範囲を確かめ、チャンクの中で同じ v/vt/vn の組をまとめる
+    void ResolveChunk(Chunk& chunk, size_t positionCount, size_t texcoordCount, size_t normalCount) {
+        // まだ読んでいない行の v/vt/vn は使えない
+        if (chunk.positionAhead >= chunk.positionBase || chunk.texcoordAhead >= chunk.texcoordBase || chunk.normalAhead >= chunk.normalBase) {
+            chunk.succeeded = false;
+            return;
+        }
+
+        for (const RelativeCorner& relativeCorner : chunk.relativeCorners) {
+            CornerKey& key = chunk.corners[relativeCorner.corner];
+            // 前のチャンクを指すものは一旦負（2^32 で折り返した値）になっているので、足せば戻る
+            if (relativeCorner.mask & RelativeCorner::kRelativePosition) {
+                key.position += chunk.positionBase;
+            }
+            if (relativeCorner.mask & RelativeCorner::kRelativeTexcoord) {
+                key.texcoord += chunk.texcoordBase;
+            }
+            if (relativeCorner.mask & RelativeCorner::kRelativeNormal) {
+                key.normal += chunk.normalBase;
+            }
+        }
+
+        std::unordered_map<CornerKey, uint32_t, CornerKeyHash> vertexMap;
+        vertexMap.reserve(chunk.corners.size() / 2);
+        chunk.cornerVertices.resize(chunk.corners.size());
+        for (size_t i = 0; i < chunk.corners.size(); ++i) {
+            const CornerKey& key = chunk.corners[i];
+            if (key.position >= positionCount ||
+                (key.texcoord != CornerKey::kMissing && key.texcoord >= texcoordCount) ||
+                (key.normal != CornerKey::kMissing && key.normal >= normalCount)) {
+                chunk.succeeded = false;
+                return;
+            }
+            auto [found, inserted] = vertexMap.try_emplace(key, static_cast<uint32_t>(chunk.uniqueCorners.size()));
+            if (inserted) {
+                chunk.uniqueCorners.push_back(key);
+            }
+            chunk.cornerVertices[i] = found->second;
+        }
+    }
+
+    // 面を扇形に三角形へ分けて indices に書く（x を反転した分だけ向きを逆にする）
+    void WriteChunkIndices(const Chunk& chunk, uint32_t* indices) {
+        uint32_t* out = indices + chunk.indexBase;
+        size_t corner = 0;
+        for (uint32_t faceSize : chunk.faceSizes) {
+            auto vertexOf = [&](size_t i) {
+                uint32_t unique = chunk.cornerVertices[corner + i];
+                return chunk.uniqueToVertex.empty() ? unique : chunk.uniqueToVertex[unique];
+            };
+            for (uint32_t i = 1; i + 1 < faceSize; ++i) {
+                *out++ = vertexOf(i + 1);
+                *out++ = vertexOf(i);
+                *out++ = vertexOf(0);
+            }
+            corner += faceSize;
+        }
+    }
+
+    // チャンクごとに func を呼ぶ（threadPool があれば並列に）
+    template <typename Func>
+    void ForEachChunk(std::vector<Chunk>& chunks, ThreadPool* threadPool, const Func& func) {
+        if (threadPool && chunks.size() > 1) {
+            threadPool->ParallelFor(static_cast<uint32_t>(chunks.size()), 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    func(chunks[i]);
+                }
+            });
+        } else {
+            for (Chunk& chunk : chunks) {
+                func(chunk);
+            }
+        }
+    }
+
+    // ファイルを行の区切りでおおよそ同じ大きさに分ける
+    std::vector<Chunk> SplitChunks(const char* data, size_t size, ThreadPool* threadPool) {
+        size_t chunkCount = 1;
+        if (threadPool) {
+            size_t threadCount = size_t(threadPool->GetThreadCount()) + 1;
+            chunkCount = std::clamp(size / kMinChunkSize, size_t(1), threadCount * kChunksPerThread);
+        }
+
+        std::vector<Chunk> chunks(chunkCount);
+        const char* end = data + size;
+        const char* begin = data;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            const char* chunkEnd = end;
+            if (i + 1 < chunkCount) {
+                // 目安の位置から次の改行の直後まで進める
+                chunkEnd = (std::max)(begin, data + size * (i + 1) / chunkCount);
+                const char* newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', static_cast<size_t>(end - chunkEnd)));
+                chunkEnd = newline ? newline + 1 : end;
+            }
+            chunks[i].begin = begin;
+            chunks[i].end = chunkEnd;
+            begin = chunkEnd;
+        }
+        return chunks;
+    }
+
+    // usemtl の名前からマテリアルの番号を引く（MTL に無い名前は既定の設定で足す）
+    uint32_t FindMaterial(std::vector<ModelLoader::Material>& materials, std::string_view name) {
+        for (size_t i = 0; i < materials.size(); ++i) {
+            if (materials[i].name == name) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        ModelLoader::Material material;
+        material.name = std::string(name);
+        materials.push_back(std::move(material));
+        return static_cast<uint32_t>(materials.size() - 1);
+    }
+}
+
+bool ModelLoader::Load(const std::filesystem::path& filePath, ModelData& model, ThreadPool* threadPool) {
+    MappedFile file;
+    if (!file.Open(filePath)) {
+        return false;
+    }
+    return Parse(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), filePath.parent_path(), model, threadPool);
+}
+
+bool ModelLoader::ShouldParseInParallel(size_t size, uint32_t workerCount, uint32_t hardwareThreadCount) {
+    // 1チャンクにしかならない大きさでは、チャンクをまたぐ処理や ParallelFor の受け渡しが無駄になる
+    // コアが1つなら、ワーカーがいても順番に動くだけで、切り替えの分だけ遅くなる
+    return size >= 2 * kMinChunkSize && workerCount > 0 && hardwareThreadCount != 1;
+}
+
+bool ModelLoader::Parse(const char* data, size_t size, const std::filesystem::path& directory, ModelData& model, ThreadPool* threadPool) {
+    model = {};
+    if (threadPool && !ShouldParseInParallel(size, threadPool->GetThreadCount(), std::thread::hardware_concurrency())) {
+        threadPool = nullptr;
+    }
+
+    // 1. チャンクごとに並列に読む（各スレッドは自分のチャンクの配列にだけ書く）
+    std::vector<Chunk> chunks = SplitChunks(data, size, threadPool);
+    ForEachChunk(chunks, threadPool, [](Chunk& chunk) { ParseChunk(chunk); });
+
+    // 2. プレフィックス和で、各チャンクの v/vt/vn・インデックスが全体のどこから始まるかを決める
+    size_t positionCount = 0;
+    size_t texcoordCount = 0;
+    size_t normalCount = 0;
+    size_t indexCount = 0;
+    for (Chunk& chunk : chunks) {
+        if (!chunk.succeeded) {
+            return false;
+        }
+        chunk.positionBase = static_cast<uint32_t>(positionCount);
+        chunk.texcoordBase = static_cast<uint32_t>(texcoordCount);
+        chunk.normalBase = static_cast<uint32_t>(normalCount);
+        chunk.indexBase = static_cast<uint32_t>(indexCount);
+        positionCount += chunk.positions.size();
+        texcoordCount += chunk.texcoords.size();
+        normalCount += chunk.normals.size();
+        indexCount += chunk.indexCount;
+    }
+    if (positionCount >= CornerKey::kMissing || indexCount > UINT32_MAX) {
+        return false;
+    }
+
+    // 3. 番号を全体のものに直し、チャンクの中で重複を除く（並列）。v/vt/vn も1つの配列につなげる
+    std::vector<Vector4> positions(positionCount);
+    std::vector<Vector2> texcoords(texcoordCount);
+    std::vector<Vector3> normals(normalCount);
+    ForEachChunk(chunks, threadPool, [&](Chunk& chunk) {
+        std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + chunk.positionBase);
+        std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + chunk.texcoordBase);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + chunk.normalBase);
+        ResolveChunk(chunk, positionCount, texcoordCount, normalCount);
+    });
+    for (const Chunk& chunk : chunks) {
+        if (!chunk.succeeded) {
+            return false;
+        }
+    }
+
+    // 4. チャンクをまたいで重複を除く（頂点の並びは、1つずつ読んだときと同じ「初めて出てきた順」になる）
+    std::vector<CornerKey> vertexKeys;
+    if (chunks.size() == 1) {
+        vertexKeys = std::move(chunks[0].uniqueCorners);
+    } else {
+        // 4-1. 組をハッシュで表に振り分け、表ごとに並列にファイルの順でたどって、それぞれの組が初めて出てきた場所を決める
+        uint32_t shardCount = (threadPool->GetThreadCount() + 1) * kShardsPerThread;
+        ForEachChunk(chunks, threadPool, [](Chunk& chunk) { chunk.firstOccurrences.resize(chunk.uniqueCorners.size()); });
+        threadPool->ParallelFor(shardCount, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t shard = begin; shard < end; ++shard) {
+                std::unordered_map<CornerKey, uint64_t, CornerKeyHash> vertexMap;
+                for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+                    Chunk& chunk = chunks[chunkIndex];
+                    for (size_t i = 0; i < chunk.uniqueCorners.size(); ++i) {
+                        const CornerKey& key = chunk.uniqueCorners[i];
+                        if (SelectShard(key, shardCount) != shard) {
+                            continue;
+                        }
+                        auto found = vertexMap.try_emplace(key, (uint64_t(chunkIndex) << 32) | i).first;
+                        chunk.firstOccurrences[i] = found->second;
+                    }
+                }
+            }
+        });
+
+        // 4-2. 初めて出てきた組に、ファイルの順で頂点番号を振る（チャンクごとの数のプレフィックス和）
+        ForEachChunk(chunks, threadPool, [&](Chunk& chunk) {
+            uint64_t chunkIndex = static_cast<uint64_t>(&chunk - chunks.data());
+            for (size_t i = 0; i < chunk.firstOccurrences.size(); ++i) {
+                chunk.newVertexCount += chunk.firstOccurrences[i] == ((chunkIndex << 32) | i) ? 1 : 0;
+            }
+        });
+        uint32_t vertexCount = 0;
+        for (Chunk& chunk : chunks) {
+            chunk.vertexBase = vertexCount;
+            vertexCount += chunk.newVertexCount;
+        }
+        vertexKeys.resize(vertexCount);
+        ForEachChunk(chunks, threadPool, [&](Chunk& chunk) {
+            uint64_t chunkIndex = static_cast<uint64_t>(&chunk - chunks.data());
+            uint32_t vertex = chunk.vertexBase;
+            chunk.uniqueToVertex.resize(chunk.uniqueCorners.size());
+            for (size_t i = 0; i < chunk.firstOccurrences.size(); ++i) {
+                if (chunk.firstOccurrences[i] == ((chunkIndex << 32) | i)) {
+                    vertexKeys[vertex] = chunk.uniqueCorners[i];
+                    chunk.uniqueToVertex[i] = vertex++;
+                }
+            }
+        });
+
+        // 4-3. 前のチャンクで出てきた組は、そこで振った番号を使う
+        ForEachChunk(chunks, threadPool, [&](Chunk& chunk) {
+            uint64_t chunkIndex = static_cast<uint64_t>(&chunk - chunks.data());
+            for (size_t i = 0; i < chunk.firstOccurrences.size(); ++i) {
+                uint64_t firstOccurrence = chunk.firstOccurrences[i];
+                if ((firstOccurrence >> 32) != chunkIndex) {
+                    chunk.uniqueToVertex[i] = chunks[firstOccurrence >> 32].uniqueToVertex[firstOccurrence & UINT32_MAX];
+                }
+            }
+        });
+    }
+
+    // 5. 頂点とインデックスを書く（並列。書く場所はプレフィックス和で決まっている）
+    model.vertices.resize(vertexKeys.size());
+    model.indices.resize(indexCount);
+    auto writeVertices = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const CornerKey& key = vertexKeys[i];
+            Vertex& vertex = model.vertices[i];
+            vertex.position = positions[key.position];
+            vertex.texcoord = key.texcoord != CornerKey::kMissing ? texcoords[key.texcoord] : Vector2{};
+            vertex.normal = key.normal != CornerKey::kMissing ? normals[key.normal] : Vector3{};
+        }
+    };
+    uint32_t vertexCount = static_cast<uint32_t>(vertexKeys.size());
+    if (threadPool) {
+        threadPool->ParallelFor(vertexCount, kVertexGrainSize, writeVertices);
+    } else {
+        writeVertices(0, vertexCount);
+    }
+    ForEachChunk(chunks, threadPool, [&](Chunk& chunk) { WriteChunkIndices(chunk, model.indices.data()); });
+
+    // 6. o / usemtl / mtllib をファイルの順に当てはめる
+    MeshBuilder meshBuilder(model);
+    for (const Chunk& chunk : chunks) {
+        for (const ChunkEvent& event : chunk.events) {
+            uint32_t indexPosition = chunk.indexBase + event.indexPosition;
+            switch (event.type) {
+            case ChunkEvent::Type::kObject:
+                meshBuilder.BeginMesh(event.name, indexPosition);
+                break;
+            case ChunkEvent::Type::kUseMaterial:
+                meshBuilder.SetMaterial(FindMaterial(model.materials, event.name), indexPosition);
+                break;
+            case ChunkEvent::Type::kMaterialLibrary: {
+                // 読めなくても形は使えるので、マテリアル無しで続ける
+                MappedFile materialFile;
+                if (materialFile.Open(directory / std::filesystem::path(event.name))) {
+                    ParseMaterials(reinterpret_cast<const char*>(materialFile.GetData()), materialFile.GetSize(), directory, model.materials);
+                }
+                break;
+            }
+            }
+        }
+    }
+    meshBuilder.Finish(static_cast<uint32_t>(indexCount));
+    return true;
+}
+
+bool ModelLoader::ParseMaterials(const char* data, size_t size, const std::filesystem::path& directory, std::vector<Material>& materials) {
+    Material* material = nullptr;
+
+    const char* p = data;
+    const char* end = data + size;
+    const char* lineBegin = nullptr;
+    const char* lineEnd = nullptr;
+    while (NextLine(p, end, lineBegin, lineEnd)) {
+        const char* cursor = lineBegin;
+        std::string_view keyword = NextToken(cursor, lineEnd);
+
+        if (keyword == "newmtl") {
+            materials.push_back({});
+            material = &materials.back();
+            material->name = std::string(RestOfLine(cursor, lineEnd));
+        } else if (!material) {
+            // newmtl より前の行は読まない
+        } else if (keyword == "Kd") {
+            if (!ParseFloat(cursor, lineEnd, material->color.x) || !ParseFloat(cursor, lineEnd, material->color.y) || !ParseFloat(cursor, lineEnd, material->color.z)) {
+                return false;
+            }
+        } else if (keyword == "d") {
+            if (!ParseFloat(cursor, lineEnd, material->color.w)) {
+                return false;
+            }
+        } else if (keyword == "map_Kd") {
+            // "-s 1 1 1" などのオプションは読み飛ばし、最後の語をファイル名とする
+            std::string_view fileName;
+            for (std::string_view token = NextToken(cursor, lineEnd); !token.empty(); token = NextToken(cursor, lineEnd)) {
+                fileName = token;
+            }
+            material->textureFilePath = (directory / std::filesystem::path(std::string(fileName))).string();
+        }
+    }
+    return true;
+}
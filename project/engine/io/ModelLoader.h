@@ -0,0 +1,69 @@
+#pragma once
+#include "Struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// OBJ / MTL の読み込み（D3D12には依存しない）
+// ファイルはメモリにマップしてそのまま読み、数値は std::from_chars で変換する（ロケールに左右されず、行や数値の文字列のコピーも作らない）
+// 同じ v/vt/vn の組は1つの頂点にまとめ、インデックス付きの頂点配列にする。
+// 座標は右手系（Blender の出力）から左手系に直す：x を反転し、三角形の向きを逆にし、v を上下反転する
+// threadPool を渡すと、大きなファイルは行の区切りでチャンクに分けて並列に読む（結果はスレッド数によらず同じ）
+namespace ModelLoader {
+
+    // マテリアルが無い（usemtl より前の面など）
+    constexpr uint32_t kNoMaterial = UINT32_MAX;
+
+    // 頂点（Object3D.VS の VertexShaderInput と同じ並び）
+    struct Vertex {
+        Vector4 position;
+        Vector2 texcoord;
+        Vector3 normal;
+    };
+
+    // MTL の newmtl 1つ分
+    struct Material {
+        std::string name;
+        Vector4 color = { 1.0f, 1.0f, 1.0f, 1.0f }; // Kd と d
+        std::string textureFilePath;                 // map_Kd（MTL のあるフォルダをつなげたパス。無ければ空）
+    };
+
+    // 同じマテリアルで描く範囲（usemtl ごと）
+    struct Submesh {
+        uint32_t indexStart = 0;
+        uint32_t indexCount = 0;
+        uint32_t materialIndex = kNoMaterial; // ModelData::materials の番号
+    };
+
+    // オブジェクト（o ごと）
+    struct Mesh {
+        std::string name;
+        std::vector<Submesh> submeshes;
+    };
+
+    struct ModelData {
+        std::vector<Vertex> vertices;  // 全メッシュ共通
+        std::vector<uint32_t> indices; // 三角形リスト（多角形は扇形に分ける）
+        std::vector<Mesh> meshes;      // 面の無いオブジェクトは含まない
+        std::vector<Material> materials;
+    };
+
+    // OBJ ファイルを読む（mtllib は OBJ と同じフォルダから探す）。読めない・壊れていれば false
+    bool Load(const std::filesystem::path& filePath, ModelData& model, ThreadPool* threadPool = nullptr);
+
+    // メモリ上の OBJ を読む（mtllib は directory から探す）
+    // threadPool を渡しても、ShouldParseInParallel が false なら1つずつ読む
+    bool Parse(const char* data, size_t size, const std::filesystem::path& directory, ModelData& model, ThreadPool* threadPool = nullptr);
+
+    // 並列に読むと速くなるか（チャンクが2つ以上に分かれる大きさで、ワーカーがいて、コアが2つ以上あるとき）
+    // hardwareThreadCount は std::thread::hardware_concurrency() の値（0 は不明として扱う）
+    bool ShouldParseInParallel(size_t size, uint32_t workerCount, uint32_t hardwareThreadCount);
+
+    // メモリ上の MTL を読み、materials の後ろに足す（map_Kd には directory をつなげる）
+    bool ParseMaterials(const char* data, size_t size, const std::filesystem::path& directory, std::vector<Material>& materials);
+
+}
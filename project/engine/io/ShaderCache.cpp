@@ -0,0 +1,177 @@
+#include "ShaderCache.h"
+#include "Hash.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+    // キャッシュの中身の形式を変えたら上げる（古いキャッシュは使われなくなる）
+    constexpr uint64_t kFormatVersion = 1;
+
+    uint64_t HashBytes(const void* data, size_t size, uint64_t hash) {
+        return Hash::XXH64(data, size, hash);
+    }
+
+    // コメント（// と /* */）を空白に置き換えた source（改行はそのまま）
+    // コメントアウトした #include をたどらないため。文字列の中の // はコメントにしない
+    std::string StripComments(std::string_view source) {
+        std::string result(source);
+        enum class State { kCode, kString, kLineComment, kBlockComment };
+        State state = State::kCode;
+        for (size_t i = 0; i < result.size(); ++i) {
+            char c = result[i];
+            char next = i + 1 < result.size() ? result[i + 1] : '\0';
+            switch (state) {
+            case State::kCode:
+                if (c == '"') {
+                    state = State::kString;
+                } else if (c == '/' && next == '/') {
+                    state = State::kLineComment;
+                    result[i] = ' ';
+                } else if (c == '/' && next == '*') {
+                    state = State::kBlockComment;
+                    result[i] = ' ';
+                    result[++i] = ' ';
+                }
+                break;
+            case State::kString:
+                if (c == '"' || c == '\n') {
+                    state = State::kCode;
+                }
+                break;
+            case State::kLineComment:
+                if (c == '\n') {
+                    state = State::kCode;
+                } else {
+                    result[i] = ' ';
+                }
+                break;
+            case State::kBlockComment:
+                if (c == '*' && next == '/') {
+                    result[i] = ' ';
+                    result[++i] = ' ';
+                    state = State::kCode;
+                } else if (c != '\n') {
+                    result[i] = ' ';
+                }
+                break;
+            }
+        }
+        return result;
+    }
+
+    // filePath の中身と、そこから #include でたどれるファイルの中身を hash に混ぜる
+    // visited は同じファイルを二度たどらないため（#pragma once の循環も止まる）
+    bool HashSourceTree(const std::filesystem::path& filePath, uint64_t& hash, std::vector<std::filesystem::path>& visited) {
+        std::filesystem::path normalizedPath = filePath.lexically_normal();
+        for (const std::filesystem::path& path : visited) {
+            if (path == normalizedPath) {
+                return true;
+            }
+        }
+        visited.push_back(normalizedPath);
+
+        // 無いファイルは「無い」ことをキーに含める（後から作られたら別のキーになる）
+        std::string pathString = normalizedPath.generic_string();
+        hash = HashBytes(pathString.data(), pathString.size(), hash);
+        std::error_code error;
+        if (!std::filesystem::exists(normalizedPath, error)) {
+            hash = HashBytes("missing", 7, hash);
+            return false;
+        }
+        MappedFile file;
+        if (!file.Open(normalizedPath)) {
+            // 空のファイルはマップできないが、中身が無いだけなので続ける
+            hash = HashBytes("empty", 5, hash);
+            return true;
+        }
+        hash = HashBytes(file.GetData(), file.GetSize(), hash);
+
+        // #include "name" / #include <name> を探す（コメントの中のものは除く）
+        // エンジンは DXC に -I を渡していないので、<name> も "name" と同じくこのファイルのあるフォルダから探す
+        std::string strippedSource = StripComments(std::string_view(reinterpret_cast<const char*>(file.GetData()), file.GetSize()));
+        std::string_view source(strippedSource);
+        size_t position = 0;
+        while ((position = source.find("#include", position)) != std::string_view::npos) {
+            position += 8;
+            size_t open = source.find_first_of("\"<\n", position);
+            if (open == std::string_view::npos || source[open] == '\n') {
+                continue;
+            }
+            char closeChar = source[open] == '"' ? '"' : '>';
+            size_t close = source.find_first_of(std::string_view(&closeChar, 1), open + 1);
+            if (close == std::string_view::npos) {
+                break;
+            }
+            std::string_view includeName = source.substr(open + 1, close - open - 1);
+            HashSourceTree(normalizedPath.parent_path() / std::filesystem::path(includeName), hash, visited);
+            position = close + 1;
+        }
+        return true;
+    }
+}
+
+void ShaderCache::Initialize(const std::filesystem::path& directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    // 作れなかったらキャッシュを使わない（毎回コンパイルするだけ）
+    directory_ = error ? std::filesystem::path() : directory;
+}
+
+uint64_t ShaderCache::ComputeKey(const std::filesystem::path& sourcePath, const std::vector<std::wstring>& arguments) {
+    uint64_t hash = kFormatVersion;
+    std::vector<std::filesystem::path> visited;
+    if (!HashSourceTree(sourcePath, hash, visited)) {
+        return kInvalidKey;
+    }
+    for (const std::wstring& argument : arguments) {
+        // 引数の区切りも混ぜる（"-O" "3" と "-O3" を区別する）
+        hash = HashBytes(argument.data(), argument.size() * sizeof(wchar_t), hash);
+        hash = HashBytes("\0", 1, hash);
+    }
+    // 0 は「取れなかった」の印なので避ける
+    return hash == kInvalidKey ? 1 : hash;
+}
+
+bool ShaderCache::Load(uint64_t key, MappedFile& bytecode) {
+    if (IsEnabled() && key != kInvalidKey && bytecode.Open(GetPath(key))) {
+        ++hitCount_;
+        return true;
+    }
+    ++missCount_;
+    return false;
+}
+
+bool ShaderCache::Store(uint64_t key, const void* bytecode, size_t size) const {
+    if (!IsEnabled() || key == kInvalidKey) {
+        return false;
+    }
+
+    // 書きかけのファイルを他のスレッドや次回の起動で読まないよう、一時ファイルに書いてから名前を変える
+    std::filesystem::path path = GetPath(key);
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += L"." + std::to_wstring(std::hash<std::thread::id>()(std::this_thread::get_id())) + L".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        if (!file.write(static_cast<const char*>(bytecode), static_cast<std::streamsize>(size))) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+std::filesystem::path ShaderCache::GetPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.dxil", static_cast<unsigned long long>(key));
+    return directory_ / name;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "MappedFile.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// コンパイル済みシェーダー（DXIL）をディスクに残しておくキャッシュ
+// キーはソース・#include でたどれるファイルすべての中身と、コンパイラに渡す引数（エントリポイント・プロファイル・最適化など）のハッシュ。
+// .hlsli を書き換えても、引数を変えても別のキーになるので、古いものが使われることはない。
+// DXC・D3D12には依存しない。同じキャッシュを複数のスレッドから使ってよい
+class ShaderCache {
+public:
+    // キーにするハッシュ値（0 は「ハッシュを取れなかった」の意味）
+    static constexpr uint64_t kInvalidKey = 0;
+
+    // ヒット・ミスの数
+    struct Stats {
+        uint32_t hitCount = 0;
+        uint32_t missCount = 0;
+    };
+
+    // キャッシュの置き場所（無ければ作る）
+    void Initialize(const std::filesystem::path& directory);
+
+    // ソースと引数からキーを作る。ソースが読めなければ kInvalidKey
+    // #include はインクルード元のファイルのあるフォルダから再帰的にたどる（#if の中のものも含めるので、余計に作り直すことはあっても逆はない）
+    // #include <...> も同じフォルダから探す（-I を使っていないため）。コメントの中の #include はたどらない
+    static uint64_t ComputeKey(const std::filesystem::path& sourcePath, const std::vector<std::wstring>& arguments);
+
+    // キャッシュ済みの DXIL をマップする（無ければ false。ミスとして数える）
+    bool Load(uint64_t key, MappedFile& bytecode);
+
+    // コンパイルした DXIL を保存する
+    bool Store(uint64_t key, const void* bytecode, size_t size) const;
+
+    bool IsEnabled() const { return !directory_.empty(); }
+    Stats GetStats() const { return { hitCount_.load(), missCount_.load() }; }
+
+private:
+    std::filesystem::path GetPath(uint64_t key) const;
+
+    std::filesystem::path directory_;
+    std::atomic<uint32_t> hitCount_ = 0;
+    std::atomic<uint32_t> missCount_ = 0;
+};
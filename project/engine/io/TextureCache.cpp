@@ -0,0 +1,71 @@
+#include "TextureCache.h"
+#include "Hash.h"
+#include "TextureDecoder.h"
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+void TextureCache::Initialize(const std::filesystem::path& directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    // 作れなかったらキャッシュを使わない（毎回デコードするだけ）
+    directory_ = error ? std::filesystem::path() : directory;
+}
+
+uint64_t TextureCache::HashFile(const std::wstring& filePath) {
+    MappedFile mappedFile;
+    if (!mappedFile.Open(filePath)) {
+        return kInvalidKey;
+    }
+    // デコードの設定が変わったら、同じファイルでも別のキーになるようにする
+    uint64_t key = Hash::XXH64(mappedFile.GetData(), mappedFile.GetSize(), TextureDecoder::kSettingsVersion);
+    // 0 は「取れなかった」の印なので避ける
+    return key == kInvalidKey ? 1 : key;
+}
+
+bool TextureCache::Open(uint64_t key, MappedFile& mappedFile, DdsLayout& ddsLayout) const {
+    if (!IsEnabled() || key == kInvalidKey) {
+        return false;
+    }
+    if (!mappedFile.Open(GetPath(key))) {
+        return false;
+    }
+    if (!ddsLayout.Parse(mappedFile.GetData(), mappedFile.GetSize())) {
+        mappedFile.Close();
+        return false;
+    }
+    return true;
+}
+
+HRESULT TextureCache::Store(uint64_t key, const DirectX::ScratchImage& mipImages) const {
+    if (!IsEnabled() || key == kInvalidKey) {
+        return E_FAIL;
+    }
+
+    // 書きかけのファイルを他のスレッドや次回の起動で読まないよう、一時ファイルに書いてから名前を変える
+    std::filesystem::path path = GetPath(key);
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += L"." + std::to_wstring(std::hash<std::thread::id>()(std::this_thread::get_id())) + L".tmp";
+
+    // DX10 拡張ヘッダーを付けておくと、DdsLayout が変換なしで扱える
+    HRESULT hr = DirectX::SaveToDDSFile(
+        mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+        DirectX::DDS_FLAGS_FORCE_DX10_EXT, temporaryPath.wstring().c_str());
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return E_FAIL;
+    }
+    return S_OK;
+}
+
+std::filesystem::path TextureCache::GetPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.dds", static_cast<unsigned long long>(key));
+    return directory_ / name;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "DdsLayout.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+// デコード・ミップマップ生成済みの画像をディスクに残しておくキャッシュ
+// キーは元ファイルの中身のハッシュ（デコード設定のバージョンを混ぜる）なので、パスが違っても中身が同じなら同じキーになる。
+// 中身は DX10 拡張ヘッダー付きの DDS で保存し、次回の起動ではマップしてそのまま転送する（WIC もミップマップ生成も通らない）
+// D3D12には依存しない。同じキャッシュを複数のスレッドから使ってよい
+class TextureCache {
+public:
+    // キーにするハッシュ値（0 は「ハッシュを取れなかった」の意味）
+    static constexpr uint64_t kInvalidKey = 0;
+
+    // キャッシュの置き場所（無ければ作る）
+    void Initialize(const std::filesystem::path& directory);
+
+    // ファイルの中身からキーを作る。読めなければ kInvalidKey
+    static uint64_t HashFile(const std::wstring& filePath);
+
+    // キャッシュ済みの DDS を開く（無い・壊れているなら false）
+    bool Open(uint64_t key, MappedFile& mappedFile, DdsLayout& ddsLayout) const;
+
+    // デコード済みの画像を保存する
+    HRESULT Store(uint64_t key, const DirectX::ScratchImage& mipImages) const;
+
+    bool IsEnabled() const { return !directory_.empty(); }
+
+private:
+    std::filesystem::path GetPath(uint64_t key) const;
+
+    std::filesystem::path directory_;
+};
@@ -0,0 +1,95 @@
+#include "TextureDecoder.h"
+#include "DdsLayout.h"
+#include <cwctype>
+#include <filesystem>
+
+namespace {
+    // 拡張子を小文字で取り出す（".png" など）
+    std::wstring GetExtension(const std::wstring& filePath) {
+        size_t dot = filePath.find_last_of(L'.');
+        if (dot == std::wstring::npos) {
+            return std::wstring();
+        }
+        std::wstring extension = filePath.substr(dot);
+        for (wchar_t& c : extension) {
+            c = static_cast<wchar_t>(std::towlower(c));
+        }
+        return extension;
+    }
+}
+
+HRESULT TextureDecoder::Load(const std::wstring& filePath, DirectX::ScratchImage& image) {
+    std::wstring extension = GetExtension(filePath);
+    HRESULT hr;
+    if (extension == L".dds") {
+        hr = DirectX::LoadFromDDSFile(filePath.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+    } else if (extension == L".tga") {
+        hr = DirectX::LoadFromTGAFile(filePath.c_str(), DirectX::TGA_FLAGS_NONE, nullptr, image);
+    } else if (extension == L".hdr") {
+        hr = DirectX::LoadFromHDRFile(filePath.c_str(), nullptr, image);
+    } else {
+#ifdef _WIN32
+        // png, jpg など
+        hr = DirectX::LoadFromWICFile(filePath.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+#else
+        hr = E_NOTIMPL;
+#endif
+    }
+    return hr;
+}
+
+HRESULT TextureDecoder::Decode(const std::wstring& filePath, DirectX::ScratchImage& mipImages) {
+    // 1. 拡張子に合わせて読み込む
+    DirectX::ScratchImage image{};
+    HRESULT hr = Load(filePath, image);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // 2. ミップマップの生成
+    return GenerateMipMaps(image, mipImages);
+}
+
+HRESULT TextureDecoder::GenerateMipMaps(DirectX::ScratchImage& image, DirectX::ScratchImage& mipImages) {
+    // すでにあるもの・圧縮済みのものは作れないのでそのまま使う
+    const DirectX::TexMetadata& metadata = image.GetMetadata();
+    if (metadata.mipLevels > 1 || DirectX::IsCompressed(metadata.format)) {
+        mipImages = std::move(image);
+        return S_OK;
+    }
+
+    // sRGB のものはガンマを考慮して縮小する
+    DirectX::TEX_FILTER_FLAGS filter = DirectX::IsSRGB(metadata.format) ? DirectX::TEX_FILTER_SRGB : DirectX::TEX_FILTER_DEFAULT;
+    return DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), metadata, filter, 0, mipImages);
+}
+
+bool TextureDecoder::IsDdsPath(const std::wstring& filePath) {
+    return GetExtension(filePath) == L".dds";
+}
+
+std::wstring TextureDecoder::ResolveCookedPath(const std::wstring& filePath) {
+    if (IsDdsPath(filePath)) {
+        return filePath;
+    }
+    std::filesystem::path cookedPath(filePath);
+    cookedPath.replace_extension(L".dds");
+
+    // 元の画像を更新したのにクックし忘れている場合は、古い DDS を使わない
+    std::error_code error;
+    std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedPath, error);
+    if (error) {
+        return filePath;
+    }
+    std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(filePath, error);
+    if (!error && sourceTime > cookedTime) {
+        return filePath;
+    }
+
+    // 古いクッカーで作った、幅・高さが 4 の倍数でないブロック圧縮の DDS は GPU に作れないので元の画像を読む
+    DirectX::TexMetadata metadata{};
+    if (FAILED(DirectX::GetMetadataFromDDSFile(cookedPath.wstring().c_str(), DirectX::DDS_FLAGS_NONE, metadata))
+        || !DdsLayout::HasValidBlockSize(metadata)) {
+        return filePath;
+    }
+    return cookedPath.wstring();
+}
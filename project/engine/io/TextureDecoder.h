@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+// 画像ファイルのデコードとミップマップ生成（D3D12には依存しない）
+// DDS / TGA / HDR は DirectXTex の移植可能なコーデックで読むので、Windows 以外でも動く。
+// それ以外（png, jpg など）は WIC を使うため Windows のみ
+namespace TextureDecoder {
+
+    // Decode の結果が変わる変更（sRGB の扱い・ミップマップのフィルタなど）をしたら上げる
+    // TextureCache のキーに混ぜてあるので、上げると古いキャッシュは使われなくなる
+    constexpr uint64_t kSettingsVersion = 1;
+
+    // 拡張子を見て読み込む（ミップマップは作らない）
+    HRESULT Load(const std::wstring& filePath, DirectX::ScratchImage& image);
+
+    // 拡張子を見て読み込み、ミップマップ付きの画像を mipImages に入れる
+    // （DDS でミップマップを持っているもの・圧縮形式のものはそのまま返す）
+    HRESULT Decode(const std::wstring& filePath, DirectX::ScratchImage& mipImages);
+
+    // Load した画像からミップマップを作る（Decode の後半。すでにあるもの・圧縮形式のものは image をそのまま移す）
+    HRESULT GenerateMipMaps(DirectX::ScratchImage& image, DirectX::ScratchImage& mipImages);
+
+    // 拡張子が .dds か
+    bool IsDdsPath(const std::wstring& filePath);
+
+    // クック済みの DDS（同じ名前で拡張子が .dds のもの）が元の画像より新しければそのパスを、なければ filePath を返す
+    // D3D12 で作れない大きさの DDS（DdsLayout::HasValidBlockSize）も使わない
+    // クック済みのものはミップマップ付き・ブロック圧縮済みなので、Decode はそのまま読み込むだけになる
+    std::wstring ResolveCookedPath(const std::wstring& filePath);
+
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include "Struct.h"
+#include "Matrix.h"
+#include <cmath>
+#include <type_traits>
+
+// コンパイル時にも計算できる数学関数（ヘッダーのみ）
+// 定数の行列（画面サイズ固定の正射影行列など）は constexpr 変数にしておけばビルド時に計算される。
+// 実行時に呼ばれた場合もインライン展開される
+namespace MathConstexpr {
+
+	// ===== 内部用 =====
+	namespace Detail {
+		// 平方根（コンパイル時はニュートン法、実行時は std::sqrt）
+		constexpr float Sqrt(float x) {
+			if (!std::is_constant_evaluated()) {
+				return std::sqrt(x);
+			}
+			if (x <= 0.0f) {
+				return 0.0f;
+			}
+			double guess = x >= 1.0f ? double(x) : 1.0;
+			for (int i = 0; i < 64; ++i) {
+				double next = 0.5 * (guess + double(x) / guess);
+				if (next == guess) {
+					break;
+				}
+				guess = next;
+			}
+			return float(guess);
+		}
+
+		// 正接（コンパイル時は sin / cos のテイラー展開、実行時は std::tan）
+		// 視野角の半分（-π/2 ～ π/2）程度の範囲を想定
+		constexpr float Tan(float x) {
+			if (!std::is_constant_evaluated()) {
+				return std::tan(x);
+			}
+			double x2 = double(x) * double(x);
+			double sinTerm = x, sinSum = x;
+			double cosTerm = 1.0, cosSum = 1.0;
+			for (int n = 1; n < 16; ++n) {
+				sinTerm *= -x2 / ((2.0 * n) * (2.0 * n + 1.0));
+				cosTerm *= -x2 / ((2.0 * n - 1.0) * (2.0 * n));
+				sinSum += sinTerm;
+				cosSum += cosTerm;
+			}
+			return float(sinSum / cosSum);
+		}
+	}
+
+	// ===== Vector3 =====
+	constexpr Vector3 Add(const Vector3& a, const Vector3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+	constexpr Vector3 Subtract(const Vector3& a, const Vector3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+	constexpr Vector3 Multiply(float s, const Vector3& v) { return { s * v.x, s * v.y, s * v.z }; }
+	constexpr float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	constexpr Vector3 Cross(const Vector3& a, const Vector3& b) {
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+	constexpr float Length(const Vector3& v) { return Detail::Sqrt(Dot(v, v)); }
+	constexpr Vector3 Normalize(const Vector3& v) {
+		float length = Length(v);
+		return length == 0.0f ? Vector3{ 0.0f, 0.0f, 0.0f } : Vector3{ v.x / length, v.y / length, v.z / length };
+	}
+	constexpr Vector3 Lerp(const Vector3& a, const Vector3& b, float t) {
+		return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t };
+	}
+
+	// ===== Vector2 / Vector4 =====
+	constexpr float Dot(const Vector2& a, const Vector2& b) { return a.x * b.x + a.y * b.y; }
+	constexpr float Length(const Vector2& v) { return Detail::Sqrt(Dot(v, v)); }
+	constexpr Vector2 Lerp(const Vector2& a, const Vector2& b, float t) {
+		return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+	}
+	constexpr float Dot(const Vector4& a, const Vector4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+	constexpr Vector4 Lerp(const Vector4& a, const Vector4& b, float t) {
+		return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+	}
+
+	// ===== Matrix4x4 =====
+	constexpr Matrix4x4 MakeIdentity4x4() {
+		return { {
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f, 0.0f },
+			{ 0.0f, 0.0f, 0.0f, 1.0f },
+		} };
+	}
+
+	constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+			}
+		}
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+		Matrix4x4 result = MakeIdentity4x4();
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		return result;
+	}
+
+	constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+		Matrix4x4 result = MakeIdentity4x4();
+		result.m[0][0] = scale.x;
+		result.m[1][1] = scale.y;
+		result.m[2][2] = scale.z;
+		return result;
+	}
+
+	// 正射影行列（MatrixMath::MakeOrthographicMatrix と同じ式）
+	constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip) {
+		Matrix4x4 result{};
+		result.m[0][0] = 2.0f / (right - left);
+		result.m[1][1] = 2.0f / (top - bottom);
+		result.m[2][2] = 1.0f / (farClip - nearClip);
+		result.m[3][0] = (left + right) / (left - right);
+		result.m[3][1] = (top + bottom) / (bottom - top);
+		result.m[3][2] = nearClip / (nearClip - farClip);
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	// 透視投影行列（MatrixMath::MakePerspectiveFovMatrix と同じ式）
+	constexpr Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+		float cot = 1.0f / Detail::Tan(fovY / 2.0f);
+		Matrix4x4 result{};
+		result.m[0][0] = 1.0f / aspectRatio * cot;
+		result.m[1][1] = cot;
+		result.m[2][2] = farClip / (farClip - nearClip);
+		result.m[2][3] = 1.0f;
+		result.m[3][2] = (-nearClip * farClip) / (farClip - nearClip);
+		return result;
+	}
+
+	// 座標変換（w で割る）
+	constexpr Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+		float x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0];
+		float y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1];
+		float z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2];
+		float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3];
+		return { x / w, y / w, z / w };
+	}
+
+	// ===== コンパイル時の確認 =====
+	namespace Detail {
+		constexpr bool NearlyEqual(float a, float b, float epsilon = 1.0e-5f) {
+			return (a > b ? a - b : b - a) <= epsilon;
+		}
+
+		static_assert(Dot(Vector3{ 1.0f, 2.0f, 3.0f }, Vector3{ 4.0f, 5.0f, 6.0f }) == 32.0f);
+		static_assert(Cross(Vector3{ 1.0f, 0.0f, 0.0f }, Vector3{ 0.0f, 1.0f, 0.0f }).z == 1.0f);
+		static_assert(Length(Vector3{ 3.0f, 4.0f, 0.0f }) == 5.0f);
+		static_assert(Lerp(Vector2{ 0.0f, 10.0f }, Vector2{ 10.0f, 20.0f }, 0.5f).y == 15.0f);
+		static_assert(NearlyEqual(Tan(0.78539816f), 1.0f));
+		static_assert(Multiply(MakeIdentity4x4(), MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f })).m[3][1] == 2.0f);
+
+		// 1280x720 の正射影：左上 (0,0) が (-1,1)、右下 (1280,720) が (1,-1) に移る
+		constexpr Matrix4x4 kScreenOrtho = MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f);
+		static_assert(NearlyEqual(Transform({ 0.0f, 0.0f, 0.0f }, kScreenOrtho).x, -1.0f));
+		static_assert(NearlyEqual(Transform({ 0.0f, 0.0f, 0.0f }, kScreenOrtho).y, 1.0f));
+		static_assert(NearlyEqual(Transform({ 1280.0f, 720.0f, 0.0f }, kScreenOrtho).x, 1.0f));
+		static_assert(NearlyEqual(Transform({ 1280.0f, 720.0f, 0.0f }, kScreenOrtho).y, -1.0f));
+	}
+}
+
+// ===== 演算子 =====
+constexpr Vector3 operator+(const Vector3& a, const Vector3& b) { return MathConstexpr::Add(a, b); }
+constexpr Vector3 operator-(const Vector3& a, const Vector3& b) { return MathConstexpr::Subtract(a, b); }
+constexpr Vector3 operator*(float s, const Vector3& v) { return MathConstexpr::Multiply(s, v); }
+constexpr Vector3 operator*(const Vector3& v, float s) { return MathConstexpr::Multiply(s, v); }
+constexpr Vector2 operator-(const Vector2& a, const Vector2& b) { return { a.x - b.x, a.y - b.y }; }
+constexpr Vector2 operator*(float s, const Vector2& v) { return { s * v.x, s * v.y }; }
+constexpr Vector2 operator*(const Vector2& v, float s) { return { s * v.x, s * v.y }; }
+constexpr Vector4 operator+(const Vector4& a, const Vector4& b) { return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; }
+constexpr Vector4 operator-(const Vector4& a, const Vector4& b) { return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; }
+constexpr Vector4 operator*(float s, const Vector4& v) { return { s * v.x, s * v.y, s * v.z, s * v.w }; }
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) { return MathConstexpr::Multiply(m1, m2); }
@@ -107,8 +107,8 @@ Matrix4x4 MatrixMath::MakeTranslateMatrix(const Vector3& translate) {
 	return result;
 }
 
-//積
-Matrix4x4 MatrixMath::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+//積（スカラー版）
+Matrix4x4 MatrixMath::Scalar::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
 
 	Matrix4x4 result;
 	for (int i = 0; i < 4; ++i) {
@@ -123,8 +123,8 @@ Matrix4x4 MatrixMath::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
 	return result;
 }
 
-//アフィン行列
-Matrix4x4 MatrixMath::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+//アフィン行列（スカラー版）
+Matrix4x4 MatrixMath::Scalar::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
 	Matrix4x4 result;
 
 
@@ -154,12 +154,12 @@ Vector3 MatrixMath::Cross(const Vector3& v1, const Vector3& v2) {
 		(v1.z * v2.x) - (v1.x * v2.z),
 		(v1.x * v2.y) - (v1.y * v2.x)
 	};
-	return Vector3();
+	return result;
 }
 
 
-//逆行列
-Matrix4x4 MatrixMath::Inverse(const Matrix4x4& m) {
+//逆行列（スカラー版）
+Matrix4x4 MatrixMath::Scalar::Inverse(const Matrix4x4& m) {
 
 	float aug[4][8] = {};
 	for (int row = 0; row < 4; row++) {
@@ -174,18 +174,20 @@ Matrix4x4 MatrixMath::Inverse(const Matrix4x4& m) {
 	aug[3][7] = 1.0f;
 
 	for (int i = 0; i < 4; i++) {
-		//ピボットが0の場合下の行と入れ替える
-		if (aug[i][i] == 0.0f) {
-			for (int j = i + 1; j < 4; j++) {
-				if (aug[j][i] != 0.0f) {
-					//行を交換する
-					for (int k = 0; k < 8; k++) {//列
-						float copyNum = aug[i][k];//元々ある上の行を代入
-						aug[i][k] = aug[j][k];//上の行
-						aug[j][k] = copyNum;//下の行
-					}
-					break;
-				}
+		//部分ピボット選択：i列目の絶対値が最大の行をピボットにする
+		//（0のときだけ入れ替えると、0に近い値で割って誤差が大きくなる）
+		int pivotRow = i;
+		for (int j = i + 1; j < 4; j++) {
+			if (std::fabs(aug[j][i]) > std::fabs(aug[pivotRow][i])) {
+				pivotRow = j;
+			}
+		}
+		if (pivotRow != i) {
+			//行を交換する
+			for (int k = 0; k < 8; k++) {//列
+				float copyNum = aug[i][k];//元々ある上の行を代入
+				aug[i][k] = aug[pivotRow][k];//上の行
+				aug[pivotRow][k] = copyNum;//下の行
 			}
 		}
 
@@ -216,8 +218,8 @@ Matrix4x4 MatrixMath::Inverse(const Matrix4x4& m) {
 	return result;
 }
 
-//座標変換
-Vector3 MatrixMath::Transform(const Vector3& vector, const Matrix4x4& matrix) {
+//座標変換（スカラー版）
+Vector3 MatrixMath::Scalar::Transform(const Vector3& vector, const Matrix4x4& matrix) {
 	Vector3 result;
 	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
 	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
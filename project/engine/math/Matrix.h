@@ -1,6 +1,8 @@
 #pragma once
 #include "Struct.h"
 #include "Transform.h"
+#include <cstddef>
+#include <span>
 struct  Matrix4x4 {
 	float m[4][4];
 };
@@ -10,6 +12,19 @@ struct  Matrix3x3 {
 	float m[3][3];
 };
 
+// 座標の配列を x, y, z 別々に持つ形式（SoA）。まとめて変換する関数で使う
+struct Vector3SoA {
+	float* x;
+	float* y;
+	float* z;
+};
+
+struct ConstVector3SoA {
+	const float* x;
+	const float* y;
+	const float* z;
+};
+
 
 namespace MatrixMath {
 
@@ -55,15 +70,40 @@ namespace MatrixMath {
 	//4.逆行列
 	Matrix4x4 Inverse(const Matrix4x4& m);
 
+	//逆行列（アフィン行列専用。4列目が (0,0,0,1) の前提で、3x3部分と平行移動だけ計算する）
+	Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+	//逆行列（回転＋平行移動のみ。拡大縮小を含まない前提で、3x3部分は転置で済ませる）
+	//カメラ行列からビュー行列を作るときなど
+	Matrix4x4 InverseRigid(const Matrix4x4& m);
+
 	//3.座標変換
 	Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
 
+	//まとめて座標変換（w で割る。透視投影行列など）
+	// AoS で受け取り SoA で書き出す / SoA で受け取り SoA で書き出す（入力と出力は同じ配列でもよい）
+	void TransformPoints(std::span<const Vector3> points, const Matrix4x4& matrix, Vector3SoA out);
+	void TransformPoints(ConstVector3SoA points, size_t count, const Matrix4x4& matrix, Vector3SoA out);
+
+	//まとめて座標変換（アフィン行列専用。4列目が (0,0,0,1) の前提で w の割り算を省く）
+	void TransformAffinePoints(std::span<const Vector3> points, const Matrix4x4& matrix, Vector3SoA out);
+	void TransformAffinePoints(ConstVector3SoA points, size_t count, const Matrix4x4& matrix, Vector3SoA out);
+
 	//6.単位行列の作成
 	Matrix4x4 MakeIdentity4x4();
 
 	Vector3 Normalize(const Vector3& v);
 	
 
+	// スカラー版（SIMD版の結果確認・比較用）
+	// 上の Multiply / MakeAffineMatrix / Inverse / Transform はビルド環境に合わせて
+	// SSE / AVX2 / NEON 版が選ばれる（MatrixSimd.cpp）
+	namespace Scalar {
+		Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+		Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+		Matrix4x4 Inverse(const Matrix4x4& m); // 部分ピボット選択付きの掃き出し法
+		Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+	}
 	
 };
 
@@ -0,0 +1,429 @@
+#include "Matrix.h"
+#include <cmath>
+
+// 行列演算のSIMD版
+// コンパイル時に使える命令セットを判定して実装を切り替える（実行時の分岐は無い）
+//   AVX2 : /arch:AVX2, -mavx2 -mfma
+//   SSE  : x64 なら常に有効
+//   NEON : ARM64（vdupq_laneq_f32・vdivq_f32 などを使うので、32bit ARM はスカラー版）
+//   どれも無ければスカラー版を使う
+#if (defined(__AVX2__) && defined(__FMA__)) || (defined(_MSC_VER) && defined(__AVX2__))
+#define MATRIX_MATH_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATRIX_MATH_SSE
+#include <xmmintrin.h>
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define MATRIX_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+//積
+// 結果の i 行目 = m1[i][0] * m2の0行目 + m1[i][1] * m2の1行目 + ... を4要素まとめて計算する
+Matrix4x4 MatrixMath::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+#if defined(MATRIX_MATH_AVX2)
+	// 2行ずつ8要素で計算（FMAを使うので、スカラー版とは丸めがわずかに異なる）
+	__m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+	__m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+	__m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+	__m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+	for (int i = 0; i < 4; i += 2) {
+		__m256 a = _mm256_loadu_ps(m1.m[i]);
+		__m256 r = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), b0);
+		r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0x55), b1, r);
+		r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xAA), b2, r);
+		r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xFF), b3, r);
+		_mm256_storeu_ps(result.m[i], r);
+	}
+#elif defined(MATRIX_MATH_SSE)
+	// 足し算の順番はスカラー版と同じなので、結果も一致する
+	__m128 b0 = _mm_loadu_ps(m2.m[0]);
+	__m128 b1 = _mm_loadu_ps(m2.m[1]);
+	__m128 b2 = _mm_loadu_ps(m2.m[2]);
+	__m128 b3 = _mm_loadu_ps(m2.m[3]);
+	for (int i = 0; i < 4; ++i) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), b0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), b1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), b2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), b3));
+		_mm_storeu_ps(result.m[i], r);
+	}
+#elif defined(MATRIX_MATH_NEON)
+	float32x4_t b0 = vld1q_f32(m2.m[0]);
+	float32x4_t b1 = vld1q_f32(m2.m[1]);
+	float32x4_t b2 = vld1q_f32(m2.m[2]);
+	float32x4_t b3 = vld1q_f32(m2.m[3]);
+	for (int i = 0; i < 4; ++i) {
+		float32x4_t r = vmulq_n_f32(b0, m1.m[i][0]);
+		r = vaddq_f32(r, vmulq_n_f32(b1, m1.m[i][1]));
+		r = vaddq_f32(r, vmulq_n_f32(b2, m1.m[i][2]));
+		r = vaddq_f32(r, vmulq_n_f32(b3, m1.m[i][3]));
+		vst1q_f32(result.m[i], r);
+	}
+#else
+	result = Scalar::Multiply(m1, m2);
+#endif
+	return result;
+}
+
+//アフィン行列
+// X,Y,Z回転行列を作って2回掛け合わせる代わりに、展開済みの式 (Rx * Ry * Rz) で直接求める
+// sin / cos も各軸1回ずつで済む
+Matrix4x4 MatrixMath::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	float sx = std::sin(rotate.x), cx = std::cos(rotate.x);
+	float sy = std::sin(rotate.y), cy = std::cos(rotate.y);
+	float sz = std::sin(rotate.z), cz = std::cos(rotate.z);
+
+	Matrix4x4 result = {
+		scale.x * (cy * cz),                  scale.x * (cy * sz),                  scale.x * (-sy),     0.0f,
+		scale.y * (-cx * sz + sx * sy * cz),  scale.y * (cx * cz + sx * sy * sz),   scale.y * (sx * cy), 0.0f,
+		scale.z * (sx * sz + cx * sy * cz),   scale.z * (-sx * cz + cx * sy * sz),  scale.z * (cx * cy), 0.0f,
+		translate.x,                          translate.y,                          translate.z,         1.0f
+	};
+	return result;
+}
+
+namespace {
+	// |行列式| / (各行の長さの積) がこれより小さい行列は、余因子では誤差が大きくなるのでスカラー版で求める
+	// Hadamard の不等式から比は 0〜1 で、直交に近いほど 1 に近い
+	constexpr float kInverseConditionThreshold = 1.0e-3f;
+}
+
+//逆行列
+// 余因子（Cramer の公式）で求める。行の入れ替えや分岐が無く、割り算は行列式での1回だけ
+// 小行列式は 2x2 の積をまとめて計算し、4要素ずつ並べ替えながら組み立てる
+// 特異に近い行列は、ピボット選択のあるスカラー版に任せる
+Matrix4x4 MatrixMath::Inverse(const Matrix4x4& m) {
+#if defined(MATRIX_MATH_SSE)
+	const float* src = &m.m[0][0];
+
+	// 転置しながら読み込む（row0 = 0列目, ... の並びで計算する）
+	__m128 tmp = _mm_setzero_ps();
+	__m128 row0, row1, row2, row3;
+	tmp = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src)), reinterpret_cast<const __m64*>(src + 4));
+	row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(src + 8)), reinterpret_cast<const __m64*>(src + 12));
+	row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+	row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+	tmp = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src + 2)), reinterpret_cast<const __m64*>(src + 6));
+	row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(src + 10)), reinterpret_cast<const __m64*>(src + 14));
+	row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+	row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+	// 元の行の長さの二乗（row0..row3 は列なので、要素ごとに足すと行ごとの和になる）
+	__m128 rowLengthSq = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(row0, row0), _mm_mul_ps(row1, row1)),
+		_mm_add_ps(_mm_mul_ps(row2, row2), _mm_mul_ps(row3, row3)));
+
+	__m128 minor0, minor1, minor2, minor3;
+
+	tmp = _mm_mul_ps(row2, row3);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	minor0 = _mm_mul_ps(row1, tmp);
+	minor1 = _mm_mul_ps(row0, tmp);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+	minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+	minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+	tmp = _mm_mul_ps(row1, row2);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+	minor3 = _mm_mul_ps(row0, tmp);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+	minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+	minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+	tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+	minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+	minor2 = _mm_mul_ps(row0, tmp);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+	minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+	minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+	tmp = _mm_mul_ps(row0, row1);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+	minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+	tmp = _mm_mul_ps(row0, row3);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+	minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+	minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+	tmp = _mm_mul_ps(row0, row2);
+	tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+	minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+	tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+	minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+	// 行列式（精度を落とさないよう近似逆数ではなく割り算で求める）
+	__m128 det = _mm_mul_ps(row0, minor0);
+	det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+	det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+	det = _mm_shuffle_ps(det, det, 0x00);
+
+	// 特異に近いか（det^2 < k^2 * 各行の長さの二乗の積）
+	__m128 bound = _mm_mul_ps(rowLengthSq, _mm_shuffle_ps(rowLengthSq, rowLengthSq, 0x4E));
+	bound = _mm_mul_ss(bound, _mm_shuffle_ps(bound, bound, 0xB1));
+	bound = _mm_mul_ss(bound, _mm_set_ss(kInverseConditionThreshold * kInverseConditionThreshold));
+	if (_mm_comilt_ss(_mm_mul_ss(det, det), bound)) {
+		return Scalar::Inverse(m);
+	}
+
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+	Matrix4x4 result;
+	_mm_storeu_ps(result.m[0], _mm_mul_ps(invDet, minor0));
+	_mm_storeu_ps(result.m[1], _mm_mul_ps(invDet, minor1));
+	_mm_storeu_ps(result.m[2], _mm_mul_ps(invDet, minor2));
+	_mm_storeu_ps(result.m[3], _mm_mul_ps(invDet, minor3));
+	return result;
+#else
+	return Scalar::Inverse(m);
+#endif
+}
+
+//逆行列（アフィン行列専用）
+// M = | A 0 |  のとき  M^-1 = | A^-1     0 |
+//     | t 1 |                 | -t*A^-1  1 |
+Matrix4x4 MatrixMath::InverseAffine(const Matrix4x4& m) {
+	// 3x3部分の余因子
+	float c00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	float c01 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	float c02 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+	float invDet = 1.0f / (m.m[0][0] * c00 + m.m[0][1] * c01 + m.m[0][2] * c02);
+
+	Matrix4x4 result = {};
+	result.m[0][0] = c00 * invDet;
+	result.m[1][0] = c01 * invDet;
+	result.m[2][0] = c02 * invDet;
+	result.m[0][1] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * invDet;
+	result.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * invDet;
+	result.m[2][1] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * invDet;
+	result.m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * invDet;
+	result.m[1][2] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * invDet;
+	result.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * invDet;
+
+	// 平行移動 = -t * A^-1
+	for (int col = 0; col < 3; col++) {
+		result.m[3][col] = -(m.m[3][0] * result.m[0][col] + m.m[3][1] * result.m[1][col] + m.m[3][2] * result.m[2][col]);
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+//逆行列（回転＋平行移動のみ）
+// 回転行列の逆行列は転置なので、A^-1 = A^T、平行移動は -t * A^T
+Matrix4x4 MatrixMath::InverseRigid(const Matrix4x4& m) {
+	Matrix4x4 result = {};
+	for (int row = 0; row < 3; row++) {
+		for (int col = 0; col < 3; col++) {
+			result.m[row][col] = m.m[col][row];
+		}
+	}
+	for (int col = 0; col < 3; col++) {
+		result.m[3][col] = -(m.m[3][0] * m.m[col][0] + m.m[3][1] * m.m[col][1] + m.m[3][2] * m.m[col][2]);
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+//座標変換
+Vector3 MatrixMath::Transform(const Vector3& vector, const Matrix4x4& matrix) {
+#if defined(MATRIX_MATH_SSE)
+	// x, y, z, w をまとめて計算し、w で一度に割る
+	__m128 r = _mm_mul_ps(_mm_set1_ps(vector.x), _mm_loadu_ps(matrix.m[0]));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(vector.y), _mm_loadu_ps(matrix.m[1])));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(vector.z), _mm_loadu_ps(matrix.m[2])));
+	r = _mm_add_ps(r, _mm_loadu_ps(matrix.m[3]));
+	r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+
+	alignas(16) float out[4];
+	_mm_store_ps(out, r);
+	return { out[0], out[1], out[2] };
+#elif defined(MATRIX_MATH_NEON)
+	float32x4_t r = vmulq_n_f32(vld1q_f32(matrix.m[0]), vector.x);
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[1]), vector.y));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[2]), vector.z));
+	r = vaddq_f32(r, vld1q_f32(matrix.m[3]));
+	r = vdivq_f32(r, vdupq_laneq_f32(r, 3));
+
+	float out[4];
+	vst1q_f32(out, r);
+	return { out[0], out[1], out[2] };
+#else
+	return Scalar::Transform(vector, matrix);
+#endif
+}
+
+// ================================
+//  まとめて座標変換
+// ================================
+namespace {
+
+	// 1点分（スカラー）。端数の処理に使う
+	template <bool kAffine>
+	void TransformPoint(float x, float y, float z, const Matrix4x4& m, float& outX, float& outY, float& outZ) {
+		float rx = x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0] + m.m[3][0];
+		float ry = x * m.m[0][1] + y * m.m[1][1] + z * m.m[2][1] + m.m[3][1];
+		float rz = x * m.m[0][2] + y * m.m[1][2] + z * m.m[2][2] + m.m[3][2];
+		if constexpr (!kAffine) {
+			float w = x * m.m[0][3] + y * m.m[1][3] + z * m.m[2][3] + m.m[3][3];
+			rx /= w;
+			ry /= w;
+			rz /= w;
+		}
+		outX = rx;
+		outY = ry;
+		outZ = rz;
+	}
+
+#if defined(MATRIX_MATH_SSE)
+	// AoS の4点 (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) を x, y, z の4要素ずつに並べ替える
+	void LoadPoints4(const Vector3* p, __m128& x, __m128& y, __m128& z) {
+		const float* f = &p->x;
+		__m128 a = _mm_loadu_ps(f);
+		__m128 b = _mm_loadu_ps(f + 4);
+		__m128 c = _mm_loadu_ps(f + 8);
+		x = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+	}
+#endif
+
+	// aos が nullptr でなければ AoS から、そうでなければ inX/inY/inZ から読む
+	template <bool kAffine>
+	void TransformPointsImpl(const Vector3* aos, ConstVector3SoA soa, size_t count, const Matrix4x4& m, Vector3SoA out) {
+		size_t i = 0;
+#if defined(MATRIX_MATH_AVX2)
+		// 8点ずつ
+		const __m256 m00 = _mm256_set1_ps(m.m[0][0]), m01 = _mm256_set1_ps(m.m[0][1]), m02 = _mm256_set1_ps(m.m[0][2]), m03 = _mm256_set1_ps(m.m[0][3]);
+		const __m256 m10 = _mm256_set1_ps(m.m[1][0]), m11 = _mm256_set1_ps(m.m[1][1]), m12 = _mm256_set1_ps(m.m[1][2]), m13 = _mm256_set1_ps(m.m[1][3]);
+		const __m256 m20 = _mm256_set1_ps(m.m[2][0]), m21 = _mm256_set1_ps(m.m[2][1]), m22 = _mm256_set1_ps(m.m[2][2]), m23 = _mm256_set1_ps(m.m[2][3]);
+		const __m256 m30 = _mm256_set1_ps(m.m[3][0]), m31 = _mm256_set1_ps(m.m[3][1]), m32 = _mm256_set1_ps(m.m[3][2]), m33 = _mm256_set1_ps(m.m[3][3]);
+		for (; i + 8 <= count; i += 8) {
+			__m256 x, y, z;
+			if (aos) {
+				__m128 x0, y0, z0, x1, y1, z1;
+				LoadPoints4(aos + i, x0, y0, z0);
+				LoadPoints4(aos + i + 4, x1, y1, z1);
+				x = _mm256_set_m128(x1, x0);
+				y = _mm256_set_m128(y1, y0);
+				z = _mm256_set_m128(z1, z0);
+			} else {
+				x = _mm256_loadu_ps(soa.x + i);
+				y = _mm256_loadu_ps(soa.y + i);
+				z = _mm256_loadu_ps(soa.z + i);
+			}
+			__m256 rx = _mm256_fmadd_ps(z, m20, _mm256_fmadd_ps(y, m10, _mm256_fmadd_ps(x, m00, m30)));
+			__m256 ry = _mm256_fmadd_ps(z, m21, _mm256_fmadd_ps(y, m11, _mm256_fmadd_ps(x, m01, m31)));
+			__m256 rz = _mm256_fmadd_ps(z, m22, _mm256_fmadd_ps(y, m12, _mm256_fmadd_ps(x, m02, m32)));
+			if constexpr (!kAffine) {
+				__m256 w = _mm256_fmadd_ps(z, m23, _mm256_fmadd_ps(y, m13, _mm256_fmadd_ps(x, m03, m33)));
+				rx = _mm256_div_ps(rx, w);
+				ry = _mm256_div_ps(ry, w);
+				rz = _mm256_div_ps(rz, w);
+			}
+			_mm256_storeu_ps(out.x + i, rx);
+			_mm256_storeu_ps(out.y + i, ry);
+			_mm256_storeu_ps(out.z + i, rz);
+		}
+#elif defined(MATRIX_MATH_SSE)
+		// 4点ずつ
+		const __m128 m00 = _mm_set1_ps(m.m[0][0]), m01 = _mm_set1_ps(m.m[0][1]), m02 = _mm_set1_ps(m.m[0][2]), m03 = _mm_set1_ps(m.m[0][3]);
+		const __m128 m10 = _mm_set1_ps(m.m[1][0]), m11 = _mm_set1_ps(m.m[1][1]), m12 = _mm_set1_ps(m.m[1][2]), m13 = _mm_set1_ps(m.m[1][3]);
+		const __m128 m20 = _mm_set1_ps(m.m[2][0]), m21 = _mm_set1_ps(m.m[2][1]), m22 = _mm_set1_ps(m.m[2][2]), m23 = _mm_set1_ps(m.m[2][3]);
+		const __m128 m30 = _mm_set1_ps(m.m[3][0]), m31 = _mm_set1_ps(m.m[3][1]), m32 = _mm_set1_ps(m.m[3][2]), m33 = _mm_set1_ps(m.m[3][3]);
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z;
+			if (aos) {
+				LoadPoints4(aos + i, x, y, z);
+			} else {
+				x = _mm_loadu_ps(soa.x + i);
+				y = _mm_loadu_ps(soa.y + i);
+				z = _mm_loadu_ps(soa.z + i);
+			}
+			// 足し算の順番はスカラー版と同じ
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_mul_ps(z, m20)), m30);
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_mul_ps(z, m21)), m31);
+			__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_mul_ps(z, m22)), m32);
+			if constexpr (!kAffine) {
+				__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m03), _mm_mul_ps(y, m13)), _mm_mul_ps(z, m23)), m33);
+				rx = _mm_div_ps(rx, w);
+				ry = _mm_div_ps(ry, w);
+				rz = _mm_div_ps(rz, w);
+			}
+			_mm_storeu_ps(out.x + i, rx);
+			_mm_storeu_ps(out.y + i, ry);
+			_mm_storeu_ps(out.z + i, rz);
+		}
+#elif defined(MATRIX_MATH_NEON)
+		// 4点ずつ（vld3q で AoS をそのまま x, y, z に分けて読める）
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t x, y, z;
+			if (aos) {
+				float32x4x3_t p = vld3q_f32(&aos[i].x);
+				x = p.val[0];
+				y = p.val[1];
+				z = p.val[2];
+			} else {
+				x = vld1q_f32(soa.x + i);
+				y = vld1q_f32(soa.y + i);
+				z = vld1q_f32(soa.z + i);
+			}
+			float32x4_t rx = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m.m[0][0]), vmulq_n_f32(y, m.m[1][0])), vmulq_n_f32(z, m.m[2][0])), vdupq_n_f32(m.m[3][0]));
+			float32x4_t ry = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m.m[0][1]), vmulq_n_f32(y, m.m[1][1])), vmulq_n_f32(z, m.m[2][1])), vdupq_n_f32(m.m[3][1]));
+			float32x4_t rz = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m.m[0][2]), vmulq_n_f32(y, m.m[1][2])), vmulq_n_f32(z, m.m[2][2])), vdupq_n_f32(m.m[3][2]));
+			if constexpr (!kAffine) {
+				// vdivq_f32 は AArch64 にしか無い（MATRIX_MATH_NEON は AArch64 のときだけ有効）
+				float32x4_t w = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m.m[0][3]), vmulq_n_f32(y, m.m[1][3])), vmulq_n_f32(z, m.m[2][3])), vdupq_n_f32(m.m[3][3]));
+				rx = vdivq_f32(rx, w);
+				ry = vdivq_f32(ry, w);
+				rz = vdivq_f32(rz, w);
+			}
+			vst1q_f32(out.x + i, rx);
+			vst1q_f32(out.y + i, ry);
+			vst1q_f32(out.z + i, rz);
+		}
+#endif
+		// 端数（SIMDが無い場合は全部）
+		for (; i < count; ++i) {
+			if (aos) {
+				TransformPoint<kAffine>(aos[i].x, aos[i].y, aos[i].z, m, out.x[i], out.y[i], out.z[i]);
+			} else {
+				TransformPoint<kAffine>(soa.x[i], soa.y[i], soa.z[i], m, out.x[i], out.y[i], out.z[i]);
+			}
+		}
+	}
+}
+
+void MatrixMath::TransformPoints(std::span<const Vector3> points, const Matrix4x4& matrix, Vector3SoA out) {
+	TransformPointsImpl<false>(points.data(), {}, points.size(), matrix, out);
+}
+
+void MatrixMath::TransformPoints(ConstVector3SoA points, size_t count, const Matrix4x4& matrix, Vector3SoA out) {
+	TransformPointsImpl<false>(nullptr, points, count, matrix, out);
+}
+
+void MatrixMath::TransformAffinePoints(std::span<const Vector3> points, const Matrix4x4& matrix, Vector3SoA out) {
+	TransformPointsImpl<true>(points.data(), {}, points.size(), matrix, out);
+}
+
+void MatrixMath::TransformAffinePoints(ConstVector3SoA points, size_t count, const Matrix4x4& matrix, Vector3SoA out) {
+	TransformPointsImpl<true>(nullptr, points, count, matrix, out);
+}
@@ -8,15 +8,17 @@ struct Vector2 {
     float x;
     float y;
 
-    Vector2& operator+=(const Vector2& rhs) {
+    constexpr Vector2& operator+=(const Vector2& rhs) {
         x += rhs.x;
         y += rhs.y;
         return *this;
     }
 
-    Vector2 operator+(const Vector2& rhs) const {
+    constexpr Vector2 operator+(const Vector2& rhs) const {
         return { x + rhs.x, y + rhs.y };
     }
+
+    constexpr bool operator==(const Vector2& rhs) const = default;
 };
 
 
@@ -25,6 +27,8 @@ struct Vector4 {
 	float y; 
 	float z;
 	float w;
+
+	constexpr bool operator==(const Vector4& rhs) const = default;
 };
 
 // 球  
@@ -0,0 +1,102 @@
+#include "AsyncTextureLoader.h"
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace {
+    // ファイルを読まない偽物の読み込み（パスの長さを contentHash にする。"missing" なら失敗）
+    void FakeDecode(const std::wstring& filePath, AsyncTextureLoader::Result& result) {
+        result.contentHash = filePath.size();
+        result.hr = filePath == L"missing" ? E_FAIL : S_OK;
+    }
+
+    // 条件を満たすまで待つ（ワーカーの進み具合を見るため。1秒で諦める）
+    template <typename Predicate>
+    bool WaitUntil(Predicate predicate) {
+        for (int i = 0; i < 1000 && !predicate(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
+}
+
+TEST(LoadsInPlaceWithoutThreadPool) {
+    AsyncTextureLoader loader;
+    loader.Initialize(nullptr);
+    loader.SetDecoder(FakeDecode);
+    loader.Request(7, L"a.png");
+    loader.Request(3, L"missing");
+    // スレッドプールが無ければ Request の中で終わっている
+    CHECK_EQ(loader.GetPendingCount(), 0u);
+
+    std::vector<AsyncTextureLoader::Result> results;
+    loader.CollectCompleted(results);
+    CHECK_EQ(results.size(), 2u);
+    CHECK_EQ(results[0].textureHandle, 7u);
+    CHECK_EQ(results[0].contentHash, 5u);
+    CHECK(SUCCEEDED(results[0].hr));
+    CHECK_EQ(results[1].textureHandle, 3u);
+    CHECK(FAILED(results[1].hr));
+
+    // 受け取ったものは二度は返らない
+    results.clear();
+    loader.CollectCompleted(results);
+    CHECK(results.empty());
+}
+
+TEST(CollectsInCompletionOrder) {
+    ThreadPool threadPool;
+    threadPool.Initialize(2);
+    std::promise<void> releaseSlow;
+    std::shared_future<void> slowReleased = releaseSlow.get_future().share();
+
+    AsyncTextureLoader loader;
+    loader.Initialize(&threadPool);
+    loader.SetDecoder([slowReleased](const std::wstring& filePath, AsyncTextureLoader::Result& result) {
+        if (filePath == L"slow.png") {
+            slowReleased.wait();
+        }
+        FakeDecode(filePath, result);
+    });
+    loader.Request(1, L"slow.png");
+    loader.Request(2, L"fast.png");
+
+    // 後から投げた方が先に終わり、先に受け取れる
+    CHECK(WaitUntil([&] { return loader.GetPendingCount() == 1; }));
+    std::vector<AsyncTextureLoader::Result> results;
+    loader.CollectCompleted(results);
+    CHECK_EQ(results.size(), 1u);
+    CHECK_EQ(results[0].textureHandle, 2u);
+
+    releaseSlow.set_value();
+    loader.WaitAll();
+    CHECK_EQ(loader.GetPendingCount(), 0u);
+    loader.CollectCompleted(results);
+    CHECK_EQ(results.size(), 2u);
+    CHECK_EQ(results[1].textureHandle, 1u);
+    CHECK_EQ(results[1].contentHash, 8u);
+}
+
+TEST(DestructorWaitsForLoadsInFlight) {
+    ThreadPool threadPool;
+    threadPool.Initialize(2);
+    constexpr int kRequestCount = 8;
+    std::atomic<int> finishedCount = 0;
+    {
+        AsyncTextureLoader loader;
+        loader.Initialize(&threadPool);
+        loader.SetDecoder([&finishedCount](const std::wstring& filePath, AsyncTextureLoader::Result& result) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            FakeDecode(filePath, result);
+            ++finishedCount;
+        });
+        for (int i = 0; i < kRequestCount; ++i) {
+            loader.Request(i, L"texture.png");
+        }
+        // 受け取らずに壊す（ワーカーが消えた loader を触らないよう、デストラクタが待つ）
+    }
+    CHECK_EQ(finishedCount.load(), kRequestCount);
+}
@@ -0,0 +1,112 @@
+#include "AtlasLayout.h"
+#include "SpriteQuad.h"
+#include "TestFramework.h"
+#include <random>
+
+namespace {
+    bool Overlaps(const AtlasLayout::Region& a, uint32_t aPadding, const AtlasLayout::Region& b) {
+        return a.x < b.x + b.width && b.x < a.x + a.width + aPadding && a.y < b.y + b.height && b.y < a.y + a.height + aPadding;
+    }
+}
+
+TEST(OverflowsIntoSecondPage) {
+    // 128x128 のページに 64x64 は4つまで。5つ目は2ページ目に入る
+    std::vector<AtlasLayout::Size> sizes(5, { 64, 64 });
+    AtlasLayout layout;
+    CHECK(layout.Build(sizes, 128, 0));
+    CHECK_EQ(layout.GetPageCount(), 2u);
+    uint32_t pageCounts[2] = {};
+    for (const AtlasLayout::Region& region : layout.GetRegions()) {
+        CHECK(region.page < 2);
+        ++pageCounts[region.page];
+    }
+    CHECK_EQ(pageCounts[0], 4u);
+    CHECK_EQ(pageCounts[1], 1u);
+    CHECK_NEAR(layout.GetOccupancy(0), 1.0, 1.0e-6);
+    CHECK_NEAR(layout.GetOccupancy(1), 0.25, 1.0e-6);
+
+    // 2ページ目の最初の四角形は左上から
+    const AtlasLayout::Region& last = layout.GetRegions()[4];
+    CHECK_EQ(last.page, 1u);
+    CHECK_EQ(last.x, 0u);
+    CHECK_EQ(last.y, 0u);
+}
+
+TEST(LaterSmallRectsFillEarlierPages) {
+    // 大きいものが2ページ目にあふれても、小さいものは1ページ目の隙間に入る
+    std::vector<AtlasLayout::Size> sizes = { { 16, 16 }, { 100, 100 }, { 100, 100 } };
+    AtlasLayout layout;
+    CHECK(layout.Build(sizes, 128, 2));
+    CHECK_EQ(layout.GetPageCount(), 2u);
+    CHECK_EQ(layout.GetRegions()[1].page, 0u);
+    CHECK_EQ(layout.GetRegions()[2].page, 1u);
+    CHECK_EQ(layout.GetRegions()[0].page, 0u);
+}
+
+TEST(RegionsFollowInputOrder) {
+    // 置くのは高い順だが、Region は渡した順（LoadTextureAtlas の filePaths と同じ順）
+    std::vector<AtlasLayout::Size> sizes = { { 10, 20 }, { 30, 50 }, { 40, 5 }, { 8, 50 }, { 12, 35 } };
+    AtlasLayout layout;
+    CHECK(layout.Build(sizes, 256, 2));
+    const std::vector<AtlasLayout::Region>& regions = layout.GetRegions();
+    CHECK_EQ(regions.size(), sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        CHECK_EQ(regions[i].width, sizes[i].width);
+        CHECK_EQ(regions[i].height, sizes[i].height);
+    }
+    // 一番高いもの（同じなら幅の広いもの）が左上
+    CHECK_EQ(regions[1].x, 0u);
+    CHECK_EQ(regions[1].y, 0u);
+    CHECK_EQ(regions[3].y, 0u);
+    CHECK_EQ(regions[3].x, 30u + 2u);
+}
+
+TEST(RejectsRectLargerThanPage) {
+    std::vector<AtlasLayout::Size> sizes = { { 16, 16 }, { 129, 8 } };
+    AtlasLayout layout;
+    CHECK(!layout.Build(sizes, 128));
+}
+
+TEST(PaddingKeepsSpriteUVsApart) {
+    constexpr uint32_t kPageSize = 256;
+    constexpr uint32_t kPadding = 2;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint32_t> size(4, 80);
+    std::vector<AtlasLayout::Size> sizes(60);
+    for (AtlasLayout::Size& s : sizes) {
+        s = { size(random), size(random) };
+    }
+    AtlasLayout layout;
+    CHECK(layout.Build(sizes, kPageSize, kPadding));
+    CHECK(layout.GetPageCount() >= 2);
+    const std::vector<AtlasLayout::Region>& regions = layout.GetRegions();
+
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const AtlasLayout::Region& region = regions[i];
+        CHECK(region.x + region.width <= kPageSize);
+        CHECK(region.y + region.height <= kPageSize);
+
+        // 右と下の隙間（ページの端を除く）には他の画像が無いので、縁をバイリニアで読んでも隣の色が混ざらない
+        for (size_t j = 0; j < regions.size(); ++j) {
+            if (i != j && regions[j].page == region.page) {
+                CHECK(!Overlaps(region, kPadding, regions[j]));
+            }
+        }
+
+        // Sprite::SetTextureRegion と同じ手順で UV を作ると、ちょうど切り出し範囲になる
+        SpriteQuad quad;
+        const Vector2 pageSize = { float(kPageSize), float(kPageSize) };
+        quad.SetTexture(pageSize);
+        quad.SetTextureRect({ float(region.x), float(region.y) }, { float(region.width), float(region.height) });
+        quad.Update(pageSize);
+        const SpriteBatch::Vertex (&vertices)[SpriteBatch::kVerticesPerSprite] = quad.GetVertices();
+        // 1: 左上、2: 右下
+        CHECK_NEAR(vertices[1].texcoord.x, float(region.x) / kPageSize, 1.0e-6);
+        CHECK_NEAR(vertices[1].texcoord.y, float(region.y) / kPageSize, 1.0e-6);
+        CHECK_NEAR(vertices[2].texcoord.x, float(region.x + region.width) / kPageSize, 1.0e-6);
+        CHECK_NEAR(vertices[2].texcoord.y, float(region.y + region.height) / kPageSize, 1.0e-6);
+        // 表示サイズは画像の大きさのまま
+        CHECK_NEAR(vertices[2].position.x - vertices[1].position.x, float(region.width), 1.0e-4);
+        CHECK_NEAR(vertices[2].position.y - vertices[1].position.y, float(region.height), 1.0e-4);
+    }
+}
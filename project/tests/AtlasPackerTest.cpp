@@ -0,0 +1,72 @@
+#include "AtlasPacker.h"
+#include "TestFramework.h"
+#include <random>
+
+namespace {
+    bool Overlaps(const AtlasPacker::Rect& a, const AtlasPacker::Rect& b) {
+        return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+}
+
+TEST(PlacesFirstRectAtOrigin) {
+    AtlasPacker packer;
+    packer.Initialize(256, 256, 0);
+    AtlasPacker::Rect rect;
+    CHECK(packer.Insert(64, 32, rect));
+    CHECK_EQ(rect.x, 0u);
+    CHECK_EQ(rect.y, 0u);
+    CHECK_EQ(rect.width, 64u);
+    CHECK_EQ(rect.height, 32u);
+    CHECK_NEAR(packer.GetOccupancy(), 64.0 * 32.0 / (256.0 * 256.0), 1.0e-6);
+}
+
+TEST(FillsPageExactlyWithoutPadding) {
+    AtlasPacker packer;
+    packer.Initialize(128, 128, 0);
+    AtlasPacker::Rect rect;
+    for (int i = 0; i < 16; ++i) {
+        CHECK(packer.Insert(32, 32, rect));
+    }
+    CHECK_NEAR(packer.GetOccupancy(), 1.0, 1.0e-6);
+    CHECK(!packer.Insert(1, 1, rect));
+}
+
+TEST(RejectsRectLargerThanPage) {
+    AtlasPacker packer;
+    packer.Initialize(64, 64, 2);
+    AtlasPacker::Rect rect;
+    CHECK(!packer.Insert(65, 10, rect));
+    CHECK(!packer.Insert(10, 65, rect));
+    CHECK(packer.Insert(64, 64, rect));
+}
+
+TEST(RandomRectsStayInsidePageAndApart) {
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<uint32_t> size(1, 96);
+    for (int trial = 0; trial < 20; ++trial) {
+        const uint32_t padding = trial % 3;
+        AtlasPacker packer;
+        packer.Initialize(512, 512, padding);
+        std::vector<AtlasPacker::Rect> placed;
+        for (int i = 0; i < 300; ++i) {
+            AtlasPacker::Rect rect;
+            uint32_t width = size(random);
+            uint32_t height = size(random);
+            if (!packer.Insert(width, height, rect)) {
+                continue;
+            }
+            CHECK_EQ(rect.width, width);
+            CHECK_EQ(rect.height, height);
+            CHECK(rect.x + rect.width <= packer.GetWidth());
+            CHECK(rect.y + rect.height <= packer.GetHeight());
+            // 隙間も含めて重ならない
+            AtlasPacker::Rect padded = { rect.x, rect.y, rect.width + padding, rect.height + padding };
+            for (const AtlasPacker::Rect& other : placed) {
+                AtlasPacker::Rect otherPadded = { other.x, other.y, other.width + padding, other.height + padding };
+                CHECK(!Overlaps(padded, other) && !Overlaps(otherPadded, rect));
+            }
+            placed.push_back(rect);
+        }
+        CHECK(!placed.empty());
+    }
+}
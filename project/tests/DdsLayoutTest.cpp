@@ -0,0 +1,137 @@
+#include "DdsLayout.h"
+#include "TestFramework.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+    // 画像を DDS ファイルにしたときのバイト列（中身は番号で埋める）
+    std::vector<uint8_t> MakeDds(DXGI_FORMAT format, size_t width, size_t height, size_t arraySize, size_t mipLevels, DirectX::DDS_FLAGS flags) {
+        DirectX::ScratchImage image;
+        HRESULT hr = image.Initialize2D(format, width, height, arraySize, mipLevels);
+        CHECK(SUCCEEDED(hr));
+        for (size_t i = 0; i < image.GetPixelsSize(); ++i) {
+            image.GetPixels()[i] = static_cast<uint8_t>(i * 7);
+        }
+        DirectX::Blob blob;
+        hr = DirectX::SaveToDDSMemory(image.GetImages(), image.GetImageCount(), image.GetMetadata(), flags, blob);
+        CHECK(SUCCEEDED(hr));
+        const uint8_t* bytes = static_cast<const uint8_t*>(blob.GetBufferPointer());
+        return std::vector<uint8_t>(bytes, bytes + blob.GetBufferSize());
+    }
+
+    // マジック（4バイト）+ DDS_HEADER（124バイト）
+    constexpr size_t kHeaderSize = 4 + 124;
+    // DX10 拡張ヘッダー（20バイト）
+    constexpr size_t kDx10HeaderSize = 20;
+}
+
+TEST(ParsesDx10HeaderAndMipChain) {
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 32, 1, 0, DirectX::DDS_FLAGS_FORCE_DX10_EXT);
+    DdsLayout layout;
+    CHECK(layout.Parse(dds.data(), dds.size()));
+    CHECK_EQ(layout.metadata.width, 64u);
+    CHECK_EQ(layout.metadata.height, 32u);
+    CHECK(layout.metadata.format == DXGI_FORMAT_R8G8B8A8_UNORM);
+    // 64x32 から 1x1 まで 7 段
+    CHECK_EQ(layout.metadata.mipLevels, 7u);
+    CHECK_EQ(layout.subresources.size(), 7u);
+
+    // ピクセルは拡張ヘッダーの直後から、大きいミップの順に隙間なく並ぶ
+    CHECK_EQ(layout.subresources[0].offset, kHeaderSize + kDx10HeaderSize);
+    CHECK_EQ(layout.subresources[0].rowPitch, 64u * 4u);
+    CHECK_EQ(layout.subresources[0].slicePitch, 64u * 4u * 32u);
+    for (size_t i = 1; i < layout.subresources.size(); ++i) {
+        CHECK_EQ(layout.subresources[i].offset, layout.subresources[i - 1].offset + layout.subresources[i - 1].slicePitch);
+    }
+    CHECK_EQ(layout.subresources[6].slicePitch, 4u);
+    CHECK_EQ(layout.subresources[6].offset + layout.subresources[6].slicePitch, dds.size());
+}
+
+TEST(ParsesLegacyBlockCompressed) {
+    // BC1 は古いヘッダー（FourCC が DXT1）でもそのまま使える
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_BC1_UNORM, 64, 64, 1, 3, DirectX::DDS_FLAGS_NONE);
+    DdsLayout layout;
+    CHECK(layout.Parse(dds.data(), dds.size()));
+    CHECK_EQ(layout.subresources.size(), 3u);
+    CHECK_EQ(layout.subresources[0].offset, kHeaderSize);
+    CHECK_EQ(layout.subresources[2].offset + layout.subresources[2].slicePitch, dds.size());
+}
+
+TEST(ParsesBlockCompressedArray) {
+    // 配列は要素ごとに全ミップが続く（配列は拡張ヘッダーでしか書けない）
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_BC1_UNORM, 64, 64, 2, 3, DirectX::DDS_FLAGS_NONE);
+    DdsLayout layout;
+    CHECK(layout.Parse(dds.data(), dds.size()));
+    CHECK_EQ(layout.subresources[0].offset, kHeaderSize + kDx10HeaderSize);
+    CHECK_EQ(layout.metadata.mipLevels, 3u);
+    CHECK_EQ(layout.metadata.arraySize, 2u);
+    CHECK_EQ(layout.subresources.size(), 6u);
+    // 64x64 の BC1 は 16x16 ブロック、1ブロック 8 バイト
+    CHECK_EQ(layout.subresources[0].rowPitch, 16u * 8u);
+    CHECK_EQ(layout.subresources[0].slicePitch, 16u * 8u * 16u);
+    // 2つ目の要素の最上位ミップは、1つ目の要素の全ミップの後ろ
+    CHECK_EQ(layout.subresources[3].slicePitch, layout.subresources[0].slicePitch);
+    CHECK_EQ(layout.subresources[3].offset, layout.subresources[2].offset + layout.subresources[2].slicePitch);
+}
+
+TEST(RejectsTruncatedData) {
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_BC1_UNORM, 64, 64, 1, 0, DirectX::DDS_FLAGS_FORCE_DX10_EXT);
+    DdsLayout layout;
+    // ヘッダーの途中で切れている
+    CHECK(!layout.Parse(dds.data(), kHeaderSize - 1));
+    CHECK(!layout.Parse(dds.data(), 3));
+    // 拡張ヘッダーの途中で切れている
+    CHECK(!layout.Parse(dds.data(), kHeaderSize + kDx10HeaderSize - 1));
+    // ピクセルが1バイト足りない
+    CHECK(!layout.Parse(dds.data(), dds.size() - 1));
+    CHECK(layout.subresources.empty());
+
+    // マジックが違う
+    std::vector<uint8_t> broken = dds;
+    broken[0] = 'X';
+    CHECK(!layout.Parse(broken.data(), broken.size()));
+
+    CHECK(layout.Parse(dds.data(), dds.size()));
+}
+
+TEST(RejectsLegacyUncompressed) {
+    // 拡張ヘッダーの無い非圧縮の形式は、読み込み時に変換が要るものがあるので使わない
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_R8G8B8A8_UNORM, 16, 16, 1, 1, DirectX::DDS_FLAGS_NONE);
+    DdsLayout layout;
+    CHECK(!layout.Parse(dds.data(), dds.size()));
+}
+
+TEST(BlockCompressedSizeMustBeMultipleOfFour) {
+    DirectX::TexMetadata metadata{};
+    metadata.depth = 1;
+    metadata.arraySize = 1;
+    metadata.mipLevels = 1;
+    metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+
+    metadata.format = DXGI_FORMAT_BC1_UNORM;
+    metadata.width = 64;
+    metadata.height = 64;
+    CHECK(DdsLayout::HasValidBlockSize(metadata));
+    metadata.width = 66;
+    CHECK(!DdsLayout::HasValidBlockSize(metadata));
+    metadata.format = DXGI_FORMAT_BC7_UNORM;
+    metadata.width = 60;
+    metadata.height = 62;
+    CHECK(!DdsLayout::HasValidBlockSize(metadata));
+    metadata.width = 2;
+    metadata.height = 2;
+    CHECK(!DdsLayout::HasValidBlockSize(metadata));
+
+    // 非圧縮の形式は何でもよい
+    metadata.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    metadata.width = 66;
+    metadata.height = 65;
+    CHECK(DdsLayout::HasValidBlockSize(metadata));
+
+    // 4 の倍数でない BC のファイルは Parse も受け付けない（小さいミップは 4 未満でよい）
+    std::vector<uint8_t> dds = MakeDds(DXGI_FORMAT_BC7_UNORM, 66, 64, 1, 1, DirectX::DDS_FLAGS_FORCE_DX10_EXT);
+    DdsLayout layout;
+    CHECK(!layout.Parse(dds.data(), dds.size()));
+    dds = MakeDds(DXGI_FORMAT_BC7_UNORM, 64, 64, 1, 0, DirectX::DDS_FLAGS_FORCE_DX10_EXT);
+    CHECK(layout.Parse(dds.data(), dds.size()));
+}
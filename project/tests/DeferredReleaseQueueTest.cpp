@@ -0,0 +1,50 @@
+#include "DeferredReleaseQueue.h"
+#include "TestFramework.h"
+#include <vector>
+
+TEST(ReleasesOnlyCompletedFences) {
+    DeferredReleaseQueue queue;
+    std::vector<int> released;
+    queue.Push(1, 100, [&] { released.push_back(1); });
+    queue.Push(2, 200, [&] { released.push_back(2); });
+    queue.Push(2, 50, [&] { released.push_back(3); });
+    queue.Push(4, 10, [&] { released.push_back(4); });
+    CHECK_EQ(queue.GetOldestFenceValue(), 1u);
+
+    queue.Process(0);
+    CHECK(released.empty());
+
+    queue.Process(2);
+    CHECK_EQ(released, (std::vector<int>{ 1, 2, 3 }));
+    CHECK_EQ(queue.GetPendingCount(), 1u);
+    CHECK_EQ(queue.GetOldestFenceValue(), 4u);
+
+    queue.Process(10);
+    CHECK_EQ(released, (std::vector<int>{ 1, 2, 3, 4 }));
+    CHECK_EQ(queue.GetOldestFenceValue(), 0u);
+}
+
+TEST(TracksPendingAndReleasedBytes) {
+    DeferredReleaseQueue queue;
+    queue.Push(1, 100, [] {});
+    queue.Push(2, 200, [] {});
+    const DeferredReleaseQueue::Stats& stats = queue.GetStats();
+    CHECK_EQ(stats.pendingCount, 2u);
+    CHECK_EQ(stats.pendingBytes, 300u);
+    CHECK_EQ(stats.peakPendingBytes, 300u);
+
+    queue.Process(1);
+    CHECK_EQ(stats.pendingCount, 1u);
+    CHECK_EQ(stats.pendingBytes, 200u);
+    CHECK_EQ(stats.releasedCount, 1u);
+    CHECK_EQ(stats.releasedBytes, 100u);
+
+    queue.Push(3, 50, [] {});
+    queue.Process(3);
+    CHECK_EQ(stats.pendingCount, 0u);
+    CHECK_EQ(stats.pendingBytes, 0u);
+    // ピークは一番多かったときのまま
+    CHECK_EQ(stats.peakPendingBytes, 300u);
+    CHECK_EQ(stats.releasedCount, 3u);
+    CHECK_EQ(stats.releasedBytes, 350u);
+}
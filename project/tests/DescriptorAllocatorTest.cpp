@@ -0,0 +1,49 @@
+#include "DescriptorAllocator.h"
+#include "TestFramework.h"
+
+TEST(LaysOutPersistentThenTransientRegions) {
+    DescriptorAllocator allocator;
+    allocator.Initialize(4, 3, 2);
+    CHECK_EQ(allocator.GetCapacity(), 10u);
+}
+
+TEST(ReusesFreedPersistentIndicesLastInFirst) {
+    DescriptorAllocator allocator;
+    allocator.Initialize(4, 3, 2);
+    uint32_t indices[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        indices[i] = allocator.AllocatePersistent();
+        CHECK_EQ(indices[i], i);
+    }
+    // 常駐領域は使い切った
+    CHECK_EQ(allocator.AllocatePersistent(), DescriptorAllocator::kInvalidIndex);
+
+    allocator.FreePersistent(indices[1]);
+    allocator.FreePersistent(indices[2]);
+    CHECK_EQ(allocator.GetStats().persistentUsed, 2u);
+    CHECK_EQ(allocator.AllocatePersistent(), 2u);
+    CHECK_EQ(allocator.AllocatePersistent(), 1u);
+    CHECK_EQ(allocator.GetStats().persistentUsed, 4u);
+    CHECK_EQ(allocator.GetStats().persistentPeak, 4u);
+}
+
+TEST(TransientRegionsArePerFrame) {
+    DescriptorAllocator allocator;
+    allocator.Initialize(4, 3, 2);
+
+    allocator.BeginFrame(0);
+    CHECK_EQ(allocator.AllocateTransient(2), 4u);
+    CHECK_EQ(allocator.AllocateTransient(1), 6u);
+    CHECK_EQ(allocator.GetStats().transientUsed, 3u);
+    // フレームの一時領域を使い切った
+    CHECK_EQ(allocator.AllocateTransient(1), DescriptorAllocator::kInvalidIndex);
+
+    // フレーム 1 はフレーム 0 の後ろ
+    allocator.BeginFrame(1);
+    CHECK_EQ(allocator.GetStats().transientUsed, 0u);
+    CHECK_EQ(allocator.AllocateTransient(3), 7u);
+
+    // フレーム 0 に戻ると先頭から積み直す
+    allocator.BeginFrame(0);
+    CHECK_EQ(allocator.AllocateTransient(), 4u);
+}
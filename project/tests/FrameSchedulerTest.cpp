@@ -0,0 +1,104 @@
+#include "FrameScheduler.h"
+#include "TestFramework.h"
+#include <deque>
+
+namespace {
+    // GPU の代わり。Signal を積んでおき、待たれたときにその値まで順に完了させる
+    class SimulatedQueue : public FrameScheduler::Queue {
+    public:
+        void Signal(uint64_t fenceValue) override { pending_.push_back(fenceValue); }
+        uint64_t GetCompletedFenceValue() override { return completed; }
+        void WaitForFenceValue(uint64_t fenceValue) override {
+            waitedValues.push_back(fenceValue);
+            while (completed < fenceValue && !pending_.empty()) {
+                completed = pending_.front();
+                pending_.pop_front();
+            }
+        }
+        // GPU が発行済みのフレームをすべて終えた状態にする
+        void CompleteAll() {
+            if (!pending_.empty()) {
+                completed = pending_.back();
+                pending_.clear();
+            }
+        }
+
+        uint64_t completed = 0;
+        std::vector<uint64_t> waitedValues;
+
+    private:
+        std::deque<uint64_t> pending_;
+    };
+}
+
+TEST(CyclesSlotsAndWaitsOnlyForReusedSlot) {
+    SimulatedQueue queue;
+    FrameScheduler scheduler;
+    scheduler.Initialize(&queue, 2);
+
+    CHECK_EQ(scheduler.BeginFrame(), 0u);
+    CHECK_EQ(scheduler.EndFrame(), 1u);
+    // スロット 1 はまだ使われていないので待たない
+    CHECK_EQ(scheduler.BeginFrame(), 1u);
+    CHECK(queue.waitedValues.empty());
+    CHECK_EQ(scheduler.EndFrame(), 2u);
+    // スロット 0 に戻るので、フレーム 1 だけを待つ（フレーム 2 は待たない）
+    CHECK_EQ(scheduler.BeginFrame(), 0u);
+    CHECK_EQ(queue.waitedValues, (std::vector<uint64_t>{ 1 }));
+    CHECK_EQ(queue.completed, 1u);
+}
+
+TEST(DoesNotWaitWhenGpuIsAhead) {
+    SimulatedQueue queue;
+    FrameScheduler scheduler;
+    scheduler.Initialize(&queue, 3);
+    for (int frame = 0; frame < 10; ++frame) {
+        scheduler.BeginFrame();
+        scheduler.EndFrame();
+        // GPU がすぐに追いつく場合
+        queue.CompleteAll();
+    }
+    CHECK(queue.waitedValues.empty());
+}
+
+TEST(RetiresAfterFrameCompletes) {
+    SimulatedQueue queue;
+    FrameScheduler scheduler;
+    scheduler.Initialize(&queue, 2);
+
+    int released = 0;
+    scheduler.BeginFrame();
+    scheduler.Retire([&] { ++released; }, 64);
+    CHECK_EQ(scheduler.GetPendingRetireCount(), 1u);
+    scheduler.EndFrame();
+
+    scheduler.BeginFrame();
+    // フレーム 1 はまだ完了していない
+    CHECK_EQ(released, 0);
+    scheduler.EndFrame();
+
+    // スロット 0 の再利用でフレーム 1 を待ち、そこで解放される
+    scheduler.BeginFrame();
+    CHECK_EQ(released, 1);
+    CHECK_EQ(scheduler.GetRetireStats().releasedBytes, 64u);
+}
+
+TEST(WaitForIdleReleasesEverything) {
+    SimulatedQueue queue;
+    FrameScheduler scheduler;
+    scheduler.Initialize(&queue, 2);
+
+    int released = 0;
+    for (int frame = 0; frame < 5; ++frame) {
+        scheduler.BeginFrame();
+        scheduler.Retire([&] { ++released; });
+        scheduler.EndFrame();
+    }
+    // 今のフレームに預けた分も含めてすべて解放される
+    scheduler.BeginFrame();
+    scheduler.Retire([&] { ++released; });
+    scheduler.WaitForIdle();
+    CHECK_EQ(released, 6);
+    CHECK_EQ(scheduler.GetPendingRetireCount(), 0u);
+    CHECK_EQ(queue.completed, scheduler.GetLastSignaledFenceValue());
+}
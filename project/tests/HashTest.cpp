@@ -0,0 +1,43 @@
+#include "Hash.h"
+#include "TestFramework.h"
+#include <cstring>
+#include <vector>
+
+TEST(MatchesReferenceValues) {
+    // xxHash の公式実装の値
+    CHECK_EQ(Hash::XXH64("", 0), 0xEF46DB3751D8E999ull);
+    CHECK_EQ(Hash::XXH64("a", 1), 0xD24EC4F1A98C6E5Bull);
+    CHECK_EQ(Hash::XXH64("abc", 3), 0x44BC2CF5AD770999ull);
+}
+
+TEST(SeedChangesResult) {
+    const char* text = "The quick brown fox jumps over the lazy dog";
+    size_t length = std::strlen(text);
+    CHECK(Hash::XXH64(text, length, 0) != Hash::XXH64(text, length, 1));
+    CHECK_EQ(Hash::XXH64(text, length, 7), Hash::XXH64(text, length, 7));
+}
+
+TEST(IgnoresAlignmentOfInput) {
+    // 32 バイト単位の本体と端数の両方を通る長さを、ずらした位置から読む
+    std::vector<uint8_t> data(1024 + 8);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 131 + 7);
+    }
+    for (size_t length : { size_t(31), size_t(32), size_t(33), size_t(100), size_t(1024) }) {
+        std::vector<uint8_t> copy(length + 8);
+        for (size_t shift = 1; shift < 8; ++shift) {
+            std::memcpy(copy.data() + shift, data.data(), length);
+            CHECK_EQ(Hash::XXH64(copy.data() + shift, length), Hash::XXH64(data.data(), length));
+        }
+    }
+}
+
+TEST(DetectsSingleBitChange) {
+    std::vector<uint8_t> data(4096, 0x5a);
+    uint64_t original = Hash::XXH64(data.data(), data.size());
+    for (size_t position : { size_t(0), size_t(31), size_t(2048), size_t(4095) }) {
+        data[position] ^= 1;
+        CHECK(Hash::XXH64(data.data(), data.size()) != original);
+        data[position] ^= 1;
+    }
+}
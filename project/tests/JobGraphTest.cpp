@@ -0,0 +1,73 @@
+#include "JobGraph.h"
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <atomic>
+#include <mutex>
+
+namespace {
+    // ひし形の依存関係 a → (b, c) → d の順序を確かめる
+    void CheckDiamond(ThreadPool* threadPool) {
+        JobGraph graph;
+        std::mutex mutex;
+        std::vector<std::string> order;
+        auto record = [&](const char* name) {
+            return [&, name] {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(name);
+            };
+        };
+        JobGraph::JobId a = graph.Add("a", record("a"));
+        JobGraph::JobId b = graph.Add("b", record("b"), { a });
+        JobGraph::JobId c = graph.Add("c", record("c"), { a });
+        graph.Add("d", record("d"), { b, c });
+        graph.Run(threadPool);
+
+        CHECK_EQ(order.size(), 4u);
+        if (order.size() == 4) {
+            CHECK_EQ(order[0], "a");
+            CHECK(order[1] != "d" && order[2] != "d");
+            CHECK_EQ(order[3], "d");
+        }
+        CHECK_EQ(graph.GetTimings().size(), 4u);
+        CHECK(graph.GetTotalMs() >= 0.0);
+    }
+}
+
+TEST(RunsInDependencyOrderWithoutPool) {
+    CheckDiamond(nullptr);
+}
+
+TEST(RunsInDependencyOrderWithPool) {
+    ThreadPool threadPool;
+    threadPool.Initialize(4);
+    for (int i = 0; i < 50; ++i) {
+        CheckDiamond(&threadPool);
+    }
+}
+
+TEST(RunsManyIndependentJobs) {
+    ThreadPool threadPool;
+    threadPool.Initialize(3);
+    JobGraph graph;
+    std::atomic<int> count = 0;
+    std::vector<JobGraph::JobId> leaves;
+    for (int i = 0; i < 200; ++i) {
+        leaves.push_back(graph.Add("leaf", [&] { ++count; }));
+    }
+    // すべての葉を待つ仕事
+    int countAtEnd = -1;
+    graph.Add("join", [&] { countAtEnd = count; }, leaves);
+    graph.Run(&threadPool);
+    CHECK_EQ(count.load(), 200);
+    CHECK_EQ(countAtEnd, 200);
+}
+
+TEST(ReportListsEveryJob) {
+    JobGraph graph;
+    graph.Add("compileVS", [] {});
+    graph.Add("compilePS", [] {});
+    graph.Run(nullptr);
+    std::string report = graph.BuildReport();
+    CHECK(report.find("compileVS") != std::string::npos);
+    CHECK(report.find("compilePS") != std::string::npos);
+}
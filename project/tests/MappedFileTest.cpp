@@ -0,0 +1,83 @@
+#include "MappedFile.h"
+#include "TestFramework.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    // テストごとの一時フォルダ（終わったら消す）
+    class TemporaryDirectory {
+    public:
+        TemporaryDirectory() {
+            auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+            path_ = std::filesystem::temp_directory_path() / ("MappedFileTest_" + std::to_string(ticks));
+            std::filesystem::create_directories(path_);
+        }
+        ~TemporaryDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path_, error);
+        }
+        const std::filesystem::path& GetPath() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    void WriteBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+    }
+}
+
+TEST(MapsFileContents) {
+    TemporaryDirectory directory;
+    std::filesystem::path path = directory.GetPath() / "data.bin";
+    // ページの境目をまたぐ大きさ
+    std::vector<uint8_t> bytes(10000);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = uint8_t(i * 31 + 7);
+    }
+    WriteBytes(path, bytes);
+
+    MappedFile mappedFile;
+    CHECK(mappedFile.Open(path));
+    CHECK(mappedFile.IsOpen());
+    CHECK_EQ(mappedFile.GetSize(), bytes.size());
+    CHECK(mappedFile.GetData() && std::memcmp(mappedFile.GetData(), bytes.data(), bytes.size()) == 0);
+
+    // ムーブすると元は閉じた状態になる
+    MappedFile moved = std::move(mappedFile);
+    CHECK(!mappedFile.IsOpen());
+    CHECK(moved.IsOpen());
+    CHECK_EQ(moved.GetSize(), bytes.size());
+
+    moved.Close();
+    CHECK(!moved.IsOpen());
+    CHECK_EQ(moved.GetSize(), 0u);
+}
+
+TEST(EmptyFileFailsToOpen) {
+    TemporaryDirectory directory;
+    std::filesystem::path path = directory.GetPath() / "empty.bin";
+    WriteBytes(path, {});
+
+    MappedFile mappedFile;
+    CHECK(!mappedFile.Open(path));
+    CHECK(!mappedFile.IsOpen());
+    CHECK(mappedFile.GetData() == nullptr);
+    CHECK_EQ(mappedFile.GetSize(), 0u);
+}
+
+TEST(MissingFileFailsToOpen) {
+    TemporaryDirectory directory;
+    MappedFile mappedFile;
+    CHECK(!mappedFile.Open(directory.GetPath() / "missing.bin"));
+    CHECK(!mappedFile.IsOpen());
+
+    // 開いていたものは失敗した Open で閉じられる
+    std::filesystem::path path = directory.GetPath() / "data.bin";
+    WriteBytes(path, { 1, 2, 3 });
+    CHECK(mappedFile.Open(path));
+    CHECK(!mappedFile.Open(directory.GetPath() / "missing.bin"));
+    CHECK(!mappedFile.IsOpen());
+}
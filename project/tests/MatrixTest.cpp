@@ -0,0 +1,193 @@
+#include "Matrix.h"
+#include "MathConstexpr.h"
+#include "TestFramework.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    void CheckMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float epsilon) {
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                CHECK_NEAR(actual.m[row][column], expected.m[row][column], epsilon);
+            }
+        }
+    }
+
+    // 拡大縮小・回転・平行移動を乱数で作る
+    struct RandomTransform {
+        explicit RandomTransform(uint32_t seed) : random(seed) {}
+
+        Vector3 NextScale() { return { scale(random), scale(random), scale(random) }; }
+        Vector3 NextRotate() { return { angle(random), angle(random), angle(random) }; }
+        Vector3 NextVector() { return { value(random), value(random), value(random) }; }
+        Matrix4x4 NextAffine() { return MatrixMath::MakeAffineMatrix(NextScale(), NextRotate(), NextVector()); }
+        Matrix4x4 NextRigid() { return MatrixMath::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, NextRotate(), NextVector()); }
+
+        std::mt19937 random;
+        std::uniform_real_distribution<float> scale{ 0.5f, 2.0f };
+        std::uniform_real_distribution<float> angle{ -3.14159f, 3.14159f };
+        std::uniform_real_distribution<float> value{ -10.0f, 10.0f };
+    };
+
+    // 透視投影を含む変換（w で割る経路を通す）
+    Matrix4x4 MakeViewProjection(RandomTransform& randomTransform) {
+        Matrix4x4 view = MatrixMath::InverseRigid(randomTransform.NextRigid());
+        Matrix4x4 projection = MatrixMath::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+        return MatrixMath::Multiply(view, projection);
+    }
+
+    // 4次元の乱数の直交行列（6つの平面の回転を掛け合わせる）
+    Matrix4x4 MakeRandomOrthogonal(RandomTransform& randomTransform) {
+        Matrix4x4 result = MatrixMath::MakeIdentity4x4();
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i + 1; j < 4; ++j) {
+                float angle = randomTransform.angle(randomTransform.random);
+                Matrix4x4 rotate = MatrixMath::MakeIdentity4x4();
+                rotate.m[i][i] = std::cos(angle);
+                rotate.m[i][j] = std::sin(angle);
+                rotate.m[j][i] = -std::sin(angle);
+                rotate.m[j][j] = std::cos(angle);
+                result = MatrixMath::Multiply(result, rotate);
+            }
+        }
+        return result;
+    }
+
+    // 特異値が 1, 0.5, 0.25, smallest の行列（条件数は 1 / smallest）
+    // 4列目も (0,0,0,1) にならない一般の行列なので、Inverse の余因子の経路を通る
+    Matrix4x4 MakeIllConditioned(RandomTransform& randomTransform, float smallest) {
+        Matrix4x4 singularValues = MatrixMath::MakeIdentity4x4();
+        singularValues.m[1][1] = 0.5f;
+        singularValues.m[2][2] = 0.25f;
+        singularValues.m[3][3] = smallest;
+        Matrix4x4 matrix = MatrixMath::Multiply(MakeRandomOrthogonal(randomTransform), singularValues);
+        return MatrixMath::Multiply(matrix, MakeRandomOrthogonal(randomTransform));
+    }
+
+    // SIMD 版とスカラー版を乱数で比べる回数。-DENGINE_TESTS_LONG=ON のときは数百万回まわす
+#if defined(ENGINE_TESTS_LONG)
+    constexpr int kSimdSampleCount = 4000000;
+#else
+    constexpr int kSimdSampleCount = 20000;
+#endif
+}
+
+TEST(SimdMatchesScalar) {
+    RandomTransform randomTransform(1);
+    for (int i = 0; i < kSimdSampleCount; ++i) {
+        Vector3 scale = randomTransform.NextScale();
+        Vector3 rotate = randomTransform.NextRotate();
+        Vector3 translate = randomTransform.NextVector();
+        Matrix4x4 affine = MatrixMath::MakeAffineMatrix(scale, rotate, translate);
+        CheckMatrixNear(affine, MatrixMath::Scalar::MakeAffineMatrix(scale, rotate, translate), 1.0e-5f);
+
+        Matrix4x4 other = randomTransform.NextAffine();
+        CheckMatrixNear(MatrixMath::Multiply(affine, other), MatrixMath::Scalar::Multiply(affine, other), 1.0e-4f);
+        CheckMatrixNear(MatrixMath::Inverse(affine), MatrixMath::Scalar::Inverse(affine), 1.0e-3f);
+
+        Vector3 point = randomTransform.NextVector();
+        Vector3 simd = MatrixMath::Transform(point, affine);
+        Vector3 scalar = MatrixMath::Scalar::Transform(point, affine);
+        CHECK_NEAR(simd.x, scalar.x, 1.0e-4f);
+        CHECK_NEAR(simd.y, scalar.y, 1.0e-4f);
+        CHECK_NEAR(simd.z, scalar.z, 1.0e-4f);
+    }
+}
+
+TEST(InverseTimesMatrixIsIdentity) {
+    RandomTransform randomTransform(2);
+    Matrix4x4 identity = MatrixMath::MakeIdentity4x4();
+    for (int i = 0; i < 100; ++i) {
+        Matrix4x4 matrix = MakeViewProjection(randomTransform);
+        CheckMatrixNear(MatrixMath::Multiply(matrix, MatrixMath::Inverse(matrix)), identity, 1.0e-3f);
+    }
+}
+
+TEST(IllConditionedInverseTimesMatrixIsIdentity) {
+    RandomTransform randomTransform(5);
+    Matrix4x4 identity = MatrixMath::MakeIdentity4x4();
+    // 誤差は条件数に比例して増えるので、許容値もそれに合わせる
+    for (float smallest : { 1.0e-2f, 1.0e-3f, 1.0e-4f }) {
+        for (int i = 0; i < 1000; ++i) {
+            Matrix4x4 matrix = MakeIllConditioned(randomTransform, smallest);
+            CheckMatrixNear(MatrixMath::Multiply(matrix, MatrixMath::Inverse(matrix)), identity, 1.0e-6f / smallest);
+        }
+    }
+}
+
+TEST(SpecializedInversesMatchGeneralInverse) {
+    RandomTransform randomTransform(3);
+    for (int i = 0; i < 100; ++i) {
+        Matrix4x4 affine = randomTransform.NextAffine();
+        CheckMatrixNear(MatrixMath::InverseAffine(affine), MatrixMath::Scalar::Inverse(affine), 1.0e-4f);
+        Matrix4x4 rigid = randomTransform.NextRigid();
+        CheckMatrixNear(MatrixMath::InverseRigid(rigid), MatrixMath::Scalar::Inverse(rigid), 1.0e-4f);
+    }
+}
+
+TEST(BatchedTransformMatchesSingleTransform) {
+    RandomTransform randomTransform(4);
+    // SIMD の幅で割り切れない数も試す
+    for (size_t count : { size_t(0), size_t(1), size_t(3), size_t(8), size_t(17), size_t(1001) }) {
+        std::vector<Vector3> points(count);
+        for (Vector3& point : points) {
+            point = randomTransform.NextVector();
+        }
+        std::vector<float> x(count), y(count), z(count);
+        Vector3SoA out = { x.data(), y.data(), z.data() };
+
+        Matrix4x4 viewProjection = MakeViewProjection(randomTransform);
+        MatrixMath::TransformPoints(points, viewProjection, out);
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 expected = MatrixMath::Scalar::Transform(points[i], viewProjection);
+            CHECK_NEAR(x[i], expected.x, 1.0e-3f * (1.0f + std::fabs(expected.x)));
+            CHECK_NEAR(y[i], expected.y, 1.0e-3f * (1.0f + std::fabs(expected.y)));
+            CHECK_NEAR(z[i], expected.z, 1.0e-3f * (1.0f + std::fabs(expected.z)));
+        }
+
+        Matrix4x4 affine = randomTransform.NextAffine();
+        MatrixMath::TransformAffinePoints(points, affine, out);
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 expected = MatrixMath::Scalar::Transform(points[i], affine);
+            CHECK_NEAR(x[i], expected.x, 1.0e-4f * (1.0f + std::fabs(expected.x)));
+            CHECK_NEAR(y[i], expected.y, 1.0e-4f * (1.0f + std::fabs(expected.y)));
+            CHECK_NEAR(z[i], expected.z, 1.0e-4f * (1.0f + std::fabs(expected.z)));
+        }
+
+        // SoA から SoA へ、入力と同じ配列に書き出す
+        std::vector<float> x2 = x, y2 = y, z2 = z;
+        Matrix4x4 second = randomTransform.NextAffine();
+        MatrixMath::TransformAffinePoints(ConstVector3SoA{ x2.data(), y2.data(), z2.data() }, count, second, Vector3SoA{ x2.data(), y2.data(), z2.data() });
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 expected = MatrixMath::Scalar::Transform({ x[i], y[i], z[i] }, second);
+            CHECK_NEAR(x2[i], expected.x, 1.0e-4f * (1.0f + std::fabs(expected.x)));
+            CHECK_NEAR(y2[i], expected.y, 1.0e-4f * (1.0f + std::fabs(expected.y)));
+            CHECK_NEAR(z2[i], expected.z, 1.0e-4f * (1.0f + std::fabs(expected.z)));
+        }
+
+        std::vector<float> x3 = x, y3 = y, z3 = z;
+        MatrixMath::TransformPoints(ConstVector3SoA{ x3.data(), y3.data(), z3.data() }, count, viewProjection, Vector3SoA{ x3.data(), y3.data(), z3.data() });
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 expected = MatrixMath::Scalar::Transform({ x[i], y[i], z[i] }, viewProjection);
+            CHECK_NEAR(x3[i], expected.x, 1.0e-3f * (1.0f + std::fabs(expected.x)));
+            CHECK_NEAR(y3[i], expected.y, 1.0e-3f * (1.0f + std::fabs(expected.y)));
+            CHECK_NEAR(z3[i], expected.z, 1.0e-3f * (1.0f + std::fabs(expected.z)));
+        }
+    }
+}
+
+TEST(ConstexprMatchesRuntime) {
+    RandomTransform randomTransform(5);
+    for (int i = 0; i < 50; ++i) {
+        Matrix4x4 a = randomTransform.NextAffine();
+        Matrix4x4 b = randomTransform.NextAffine();
+        CheckMatrixNear(MathConstexpr::Multiply(a, b), MatrixMath::Scalar::Multiply(a, b), 1.0e-4f);
+        Vector3 point = randomTransform.NextVector();
+        Vector3 constexprResult = MathConstexpr::Transform(point, a);
+        Vector3 runtimeResult = MatrixMath::Scalar::Transform(point, a);
+        CHECK_NEAR(constexprResult.x, runtimeResult.x, 1.0e-4f);
+        CHECK_NEAR(constexprResult.y, runtimeResult.y, 1.0e-4f);
+        CHECK_NEAR(constexprResult.z, runtimeResult.z, 1.0e-4f);
+    }
+}
@@ -0,0 +1,199 @@
+#include "ModelLoader.h"
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+    bool Parse(const std::string& text, ModelLoader::ModelData& model, ThreadPool* threadPool = nullptr) {
+        return ModelLoader::Parse(text.data(), text.size(), ".", model, threadPool);
+    }
+
+    // 大きな OBJ を作る（gridSize x gridSize の四角形の格子。途中でオブジェクトとマテリアルを切り替える）
+    std::string MakeGridObj(uint32_t gridSize) {
+        std::string text = "# generated\n";
+        char line[128];
+        for (uint32_t y = 0; y <= gridSize; ++y) {
+            for (uint32_t x = 0; x <= gridSize; ++x) {
+                std::snprintf(line, sizeof(line), "v %f %f %f\nvt %f %f\n",
+                    x * 0.25f, y * 0.25f, (x ^ y) * 0.001f, float(x) / gridSize, float(y) / gridSize);
+                text += line;
+            }
+        }
+        text += "vn 0.0 0.0 1.0\n";
+        for (uint32_t y = 0; y < gridSize; ++y) {
+            if (y % 64 == 0) {
+                std::snprintf(line, sizeof(line), "o Row%u\nusemtl Material%u\n", y, y % 3);
+                text += line;
+            }
+            for (uint32_t x = 0; x < gridSize; ++x) {
+                uint32_t i0 = y * (gridSize + 1) + x + 1;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + gridSize + 2;
+                uint32_t i3 = i0 + gridSize + 1;
+                std::snprintf(line, sizeof(line), "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", i0, i0, i1, i1, i2, i2, i3, i3);
+                text += line;
+            }
+        }
+        return text;
+    }
+}
+
+TEST(ConvertsToLeftHandedIndexedTriangles) {
+    ModelLoader::ModelData model;
+    CHECK(Parse(
+        "o Plane\n"
+        "v -1.0 -1.0 0.0\nv 1.0 -1.0 0.0\nv -1.0 1.0 0.0\nv 1.0 1.0 0.0\n"
+        "vt 1.0 0.0\nvt 0.0 1.0\nvt 0.0 0.0\nvt 1.0 1.0\n"
+        "vn 0.0 0.0 1.0\n"
+        "f 2/1/1 3/2/1 1/3/1\n"
+        "f 2/1/1 4/4/1 3/2/1\n", model));
+
+    // 同じ v/vt/vn の組はまとめる
+    CHECK_EQ(model.vertices.size(), 4u);
+    CHECK_EQ(model.indices.size(), 6u);
+    CHECK_EQ(model.meshes.size(), 1u);
+    CHECK_EQ(model.meshes[0].name, "Plane");
+
+    // 最初の三角形は向きを逆にするので 1 → 3 → 2 の順
+    const ModelLoader::Vertex& first = model.vertices[model.indices[0]];
+    CHECK_EQ(first.position.x, 1.0f);
+    CHECK_EQ(first.position.y, -1.0f);
+    CHECK_EQ(first.texcoord.y, 1.0f);
+    CHECK_EQ(first.normal.x, -0.0f);
+    CHECK_EQ(first.normal.z, 1.0f);
+    const ModelLoader::Vertex& last = model.vertices[model.indices[2]];
+    // x を反転、v を上下反転
+    CHECK_EQ(last.position.x, -1.0f);
+    CHECK_EQ(last.texcoord.x, 1.0f);
+    CHECK_EQ(last.texcoord.y, 1.0f);
+    CHECK_EQ(last.position.w, 1.0f);
+}
+
+TEST(SplitsPolygonsIntoFans) {
+    ModelLoader::ModelData model;
+    CHECK(Parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv -1 1 0\nf 1 2 3 4 5\n", model));
+    CHECK_EQ(model.indices.size(), 9u);
+}
+
+TEST(ResolvesNegativeIndices) {
+    ModelLoader::ModelData relative;
+    ModelLoader::ModelData absolute;
+    CHECK(Parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\n", relative));
+    CHECK(Parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", absolute));
+    CHECK_EQ(relative.indices, absolute.indices);
+    CHECK_EQ(relative.vertices.size(), absolute.vertices.size());
+}
+
+TEST(RejectsOutOfRangeIndex) {
+    ModelLoader::ModelData model;
+    CHECK(!Parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n", model));
+}
+
+TEST(ParsesMaterials) {
+    const char* mtl =
+        "newmtl Red\nKd 1.0 0.0 0.0\nd 0.5\n"
+        "newmtl Textured\nmap_Kd uvChecker.png\n";
+    std::vector<ModelLoader::Material> materials;
+    CHECK(ModelLoader::ParseMaterials(mtl, std::strlen(mtl), "Resources", materials));
+    CHECK_EQ(materials.size(), 2u);
+    if (materials.size() == 2) {
+        CHECK_EQ(materials[0].name, "Red");
+        CHECK_EQ(materials[0].color.x, 1.0f);
+        CHECK_EQ(materials[0].color.y, 0.0f);
+        CHECK_EQ(materials[0].color.w, 0.5f);
+        CHECK_EQ(materials[1].name, "Textured");
+        CHECK_EQ(std::filesystem::path(materials[1].textureFilePath), std::filesystem::path("Resources") / "uvChecker.png");
+    }
+}
+
+TEST(LoadsResourceModels) {
+    const std::filesystem::path directory = ENGINE_RESOURCES_DIR;
+
+    ModelLoader::ModelData plane;
+    CHECK(ModelLoader::Load(directory / "plane.obj", plane));
+    CHECK_EQ(plane.vertices.size(), 4u);
+    CHECK_EQ(plane.indices.size(), 6u);
+    CHECK_EQ(plane.materials.size(), 1u);
+    CHECK_EQ(plane.meshes.size(), 1u);
+    if (plane.meshes.size() == 1 && plane.materials.size() == 1) {
+        CHECK_EQ(plane.meshes[0].submeshes.size(), 1u);
+        CHECK_EQ(plane.meshes[0].submeshes[0].materialIndex, 0u);
+        CHECK_EQ(std::filesystem::path(plane.materials[0].textureFilePath).filename(), "uvChecker.png");
+    }
+
+    // オブジェクトごと・マテリアルごとに分かれる
+    ModelLoader::ModelData multiMesh;
+    CHECK(ModelLoader::Load(directory / "multiMesh.obj", multiMesh));
+    CHECK_EQ(multiMesh.meshes.size(), 2u);
+
+    ModelLoader::ModelData multiMaterial;
+    CHECK(ModelLoader::Load(directory / "multiMaterial.obj", multiMaterial));
+    CHECK_EQ(multiMaterial.materials.size(), 2u);
+    CHECK_EQ(multiMaterial.meshes.size(), 2u);
+    if (multiMaterial.meshes.size() == 2) {
+        CHECK(multiMaterial.meshes[0].submeshes[0].materialIndex != multiMaterial.meshes[1].submeshes[0].materialIndex);
+    }
+
+    ModelLoader::ModelData missing;
+    CHECK(!ModelLoader::Load(directory / "missing.obj", missing));
+}
+
+TEST(FallsBackToSerialParse) {
+    constexpr size_t kLarge = 8 * 1024 * 1024;
+    CHECK(ModelLoader::ShouldParseInParallel(kLarge, 3, 8));
+    // コアの数がわからないときは、ワーカーの数に任せる
+    CHECK(ModelLoader::ShouldParseInParallel(kLarge, 3, 0));
+    // ワーカーがいない
+    CHECK(!ModelLoader::ShouldParseInParallel(kLarge, 0, 8));
+    // コアが1つ
+    CHECK(!ModelLoader::ShouldParseInParallel(kLarge, 3, 1));
+    // 1チャンクにしかならない
+    CHECK(!ModelLoader::ShouldParseInParallel(64 * 1024, 3, 8));
+    CHECK(!ModelLoader::ShouldParseInParallel(2 * 1024 * 1024 - 1, 3, 8));
+    CHECK(ModelLoader::ShouldParseInParallel(2 * 1024 * 1024, 3, 8));
+
+    // 小さなファイルはプールを渡しても同じ結果になる
+    std::string text = MakeGridObj(16);
+    ModelLoader::ModelData serial;
+    ModelLoader::ModelData pooled;
+    ThreadPool threadPool;
+    threadPool.Initialize(3);
+    CHECK(Parse(text, serial));
+    CHECK(Parse(text, pooled, &threadPool));
+    CHECK_EQ(pooled.indices, serial.indices);
+    CHECK_EQ(pooled.vertices.size(), serial.vertices.size());
+}
+
+TEST(ParallelParseMatchesSerialParse) {
+    // チャンクに分かれる大きさ（1MB 以上）にする
+    std::string text = MakeGridObj(300);
+    CHECK(text.size() > 2 * 1024 * 1024);
+
+    ModelLoader::ModelData serial;
+    CHECK(Parse(text, serial));
+    CHECK_EQ(serial.indices.size(), 300u * 300u * 6u);
+
+    for (uint32_t threadCount : { 1u, 3u, 7u }) {
+        ThreadPool threadPool;
+        threadPool.Initialize(threadCount);
+        ModelLoader::ModelData parallel;
+        CHECK(Parse(text, parallel, &threadPool));
+
+        CHECK_EQ(parallel.indices, serial.indices);
+        CHECK_EQ(parallel.vertices.size(), serial.vertices.size());
+        if (parallel.vertices.size() == serial.vertices.size()) {
+            CHECK(std::memcmp(parallel.vertices.data(), serial.vertices.data(), serial.vertices.size() * sizeof(ModelLoader::Vertex)) == 0);
+        }
+        CHECK_EQ(parallel.meshes.size(), serial.meshes.size());
+        for (size_t i = 0; i < (std::min)(parallel.meshes.size(), serial.meshes.size()); ++i) {
+            CHECK_EQ(parallel.meshes[i].name, serial.meshes[i].name);
+            CHECK_EQ(parallel.meshes[i].submeshes.size(), serial.meshes[i].submeshes.size());
+            for (size_t j = 0; j < (std::min)(parallel.meshes[i].submeshes.size(), serial.meshes[i].submeshes.size()); ++j) {
+                CHECK_EQ(parallel.meshes[i].submeshes[j].indexStart, serial.meshes[i].submeshes[j].indexStart);
+                CHECK_EQ(parallel.meshes[i].submeshes[j].indexCount, serial.meshes[i].submeshes[j].indexCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include "PipelineStateHasher.h"
+#include "TestFramework.h"
+
+TEST(SameContentGivesSameHash) {
+    PipelineStateHasher a;
+    PipelineStateHasher b;
+    for (PipelineStateHasher* hasher : { &a, &b }) {
+        hasher->AddUInt32(3);
+        hasher->AddString("POSITION");
+        hasher->AddFloat(0.5f);
+        hasher->AddBool(true);
+    }
+    CHECK_EQ(a.Finish(), b.Finish());
+    CHECK_EQ(a.GetBytes(), b.GetBytes());
+}
+
+TEST(StoresFixedWidthLittleEndian) {
+    PipelineStateHasher hasher;
+    hasher.AddUInt32(0x01020304);
+    hasher.AddUInt64(0x05);
+    CHECK_EQ(hasher.GetBytes(), (std::vector<uint8_t>{ 4, 3, 2, 1, 5, 0, 0, 0, 0, 0, 0, 0 }));
+}
+
+TEST(NegativeZeroEqualsZero) {
+    PipelineStateHasher positive;
+    PipelineStateHasher negative;
+    positive.AddFloat(0.0f);
+    negative.AddFloat(-0.0f);
+    CHECK_EQ(positive.Finish(), negative.Finish());
+}
+
+TEST(NullStringDiffersFromEmptyString) {
+    PipelineStateHasher nullString;
+    PipelineStateHasher emptyString;
+    nullString.AddString(nullptr);
+    emptyString.AddString("");
+    CHECK(nullString.Finish() != emptyString.Finish());
+}
+
+TEST(LengthPrefixKeepsBoundaries) {
+    // "ab" + "c" と "a" + "bc" は別のもの
+    PipelineStateHasher a;
+    PipelineStateHasher b;
+    a.AddBytes("ab", 2);
+    a.AddBytes("c", 1);
+    b.AddBytes("a", 1);
+    b.AddBytes("bc", 2);
+    CHECK(a.Finish() != b.Finish());
+}
+
+TEST(HashIsStableAcrossBuilds) {
+    // パイプラインライブラリの名前になるので、実装や環境が変わっても同じ値でなければならない
+    // この値が変わるときは DirectXCommon の PipelineLibraryFileHeader::kVersion も上げる
+    PipelineStateHasher hasher;
+    hasher.AddUInt32(3);
+    hasher.AddUInt64(0x0123456789ABCDEFull);
+    hasher.AddBool(true);
+    hasher.AddFloat(0.5f);
+    hasher.AddString("POSITION");
+    const uint8_t bytes[] = { 1, 2, 3, 4 };
+    hasher.AddBytes(bytes, sizeof(bytes));
+    CHECK_EQ(hasher.GetBytes().size(), 44u);
+    CHECK_EQ(hasher.Finish(), 0x29D46417C1C4C950ull);
+}
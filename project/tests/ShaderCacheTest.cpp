@@ -0,0 +1,116 @@
+#include "ShaderCache.h"
+#include "TestFramework.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    // テストごとの一時フォルダ（終わったら消す）
+    class TemporaryDirectory {
+    public:
+        TemporaryDirectory() {
+            auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+            path_ = std::filesystem::temp_directory_path() / ("ShaderCacheTest_" + std::to_string(ticks));
+            std::filesystem::create_directories(path_);
+        }
+        ~TemporaryDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path_, error);
+        }
+        const std::filesystem::path& GetPath() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    void WriteText(const std::filesystem::path& path, const char* text) {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+}
+
+TEST(KeyFollowsIncludedFiles) {
+    TemporaryDirectory directory;
+    std::filesystem::path sourcePath = directory.GetPath() / "Object3d.VS.hlsl";
+    std::filesystem::path includePath = directory.GetPath() / "Object3d.hlsli";
+    WriteText(sourcePath, "#include \"Object3d.hlsli\"\nfloat4 main() : SV_POSITION { return 0; }\n");
+    WriteText(includePath, "struct VertexShaderOutput { float4 position : SV_POSITION; };\n");
+
+    std::vector<std::wstring> arguments = { L"-E", L"main", L"-T", L"vs_6_0" };
+    uint64_t key = ShaderCache::ComputeKey(sourcePath, arguments);
+    CHECK(key != ShaderCache::kInvalidKey);
+    CHECK_EQ(ShaderCache::ComputeKey(sourcePath, arguments), key);
+
+    // .hlsli だけを書き換えても別のキー
+    WriteText(includePath, "struct VertexShaderOutput { float4 position : SV_POSITION; float2 texcoord : TEXCOORD0; };\n");
+    uint64_t changedKey = ShaderCache::ComputeKey(sourcePath, arguments);
+    CHECK(changedKey != key);
+
+    // 引数が変わっても別のキー
+    CHECK(ShaderCache::ComputeKey(sourcePath, { L"-E", L"main", L"-T", L"vs_6_0", L"-O3" }) != changedKey);
+}
+
+TEST(MissingSourceHasNoKey) {
+    TemporaryDirectory directory;
+    CHECK_EQ(ShaderCache::ComputeKey(directory.GetPath() / "missing.hlsl", {}), ShaderCache::kInvalidKey);
+}
+
+TEST(StoresAndLoadsBytecode) {
+    TemporaryDirectory directory;
+    ShaderCache cache;
+    cache.Initialize(directory.GetPath() / "cache");
+    CHECK(cache.IsEnabled());
+
+    const char bytecode[] = "DXBC fake bytecode";
+    MappedFile loaded;
+    CHECK(!cache.Load(42, loaded));
+    CHECK(cache.Store(42, bytecode, sizeof(bytecode)));
+    CHECK(cache.Load(42, loaded));
+    CHECK_EQ(loaded.GetSize(), sizeof(bytecode));
+    CHECK(loaded.IsOpen() && std::memcmp(loaded.GetData(), bytecode, sizeof(bytecode)) == 0);
+    loaded.Close();
+
+    // 無効なキーは保存しない
+    CHECK(!cache.Store(ShaderCache::kInvalidKey, bytecode, sizeof(bytecode)));
+    CHECK_EQ(cache.GetStats().hitCount, 1u);
+    CHECK_EQ(cache.GetStats().missCount, 1u);
+}
+
+TEST(IgnoresIncludesInComments) {
+    TemporaryDirectory directory;
+    std::filesystem::path sourcePath = directory.GetPath() / "Sprite.PS.hlsl";
+    WriteText(sourcePath,
+        "#include \"Used.hlsli\"\n"
+        "// #include \"LineComment.hlsli\"\n"
+        "/* #include \"BlockComment.hlsli\"\n"
+        "   #include <BlockComment2.hlsli> */\n"
+        "float4 main() : SV_TARGET { return 0; } // \"quoted\" /* not a block\n");
+    WriteText(directory.GetPath() / "Used.hlsli", "float4 color;\n");
+    const std::vector<std::wstring> arguments = { L"-E", L"main", L"-T", L"ps_6_0" };
+    uint64_t key = ShaderCache::ComputeKey(sourcePath, arguments);
+    CHECK(key != ShaderCache::kInvalidKey);
+
+    // コメントの中のファイルは作っても書き換えてもキーに影響しない
+    WriteText(directory.GetPath() / "LineComment.hlsli", "a");
+    WriteText(directory.GetPath() / "BlockComment.hlsli", "b");
+    WriteText(directory.GetPath() / "BlockComment2.hlsli", "c");
+    CHECK_EQ(ShaderCache::ComputeKey(sourcePath, arguments), key);
+
+    // コメントの後ろの本物の #include はたどる
+    WriteText(directory.GetPath() / "Used.hlsli", "float4 color2;\n");
+    CHECK(ShaderCache::ComputeKey(sourcePath, arguments) != key);
+}
+
+TEST(AngleIncludesResolveNextToIncludingFile) {
+    TemporaryDirectory directory;
+    std::filesystem::create_directories(directory.GetPath() / "sub");
+    std::filesystem::path sourcePath = directory.GetPath() / "Sprite.VS.hlsl";
+    WriteText(sourcePath, "#include \"sub/Common.hlsli\"\nfloat4 main() : SV_POSITION { return 0; }\n");
+    // <...> もインクルード元（sub）のフォルダから探す
+    WriteText(directory.GetPath() / "sub" / "Common.hlsli", "#include <Math.hlsli>\n");
+    WriteText(directory.GetPath() / "sub" / "Math.hlsli", "float Square(float x) { return x * x; }\n");
+    uint64_t key = ShaderCache::ComputeKey(sourcePath, {});
+
+    WriteText(directory.GetPath() / "sub" / "Math.hlsli", "float Square(float x) { return x * x * 1.0f; }\n");
+    CHECK(ShaderCache::ComputeKey(sourcePath, {}) != key);
+}
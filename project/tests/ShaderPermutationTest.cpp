@@ -0,0 +1,113 @@
+#include "ShaderCache.h"
+#include "ShaderPermutation.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+namespace {
+    // テストごとの一時フォルダ（終わったら消す）
+    class TemporaryDirectory {
+    public:
+        TemporaryDirectory() {
+            auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+            path_ = std::filesystem::temp_directory_path() / ("ShaderPermutationTest_" + std::to_string(ticks));
+            std::filesystem::create_directories(path_);
+        }
+        ~TemporaryDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path_, error);
+        }
+        const std::filesystem::path& GetPath() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    // DirectXCommon::CompileShader と同じ並びの引数（Debug 以外）
+    std::vector<std::wstring> BuildArguments(const std::filesystem::path& sourcePath, uint32_t features) {
+        std::vector<std::wstring> arguments = { sourcePath.wstring(), L"-E", L"main", L"-T", L"ps_6_0", L"-O3", L"-Zpr" };
+        std::vector<std::wstring> defines = ShaderPermutation::BuildDefineArguments(features);
+        arguments.insert(arguments.end(), defines.begin(), defines.end());
+        return arguments;
+    }
+}
+
+TEST(BuildsDefinesInBitOrder) {
+    CHECK(ShaderPermutation::BuildDefineArguments(ShaderFeature::kNone).empty());
+    std::vector<std::wstring> arguments = ShaderPermutation::BuildDefineArguments(ShaderFeature::kUvTransform | ShaderFeature::kLighting);
+    CHECK_EQ(arguments, (std::vector<std::wstring>{ L"-D", L"LIGHTING=1", L"-D", L"UV_TRANSFORM=1" }));
+}
+
+TEST(EnumeratesSubsetsInAscendingOrder) {
+    CHECK_EQ(ShaderPermutation::EnumerateVariants(ShaderFeature::kNone), (std::vector<uint32_t>{ 0 }));
+    uint32_t supported = ShaderFeature::kLighting | ShaderFeature::kUvTransform;
+    CHECK_EQ(ShaderPermutation::EnumerateVariants(supported), (std::vector<uint32_t>{ 0, 1, 4, 5 }));
+
+    std::vector<uint32_t> all = ShaderPermutation::EnumerateVariants(ShaderFeature::kAll);
+    CHECK_EQ(all.size(), size_t(ShaderFeature::kVariantCount));
+    for (uint32_t i = 0; i < all.size(); ++i) {
+        CHECK_EQ(all[i], i);
+    }
+}
+
+TEST(NamesVariants) {
+    CHECK_EQ(ShaderPermutation::BuildVariantName(ShaderFeature::kNone), "none");
+    CHECK_EQ(ShaderPermutation::BuildVariantName(ShaderFeature::kAll), "LIGHTING|ALPHA_TEST|UV_TRANSFORM");
+    CHECK_EQ(std::string(ShaderPermutation::GetDefineName(ShaderFeature::kAlphaTest)), "ALPHA_TEST");
+}
+
+TEST(SelectsOnlyRequiredFeatures) {
+    CHECK_EQ(ShaderPermutation::SelectMaterialFeatures(false, false, false), ShaderFeature::kNone);
+    CHECK_EQ(ShaderPermutation::SelectMaterialFeatures(true, false, false), ShaderFeature::kLighting);
+    CHECK_EQ(ShaderPermutation::SelectMaterialFeatures(false, true, true), ShaderFeature::kUvTransform | ShaderFeature::kAlphaTest);
+}
+
+TEST(SpriteVariantsHaveDistinctCachedBytecode) {
+    // Resources のスプライトのシェーダーを一時フォルダに写して使う（.hlsli を書き換えるため）
+    TemporaryDirectory directory;
+    const std::filesystem::path resourceDirectory = std::filesystem::path(ENGINE_RESOURCES_DIR) / "shader";
+    for (const char* fileName : { "Sprite2D.PS.hlsl", "Sprite2D.hlsli" }) {
+        std::filesystem::copy_file(resourceDirectory / fileName, directory.GetPath() / fileName);
+    }
+    const std::filesystem::path sourcePath = directory.GetPath() / "Sprite2D.PS.hlsl";
+
+    std::vector<uint32_t> variants = ShaderPermutation::EnumerateVariants(ShaderFeature::kAll);
+    CHECK_EQ(variants.size(), size_t(ShaderFeature::kVariantCount));
+    std::vector<uint64_t> keys;
+    for (uint32_t features : variants) {
+        keys.push_back(ShaderCache::ComputeKey(sourcePath, BuildArguments(sourcePath, features)));
+        CHECK(keys.back() != ShaderCache::kInvalidKey);
+    }
+    CHECK_EQ(std::set<uint64_t>(keys.begin(), keys.end()).size(), variants.size());
+
+    // バリアントごとに違う中身を保存し、それぞれのキーで同じ中身が読める
+    ShaderCache cache;
+    cache.Initialize(directory.GetPath() / "cache");
+    for (uint32_t features : variants) {
+        std::string bytecode = "DXIL " + ShaderPermutation::BuildVariantName(features);
+        CHECK(cache.Store(keys[features], bytecode.data(), bytecode.size()));
+    }
+    for (uint32_t features : variants) {
+        std::string expected = "DXIL " + ShaderPermutation::BuildVariantName(features);
+        MappedFile loaded;
+        CHECK(cache.Load(keys[features], loaded));
+        CHECK_EQ(loaded.GetSize(), expected.size());
+        CHECK(loaded.IsOpen() && std::memcmp(loaded.GetData(), expected.data(), expected.size()) == 0);
+    }
+    CHECK_EQ(cache.GetStats().hitCount, ShaderFeature::kVariantCount);
+
+    // 共通の .hlsli を書き換えると、すべてのバリアントが別のキーになり、キャッシュに当たらない
+    {
+        std::ofstream file(directory.GetPath() / "Sprite2D.hlsli", std::ios::binary | std::ios::app);
+        file << "\n// edited\nstatic const float kEdited = 1.0f;\n";
+    }
+    for (uint32_t features : variants) {
+        uint64_t changedKey = ShaderCache::ComputeKey(sourcePath, BuildArguments(sourcePath, features));
+        CHECK(std::find(keys.begin(), keys.end(), changedKey) == keys.end());
+        MappedFile loaded;
+        CHECK(!cache.Load(changedKey, loaded));
+    }
+}
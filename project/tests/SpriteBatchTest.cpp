@@ -0,0 +1,90 @@
+#include "SpriteBatch.h"
+#include "TestFramework.h"
+
+namespace {
+    // x 座標に番号を入れたスプライト1枚分の頂点
+    void MakeVertices(float id, SpriteBatch::Vertex (&vertices)[SpriteBatch::kVerticesPerSprite]) {
+        for (uint32_t i = 0; i < SpriteBatch::kVerticesPerSprite; ++i) {
+            vertices[i] = {};
+            vertices[i].position = { id, float(i), 0.0f, 1.0f };
+        }
+    }
+}
+
+TEST(SortsByTextureAndKeepsSubmissionOrder) {
+    SpriteBatch batch;
+    batch.Begin();
+    SpriteBatch::Vertex vertices[SpriteBatch::kVerticesPerSprite];
+    for (int i = 0; i < 10; ++i) {
+        MakeVertices(float(i), vertices);
+        batch.Add(uint32_t(i % 3), vertices);
+    }
+    batch.End();
+
+    CHECK_EQ(batch.GetSpriteCount(), 10u);
+    std::vector<SpriteBatch::Vertex> sorted(batch.GetSpriteCount() * SpriteBatch::kVerticesPerSprite);
+    batch.WriteVertices(sorted.data());
+
+    // テクスチャ 0 → 1 → 2 の順で、同じテクスチャの中は登録順
+    const float expected[10] = { 0, 3, 6, 9, 1, 4, 7, 2, 5, 8 };
+    for (int i = 0; i < 10; ++i) {
+        CHECK_EQ(sorted[i * 4].position.x, expected[i]);
+        // 1枚分の4頂点はばらばらにならない
+        for (int v = 0; v < 4; ++v) {
+            CHECK_EQ(sorted[i * 4 + v].position.x, expected[i]);
+            CHECK_EQ(sorted[i * 4 + v].position.y, float(v));
+        }
+    }
+}
+
+TEST(BuildsOneDrawRunPerTexture) {
+    SpriteBatch batch;
+    batch.Begin();
+    SpriteBatch::Vertex vertices[SpriteBatch::kVerticesPerSprite];
+    MakeVertices(0.0f, vertices);
+    for (int i = 0; i < 10; ++i) {
+        batch.Add(uint32_t(i % 3), vertices);
+    }
+    batch.End();
+
+    const std::vector<SpriteBatch::DrawRun>& runs = batch.GetDrawRuns();
+    CHECK_EQ(runs.size(), 3u);
+    if (runs.size() == 3) {
+        CHECK_EQ(runs[0].textureHandle, 0u);
+        CHECK_EQ(runs[0].indexStart, 0u);
+        CHECK_EQ(runs[0].indexCount, 4u * SpriteBatch::kIndicesPerSprite);
+        CHECK_EQ(runs[1].textureHandle, 1u);
+        CHECK_EQ(runs[1].indexStart, 4u * SpriteBatch::kIndicesPerSprite);
+        CHECK_EQ(runs[1].indexCount, 3u * SpriteBatch::kIndicesPerSprite);
+        CHECK_EQ(runs[2].textureHandle, 2u);
+        CHECK_EQ(runs[2].indexStart, 7u * SpriteBatch::kIndicesPerSprite);
+        CHECK_EQ(runs[2].indexCount, 3u * SpriteBatch::kIndicesPerSprite);
+    }
+}
+
+TEST(BeginDiscardsPreviousFrame) {
+    SpriteBatch batch;
+    SpriteBatch::Vertex vertices[SpriteBatch::kVerticesPerSprite];
+    MakeVertices(1.0f, vertices);
+
+    batch.Begin();
+    batch.Add(5, vertices);
+    batch.End();
+    CHECK_EQ(batch.GetSpriteCount(), 1u);
+
+    batch.Begin();
+    batch.End();
+    CHECK_EQ(batch.GetSpriteCount(), 0u);
+    CHECK(batch.GetDrawRuns().empty());
+}
+
+TEST(WritesQuadIndexPattern) {
+    std::vector<uint32_t> indices(3 * SpriteBatch::kIndicesPerSprite);
+    SpriteBatch::WriteIndices(indices.data(), 3);
+    const uint32_t pattern[6] = { 0, 1, 2, 1, 3, 2 };
+    for (uint32_t sprite = 0; sprite < 3; ++sprite) {
+        for (uint32_t i = 0; i < 6; ++i) {
+            CHECK_EQ(indices[sprite * 6 + i], sprite * 4 + pattern[i]);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "SpriteCommandRecorder.h"
+#include "TestFramework.h"
+
+namespace {
+    // 積まれたコマンドを記録するだけのコマンドリスト
+    class RecordingCommandList : public SpriteCommandRecorder::CommandList {
+    public:
+        struct Draw {
+            uint32_t indexCount;
+            uint32_t instanceCount;
+            uint32_t indexStart;
+            uint32_t textureIndex; // 描画時点の kRootTextureIndex の値
+        };
+
+        void SetRootConstantBufferView(uint32_t, uint64_t) override { ++rootCalls; }
+        void SetRootDescriptorTable(uint32_t, uint64_t) override { ++rootCalls; }
+        void SetRoot32BitConstant(uint32_t, uint32_t value) override {
+            ++rootCalls;
+            textureIndex_ = value;
+        }
+        void SetRootShaderResourceView(uint32_t, uint64_t) override { ++rootCalls; }
+        void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount, uint32_t indexStart) override {
+            draws.push_back({ indexCountPerInstance, instanceCount, indexStart, textureIndex_ });
+        }
+
+        uint32_t rootCalls = 0;
+        std::vector<Draw> draws;
+
+    private:
+        uint32_t textureIndex_ = 0xffffffff;
+    };
+
+    // ハンドル 1 はハンドル 0 と同じ SRV（読み込み中の代わりのテクスチャなど）
+    uint32_t SrvIndexOf(uint32_t textureHandle) {
+        return textureHandle == 1 ? 0 : textureHandle;
+    }
+}
+
+TEST(MergesContiguousRunsWithSameSrv) {
+    RecordingCommandList commandList;
+    SpriteCommandRecorder recorder;
+    recorder.Reset(&commandList);
+    recorder.SetViewProjection(100);
+    recorder.SetTextureTable(200);
+    recorder.DrawRuns({ { 0, 0, 6 }, { 1, 6, 12 }, { 2, 18, 6 }, { 3, 24, 6 } }, SrvIndexOf);
+    recorder.EndFrame();
+
+    CHECK_EQ(commandList.draws.size(), 3u);
+    if (commandList.draws.size() == 3) {
+        CHECK_EQ(commandList.draws[0].indexCount, 18u);
+        CHECK_EQ(commandList.draws[0].indexStart, 0u);
+        CHECK_EQ(commandList.draws[0].textureIndex, 0u);
+        CHECK_EQ(commandList.draws[1].indexStart, 18u);
+        CHECK_EQ(commandList.draws[1].textureIndex, 2u);
+        CHECK_EQ(commandList.draws[2].indexStart, 24u);
+        CHECK_EQ(commandList.draws[2].textureIndex, 3u);
+    }
+    CHECK_EQ(recorder.GetStats().drawCalls, 3u);
+    CHECK_EQ(recorder.GetStats().mergedRuns, 1u);
+}
+
+TEST(DoesNotMergeNonContiguousRuns) {
+    RecordingCommandList commandList;
+    SpriteCommandRecorder recorder;
+    recorder.Reset(&commandList);
+    // SRV は同じでもインデックスが離れている
+    recorder.DrawRuns({ { 0, 0, 6 }, { 1, 12, 6 } }, SrvIndexOf);
+    CHECK_EQ(commandList.draws.size(), 2u);
+    // 2回目はテクスチャの番号が変わらないので積まない
+    CHECK_EQ(commandList.rootCalls, 1u);
+}
+
+TEST(SkipsRedundantRootParameters) {
+    RecordingCommandList commandList;
+    SpriteCommandRecorder recorder;
+    recorder.Reset(&commandList);
+    recorder.SetViewProjection(100);
+    recorder.SetTextureTable(200);
+    recorder.DrawRuns({ { 3, 0, 6 } }, SrvIndexOf);
+    recorder.SetViewProjection(100);
+    recorder.SetTextureTable(200);
+    recorder.DrawRuns({ { 3, 0, 6 } }, SrvIndexOf);
+    recorder.EndFrame();
+
+    CHECK_EQ(commandList.rootCalls, 3u);
+    CHECK_EQ(recorder.GetStats().rootParameterChanges, 3u);
+    CHECK_EQ(recorder.GetStats().skippedChanges, 3u);
+    CHECK_EQ(recorder.GetStats().drawCalls, 2u);
+
+    // Reset の後は GPU 側も未設定なので積み直す
+    recorder.Reset(&commandList);
+    recorder.SetViewProjection(100);
+    CHECK_EQ(commandList.rootCalls, 4u);
+}
+
+TEST(DrawsInstancesInOneCall) {
+    RecordingCommandList commandList;
+    SpriteCommandRecorder recorder;
+    recorder.Reset(&commandList);
+    recorder.DrawInstances(0x1000, 500);
+    recorder.DrawInstances(0x1000, 20);
+    recorder.EndFrame();
+
+    CHECK_EQ(commandList.draws.size(), 2u);
+    CHECK_EQ(commandList.draws[0].indexCount, SpriteBatch::kIndicesPerSprite);
+    CHECK_EQ(commandList.draws[0].instanceCount, 500u);
+    CHECK_EQ(commandList.draws[0].indexStart, 0u);
+    // インスタンスバッファは同じなので 1 回だけ
+    CHECK_EQ(commandList.rootCalls, 1u);
+    CHECK_EQ(recorder.GetStats().skippedChanges, 1u);
+}
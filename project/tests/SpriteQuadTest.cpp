@@ -0,0 +1,79 @@
+#include "SpriteQuad.h"
+#include "SpriteSystem.h"
+#include "TestFramework.h"
+
+namespace {
+    constexpr Vector2 kTextureSize = { 256.0f, 128.0f };
+}
+
+TEST(SkipsUpdateWhenNothingChanged) {
+    SpriteQuad quad;
+    quad.SetTexture(kTextureSize);
+    CHECK(quad.Update(kTextureSize));
+    CHECK(!quad.Update(kTextureSize));
+
+    // 同じ値を入れ直しても作り直さない
+    quad.SetPosition(quad.GetPosition());
+    quad.SetColor(quad.GetColor());
+    quad.SetFlip(false, false);
+    CHECK(!quad.Update(kTextureSize));
+
+    quad.SetPosition({ 5.0f, 6.0f });
+    CHECK(quad.Update(kTextureSize));
+    CHECK(!quad.Update(kTextureSize));
+    quad.SetColor({ 1.0f, 0.0f, 0.0f, 1.0f });
+    CHECK(quad.Update(kTextureSize));
+    CHECK(quad.GetVertices()[2].color == (Vector4{ 1.0f, 0.0f, 0.0f, 1.0f }));
+}
+
+TEST(MatchesSpriteSystemVertices) {
+    SpriteQuad quad;
+    quad.SetTexture(kTextureSize);
+    quad.SetPosition({ 300.0f, 200.0f });
+    quad.SetRotation(0.75f);
+    quad.SetAnchorPoint({ 0.5f, 0.25f });
+    quad.SetTextureRect({ 16.0f, 8.0f }, { 64.0f, 32.0f });
+    quad.SetFlip(true, false);
+    quad.SetColor({ 1.0f, 0.5f, 0.25f, 1.0f });
+    quad.Update(kTextureSize);
+
+    SpriteSystem spriteSystem;
+    SpriteSystem::Handle handle = spriteSystem.Create(0, kTextureSize);
+    spriteSystem.SetPosition(handle, { 300.0f, 200.0f });
+    spriteSystem.SetRotation(handle, 0.75f);
+    spriteSystem.SetAnchorPoint(handle, { 0.5f, 0.25f });
+    spriteSystem.SetTextureRect(handle, { 16.0f, 8.0f }, { 64.0f, 32.0f });
+    spriteSystem.SetFlip(handle, true, false);
+    spriteSystem.SetColor(handle, { 1.0f, 0.5f, 0.25f, 1.0f });
+    std::vector<SpriteBatch::Vertex> vertices(SpriteBatch::kVerticesPerSprite);
+    spriteSystem.WriteVertices(vertices);
+
+    // 回転の計算順が違うので位置は誤差で比べる
+    for (uint32_t i = 0; i < SpriteBatch::kVerticesPerSprite; ++i) {
+        const SpriteBatch::Vertex& vertex = quad.GetVertices()[i];
+        CHECK_NEAR(vertex.position.x, vertices[i].position.x, 1.0e-3f);
+        CHECK_NEAR(vertex.position.y, vertices[i].position.y, 1.0e-3f);
+        CHECK(vertex.texcoord == vertices[i].texcoord);
+        CHECK(vertex.color == vertices[i].color);
+    }
+}
+
+TEST(RefitsWhenTextureSizeChanges) {
+    // 読み込み中は 1x1 の代わりのテクスチャ
+    SpriteQuad fullImage;
+    fullImage.SetTexture({ 1.0f, 1.0f });
+    SpriteQuad explicitSize;
+    explicitSize.SetTexture({ 1.0f, 1.0f });
+    explicitSize.SetSize({ 40.0f, 40.0f });
+    fullImage.Update({ 1.0f, 1.0f });
+    explicitSize.Update({ 1.0f, 1.0f });
+
+    // 読み込みが終わって大きさが変わると、画像に合わせていたものだけサイズが変わる
+    CHECK(fullImage.Update(kTextureSize));
+    CHECK(explicitSize.Update(kTextureSize));
+    CHECK(fullImage.GetSize() == kTextureSize);
+    CHECK(explicitSize.GetSize() == (Vector2{ 40.0f, 40.0f }));
+    CHECK(fullImage.GetVertices()[3].position == (Vector4{ 256.0f, 0.0f, 0.0f, 1.0f }));
+    CHECK(fullImage.GetVertices()[3].texcoord == (Vector2{ 1.0f, 0.0f }));
+    CHECK(!fullImage.Update(kTextureSize));
+}
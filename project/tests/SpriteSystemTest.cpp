@@ -0,0 +1,160 @@
+#include "SpriteSystem.h"
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <cstring>
+
+namespace {
+    // いろいろな値を設定したスプライトを count 枚作る
+    void Populate(SpriteSystem& spriteSystem, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            SpriteSystem::Handle handle = spriteSystem.Create(i % 5, { 64.0f, 32.0f });
+            spriteSystem.SetPosition(handle, { float(i % 97) * 3.0f, float(i % 89) * 2.0f });
+            spriteSystem.SetRotation(handle, float(i) * 0.01f);
+            spriteSystem.SetAnchorPoint(handle, { 0.5f, 0.25f });
+            spriteSystem.SetColor(handle, { 1.0f, 0.5f, float(i % 3) * 0.5f, 1.0f });
+            if (i % 7 == 0) {
+                spriteSystem.SetTextureRect(handle, { 16.0f, 8.0f }, { 32.0f, 16.0f });
+            }
+            spriteSystem.SetFlip(handle, i % 2 == 0, i % 3 == 0);
+        }
+    }
+
+    bool SameVertices(const std::vector<SpriteBatch::Vertex>& a, const std::vector<SpriteBatch::Vertex>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(SpriteBatch::Vertex)) == 0;
+    }
+}
+
+TEST(HandlesSurviveDestroyOfOthers) {
+    SpriteSystem spriteSystem;
+    SpriteSystem::Handle a = spriteSystem.Create(0, { 10.0f, 10.0f });
+    SpriteSystem::Handle b = spriteSystem.Create(0, { 10.0f, 10.0f });
+    SpriteSystem::Handle c = spriteSystem.Create(0, { 10.0f, 10.0f });
+    spriteSystem.SetPosition(c, { 3.0f, 4.0f });
+
+    // 真ん中を消すと末尾が詰められるが、ハンドルは同じものを指したまま
+    spriteSystem.Destroy(b);
+    CHECK_EQ(spriteSystem.GetCount(), 2u);
+    CHECK(!spriteSystem.IsValid(b));
+    CHECK(spriteSystem.IsValid(a) && spriteSystem.IsValid(c));
+    CHECK(spriteSystem.GetPosition(c) == (Vector2{ 3.0f, 4.0f }));
+
+    // スロットが再利用されても古いハンドルは無効のまま
+    SpriteSystem::Handle d = spriteSystem.Create(1, { 5.0f, 5.0f });
+    CHECK_EQ(d.index, b.index);
+    CHECK(!spriteSystem.IsValid(b));
+    CHECK(spriteSystem.IsValid(d));
+    CHECK(spriteSystem.GetSize(d) == (Vector2{ 5.0f, 5.0f }));
+
+    spriteSystem.Clear();
+    CHECK_EQ(spriteSystem.GetCount(), 0u);
+    CHECK(!spriteSystem.IsValid(a));
+}
+
+TEST(WritesCornersAndUvs) {
+    SpriteSystem spriteSystem;
+    SpriteSystem::Handle handle = spriteSystem.Create(0, { 100.0f, 50.0f });
+    spriteSystem.SetPosition(handle, { 10.0f, 20.0f });
+
+    std::vector<SpriteBatch::Vertex> vertices(4);
+    spriteSystem.WriteVertices(vertices);
+    // 0: 左下, 1: 左上, 2: 右下, 3: 右上
+    CHECK(vertices[0].position == (Vector4{ 10.0f, 70.0f, 0.0f, 1.0f }));
+    CHECK(vertices[1].position == (Vector4{ 10.0f, 20.0f, 0.0f, 1.0f }));
+    CHECK(vertices[2].position == (Vector4{ 110.0f, 70.0f, 0.0f, 1.0f }));
+    CHECK(vertices[3].position == (Vector4{ 110.0f, 20.0f, 0.0f, 1.0f }));
+    CHECK(vertices[0].texcoord == (Vector2{ 0.0f, 1.0f }));
+    CHECK(vertices[3].texcoord == (Vector2{ 1.0f, 0.0f }));
+
+    // 切り出し範囲を指定すると表示サイズも合わせる
+    spriteSystem.SetTextureRect(handle, { 0.0f, 0.0f }, { 50.0f, 25.0f });
+    CHECK(spriteSystem.GetSize(handle) == (Vector2{ 50.0f, 25.0f }));
+    spriteSystem.WriteVertices(vertices);
+    CHECK(vertices[3].texcoord == (Vector2{ 0.5f, 0.0f }));
+    CHECK(vertices[0].texcoord == (Vector2{ 0.0f, 0.5f }));
+}
+
+TEST(ParallelWriteMatchesSerialWrite) {
+    SpriteSystem spriteSystem;
+    // 並列のブロックの境目をまたぐ数
+    Populate(spriteSystem, 10000 + 37);
+    std::vector<SpriteBatch::Vertex> serial(spriteSystem.GetCount() * SpriteBatch::kVerticesPerSprite);
+    spriteSystem.WriteVertices(serial);
+
+    ThreadPool threadPool;
+    threadPool.Initialize(3);
+    std::vector<SpriteBatch::Vertex> parallel(serial.size());
+    spriteSystem.WriteVertices(parallel, &threadPool);
+    CHECK(SameVertices(parallel, serial));
+}
+
+TEST(InstancesExpandToSameVertices) {
+    SpriteSystem spriteSystem;
+    Populate(spriteSystem, 500);
+    std::vector<SpriteBatch::Vertex> vertices(spriteSystem.GetCount() * SpriteBatch::kVerticesPerSprite);
+    spriteSystem.WriteVertices(vertices);
+
+    const uint32_t srvIndices[5] = { 10, 11, 12, 13, 14 };
+    std::vector<SpriteInstance> instances(spriteSystem.GetCount());
+    spriteSystem.WriteInstances(instances, srvIndices);
+
+    for (uint32_t i = 0; i < instances.size(); ++i) {
+        CHECK_EQ(instances[i].textureIndex, srvIndices[i % 5]);
+        SpriteBatch::Vertex expanded[SpriteBatch::kVerticesPerSprite];
+        ExpandSpriteInstance(instances[i], expanded);
+        for (uint32_t v = 0; v < SpriteBatch::kVerticesPerSprite; ++v) {
+            const SpriteBatch::Vertex& expected = vertices[i * SpriteBatch::kVerticesPerSprite + v];
+            CHECK_NEAR(expanded[v].position.x, expected.position.x, 1.0e-3f);
+            CHECK_NEAR(expanded[v].position.y, expected.position.y, 1.0e-3f);
+            CHECK(expanded[v].texcoord == expected.texcoord);
+            CHECK(expanded[v].color == expected.color);
+        }
+    }
+}
+
+TEST(BuildsRunsInCreationOrder) {
+    SpriteSystem spriteSystem;
+    for (uint32_t textureHandle : { 2u, 2u, 0u, 0u, 0u, 2u }) {
+        spriteSystem.Create(textureHandle, { 1.0f, 1.0f });
+    }
+    std::vector<SpriteBatch::DrawRun> drawRuns;
+    spriteSystem.BuildDrawRuns(drawRuns);
+    CHECK_EQ(drawRuns.size(), 3u);
+    if (drawRuns.size() == 3) {
+        CHECK_EQ(drawRuns[0].textureHandle, 2u);
+        CHECK_EQ(drawRuns[0].indexCount, 12u);
+        CHECK_EQ(drawRuns[1].indexStart, 12u);
+        CHECK_EQ(drawRuns[1].indexCount, 18u);
+        CHECK_EQ(drawRuns[2].indexStart, 30u);
+    }
+}
+
+TEST(SyncTextureSizesReplacesPlaceholderSize) {
+    SpriteSystem spriteSystem;
+    // 読み込み中は 1x1 の代わりのテクスチャ
+    SpriteSystem::Handle fullImage = spriteSystem.Create(0, { 1.0f, 1.0f });
+    SpriteSystem::Handle explicitSize = spriteSystem.Create(0, { 1.0f, 1.0f });
+    spriteSystem.SetSize(explicitSize, { 40.0f, 40.0f });
+    SpriteSystem::Handle explicitRect = spriteSystem.Create(0, { 1.0f, 1.0f });
+    spriteSystem.SetTextureRect(explicitRect, { 0.0f, 0.0f }, { 128.0f, 64.0f });
+
+    // 読み込みが終わって 256x128 になった
+    std::vector<Vector2> textureSizes = { { 256.0f, 128.0f } };
+    spriteSystem.SyncTextureSizes(textureSizes);
+
+    // 画像に合わせていたものだけが変わる
+    CHECK(spriteSystem.GetSize(fullImage) == (Vector2{ 256.0f, 128.0f }));
+    CHECK(spriteSystem.GetSize(explicitSize) == (Vector2{ 40.0f, 40.0f }));
+    CHECK(spriteSystem.GetSize(explicitRect) == (Vector2{ 128.0f, 64.0f }));
+
+    std::vector<SpriteBatch::Vertex> vertices(spriteSystem.GetCount() * SpriteBatch::kVerticesPerSprite);
+    spriteSystem.WriteVertices(vertices);
+    // 画像全体の UV のまま / 指定した範囲は新しい大きさで UV を作り直す
+    CHECK(vertices[3].texcoord == (Vector2{ 1.0f, 0.0f }));
+    CHECK(vertices[2 * 4 + 3].texcoord == (Vector2{ 0.5f, 0.0f }));
+    CHECK(vertices[2 * 4 + 0].texcoord == (Vector2{ 0.0f, 0.5f }));
+
+    // 同じ大きさでもう一度呼んでも変わらない
+    spriteSystem.SetSize(fullImage, { 10.0f, 10.0f });
+    spriteSystem.SyncTextureSizes(textureSizes);
+    CHECK(spriteSystem.GetSize(fullImage) == (Vector2{ 10.0f, 10.0f }));
+}
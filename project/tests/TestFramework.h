@@ -0,0 +1,60 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 依存ライブラリを使わない小さなテストの仕組み（エンジンの D3D12 に依存しない部分を Linux でも確かめる）
+// TEST(名前) { ... } で登録し、CHECK 系のマクロで確かめる。失敗してもそのテストの残りは続け、最後に失敗数を返す
+// 実行ファイルに引数を渡すと、名前にその文字列を含むテストだけを実行する
+namespace TestFramework {
+
+    struct TestCase {
+        const char* name;
+        void (*func)();
+    };
+
+    // 登録されたテスト（静的な初期化の順に左右されないよう関数の中に持つ）
+    std::vector<TestCase>& GetTests();
+
+    // TEST マクロが静的変数として作り、テストを登録する
+    struct Registrar {
+        Registrar(const char* name, void (*func)());
+    };
+
+    // 失敗を記録して表示する
+    void ReportFailure(const char* file, int line, const std::string& message);
+
+    // 登録されたテストを実行する。戻り値は main の戻り値（失敗があれば 1）
+    int RunAll(int argc, char* argv[]);
+
+}
+
+#define TEST(name) \
+    static void name(); \
+    static TestFramework::Registrar name##Registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            TestFramework::ReportFailure(__FILE__, __LINE__, "CHECK(" #condition ")"); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        if (!((actual) == (expected))) { \
+            TestFramework::ReportFailure(__FILE__, __LINE__, "CHECK_EQ(" #actual ", " #expected ")"); \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, epsilon) \
+    do { \
+        double checkActual = double(actual); \
+        double checkExpected = double(expected); \
+        if (!(std::fabs(checkActual - checkExpected) <= double(epsilon))) { \
+            TestFramework::ReportFailure(__FILE__, __LINE__, "CHECK_NEAR(" #actual ", " #expected ") : " \
+                + std::to_string(checkActual) + " vs " + std::to_string(checkExpected)); \
+        } \
+    } while (0)
@@ -0,0 +1,45 @@
+#include "TestFramework.h"
+#include <cstring>
+
+namespace {
+    int failureCount = 0;
+}
+
+std::vector<TestFramework::TestCase>& TestFramework::GetTests() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+TestFramework::Registrar::Registrar(const char* name, void (*func)()) {
+    GetTests().push_back({ name, func });
+}
+
+void TestFramework::ReportFailure(const char* file, int line, const std::string& message) {
+    ++failureCount;
+    std::printf("  %s:%d: %s\n", file, line, message.c_str());
+}
+
+int TestFramework::RunAll(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int runCount = 0;
+    int failedTestCount = 0;
+    for (const TestCase& test : GetTests()) {
+        if (filter && !std::strstr(test.name, filter)) {
+            continue;
+        }
+        int failuresBefore = failureCount;
+        test.func();
+        ++runCount;
+        bool passed = failureCount == failuresBefore;
+        if (!passed) {
+            ++failedTestCount;
+        }
+        std::printf("[%s] %s\n", passed ? "  OK  " : " FAIL ", test.name);
+    }
+    std::printf("%d tests, %d failed\n", runCount, failedTestCount);
+    return failedTestCount == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    return TestFramework::RunAll(argc, argv);
+}
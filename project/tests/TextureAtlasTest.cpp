@@ -0,0 +1,85 @@
+#include "TextureAtlas.h"
+#include "TestFramework.h"
+#include <iterator>
+
+namespace {
+    // 画像 index ごとに違う色で塗った width x height の画像
+    DirectX::ScratchImage MakeImage(uint32_t width, uint32_t height, uint8_t index) {
+        DirectX::ScratchImage image;
+        HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, width, height, 1, 1);
+        CHECK(SUCCEEDED(hr));
+        uint8_t* pixels = image.GetPixels();
+        for (size_t i = 0; i < image.GetPixelsSize(); i += 4) {
+            pixels[i + 0] = index;
+            pixels[i + 1] = uint8_t(index * 3);
+            pixels[i + 2] = uint8_t(index * 7);
+            pixels[i + 3] = 255;
+        }
+        return image;
+    }
+
+    const uint8_t* PixelAt(const DirectX::Image& image, uint32_t x, uint32_t y) {
+        return image.pixels + y * image.rowPitch + size_t(x) * 4;
+    }
+}
+
+TEST(CopiesImagesIntoRegionsInInputOrder) {
+    constexpr uint32_t kPageSize = 128;
+    const uint32_t sizes[][2] = { { 20, 10 }, { 60, 60 }, { 60, 60 }, { 30, 40 }, { 64, 64 }, { 60, 60 } };
+    std::vector<DirectX::ScratchImage> sources;
+    std::vector<const DirectX::Image*> images;
+    for (size_t i = 0; i < std::size(sizes); ++i) {
+        sources.push_back(MakeImage(sizes[i][0], sizes[i][1], uint8_t(i + 1)));
+    }
+    for (const DirectX::ScratchImage& source : sources) {
+        images.push_back(source.GetImage(0, 0, 0));
+    }
+
+    TextureAtlas atlas;
+    CHECK(SUCCEEDED(atlas.Build(images, kPageSize)));
+    const std::vector<TextureAtlas::Region>& regions = atlas.GetRegions();
+    CHECK_EQ(regions.size(), images.size());
+    // 64x64 と 60x60 が3つは1ページ（128x128）に入りきらない
+    CHECK_EQ(atlas.GetPages().size(), 2u);
+
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const TextureAtlas::Region& region = regions[i];
+        CHECK_EQ(region.width, sizes[i][0]);
+        CHECK_EQ(region.height, sizes[i][1]);
+
+        const DirectX::ScratchImage& page = atlas.GetPages()[region.page];
+        CHECK(page.GetMetadata().format == TextureAtlas::kPageFormat);
+        CHECK_EQ(page.GetMetadata().width, size_t(kPageSize));
+        CHECK(page.GetMetadata().mipLevels > 1);
+        const DirectX::Image& base = *page.GetImage(0, 0, 0);
+
+        // 四隅に i 番目の画像の色が入っている
+        const uint32_t corners[][2] = {
+            { region.x, region.y },
+            { region.x + region.width - 1, region.y },
+            { region.x, region.y + region.height - 1 },
+            { region.x + region.width - 1, region.y + region.height - 1 },
+        };
+        for (const auto& corner : corners) {
+            const uint8_t* pixel = PixelAt(base, corner[0], corner[1]);
+            CHECK_EQ(pixel[0], uint8_t(i + 1));
+            CHECK_EQ(pixel[1], uint8_t((i + 1) * 3));
+            CHECK_EQ(pixel[3], 255);
+        }
+
+        // 右と下の隙間は透明（ページの端に接していなければ）
+        if (region.x + region.width < kPageSize) {
+            CHECK_EQ(PixelAt(base, region.x + region.width, region.y)[3], 0);
+        }
+        if (region.y + region.height < kPageSize) {
+            CHECK_EQ(PixelAt(base, region.x, region.y + region.height)[3], 0);
+        }
+    }
+}
+
+TEST(FailsForImageLargerThanPage) {
+    DirectX::ScratchImage source = MakeImage(65, 8, 1);
+    std::vector<const DirectX::Image*> images = { source.GetImage(0, 0, 0) };
+    TextureAtlas atlas;
+    CHECK(FAILED(atlas.Build(images, 64)));
+}
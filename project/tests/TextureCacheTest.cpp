@@ -0,0 +1,191 @@
+#include "TextureCache.h"
+#include "TestFramework.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // テストごとの一時フォルダ（終わったら消す）
+    class TemporaryDirectory {
+    public:
+        TemporaryDirectory() {
+            auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+            path_ = std::filesystem::temp_directory_path() / ("TextureCacheTest_" + std::to_string(ticks));
+            std::filesystem::create_directories(path_);
+        }
+        ~TemporaryDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path_, error);
+        }
+        const std::filesystem::path& GetPath() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    // seed で決まる模様の sRGB 画像（ミップマップ付き）
+    DirectX::ScratchImage MakeMipImages(size_t width, size_t height, uint8_t seed) {
+        DirectX::ScratchImage image;
+        HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, width, height, 1, 0);
+        CHECK(SUCCEEDED(hr));
+        for (size_t i = 0; i < image.GetPixelsSize(); ++i) {
+            image.GetPixels()[i] = static_cast<uint8_t>(i * 13 + seed);
+        }
+        return image;
+    }
+
+    // マップしたキャッシュの中身が mipImages と同じか
+    bool Matches(const MappedFile& mappedFile, const DdsLayout& ddsLayout, const DirectX::ScratchImage& mipImages) {
+        if (ddsLayout.subresources.size() != mipImages.GetImageCount() || ddsLayout.metadata.format != mipImages.GetMetadata().format) {
+            return false;
+        }
+        for (size_t i = 0; i < mipImages.GetImageCount(); ++i) {
+            const DirectX::Image& image = mipImages.GetImages()[i];
+            const DdsLayout::Subresource& subresource = ddsLayout.subresources[i];
+            if (subresource.slicePitch != image.slicePitch ||
+                std::memcmp(mappedFile.GetData() + subresource.offset, image.pixels, image.slicePitch) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t CountTemporaryFiles(const std::filesystem::path& directory) {
+        size_t count = 0;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.path().extension() == ".tmp") {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    constexpr uint64_t kKey = 0x0123456789abcdefull;
+}
+
+TEST(StoreThenOpenRoundTrips) {
+    TemporaryDirectory directory;
+    TextureCache cache;
+    cache.Initialize(directory.GetPath() / "cache");
+    CHECK(cache.IsEnabled());
+
+    DirectX::ScratchImage mipImages = MakeMipImages(64, 32, 1);
+    CHECK(SUCCEEDED(cache.Store(kKey, mipImages)));
+    // 名前はキーの16進数
+    CHECK(std::filesystem::exists(directory.GetPath() / "cache" / "0123456789abcdef.dds"));
+
+    MappedFile mappedFile;
+    DdsLayout ddsLayout;
+    CHECK(cache.Open(kKey, mappedFile, ddsLayout));
+    CHECK_EQ(ddsLayout.metadata.width, 64u);
+    CHECK_EQ(ddsLayout.metadata.height, 32u);
+    CHECK_EQ(ddsLayout.metadata.mipLevels, 7u);
+    CHECK(Matches(mappedFile, ddsLayout, mipImages));
+}
+
+TEST(OpenFailsForMissingOrBrokenEntries) {
+    TemporaryDirectory directory;
+    TextureCache cache;
+    cache.Initialize(directory.GetPath());
+    MappedFile mappedFile;
+    DdsLayout ddsLayout;
+    CHECK(!cache.Open(kKey, mappedFile, ddsLayout));
+    CHECK(!cache.Open(TextureCache::kInvalidKey, mappedFile, ddsLayout));
+    CHECK(FAILED(cache.Store(TextureCache::kInvalidKey, MakeMipImages(4, 4, 0))));
+
+    // 壊れたファイルは開かない（開いたままにもしない）
+    {
+        std::ofstream file(directory.GetPath() / "0123456789abcdef.dds", std::ios::binary);
+        file << "DDS broken";
+    }
+    CHECK(!cache.Open(kKey, mappedFile, ddsLayout));
+    CHECK(!mappedFile.IsOpen());
+
+    // 初期化していなければ何もしない
+    TextureCache disabled;
+    CHECK(!disabled.IsEnabled());
+    CHECK(!disabled.Open(kKey, mappedFile, ddsLayout));
+    CHECK(FAILED(disabled.Store(kKey, MakeMipImages(4, 4, 0))));
+}
+
+TEST(StoreReplacesEntryWithoutLeavingTemporaryFiles) {
+    TemporaryDirectory directory;
+    TextureCache cache;
+    cache.Initialize(directory.GetPath());
+
+    // 前回書きかけで残ったような壊れたファイルも、丸ごと置き換わる
+    {
+        std::ofstream file(directory.GetPath() / "0123456789abcdef.dds", std::ios::binary);
+        file << "DDS ";
+    }
+    DirectX::ScratchImage mipImages = MakeMipImages(32, 32, 2);
+    CHECK(SUCCEEDED(cache.Store(kKey, mipImages)));
+    CHECK_EQ(CountTemporaryFiles(directory.GetPath()), 0u);
+
+    MappedFile mappedFile;
+    DdsLayout ddsLayout;
+    CHECK(cache.Open(kKey, mappedFile, ddsLayout));
+    CHECK(Matches(mappedFile, ddsLayout, mipImages));
+}
+
+TEST(ReadersNeverSeePartialFiles) {
+    TemporaryDirectory directory;
+    TextureCache cache;
+    cache.Initialize(directory.GetPath());
+
+    // 同じキーを2つのスレッドが別の中身で書き続け、その間に読む
+    // 一時ファイルに書いてから名前を変えるので、開けたときはどちらかの画像が丸ごと入っている
+    const DirectX::ScratchImage images[2] = { MakeMipImages(256, 256, 3), MakeMipImages(256, 256, 4) };
+    CHECK(SUCCEEDED(cache.Store(kKey, images[0])));
+
+    constexpr int kStoreCount = 30;
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < 2; ++writer) {
+        writers.emplace_back([&cache, &images, writer] {
+            for (int i = 0; i < kStoreCount; ++i) {
+                // Windows では読んでいる人がいると名前を変えられず失敗するが、それは構わない
+                cache.Store(kKey, images[writer]);
+            }
+        });
+    }
+
+    int openCount = 0;
+    int mismatchCount = 0;
+    for (int i = 0; i < 200; ++i) {
+        MappedFile mappedFile;
+        DdsLayout ddsLayout;
+        if (!cache.Open(kKey, mappedFile, ddsLayout)) {
+            continue;
+        }
+        ++openCount;
+        if (!Matches(mappedFile, ddsLayout, images[0]) && !Matches(mappedFile, ddsLayout, images[1])) {
+            ++mismatchCount;
+        }
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+
+    CHECK(openCount > 0);
+    CHECK_EQ(mismatchCount, 0);
+    CHECK_EQ(CountTemporaryFiles(directory.GetPath()), 0u);
+}
+
+TEST(HashFileFollowsContentNotPath) {
+    TemporaryDirectory directory;
+    std::filesystem::path first = directory.GetPath() / "a.tga";
+    std::filesystem::path second = directory.GetPath() / "b.tga";
+    std::filesystem::path third = directory.GetPath() / "c.tga";
+    for (const std::filesystem::path& path : { first, second, third }) {
+        std::ofstream file(path, std::ios::binary);
+        file << (path == third ? "other image" : "same image");
+    }
+    uint64_t firstKey = TextureCache::HashFile(first.wstring());
+    CHECK(firstKey != TextureCache::kInvalidKey);
+    CHECK_EQ(TextureCache::HashFile(second.wstring()), firstKey);
+    CHECK(TextureCache::HashFile(third.wstring()) != firstKey);
+    CHECK_EQ(TextureCache::HashFile((directory.GetPath() / "missing.tga").wstring()), TextureCache::kInvalidKey);
+}
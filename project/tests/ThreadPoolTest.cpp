@@ -0,0 +1,45 @@
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <atomic>
+
+TEST(ParallelForCoversEveryIndexOnce) {
+    for (uint32_t threadCount : { 1u, 2u, 4u }) {
+        ThreadPool threadPool;
+        threadPool.Initialize(threadCount);
+        for (uint32_t count : { 0u, 1u, 7u, 1000u }) {
+            std::vector<std::atomic<int>> visits(count);
+            threadPool.ParallelFor(count, 16, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    ++visits[i];
+                }
+            });
+            for (uint32_t i = 0; i < count; ++i) {
+                CHECK_EQ(visits[i].load(), 1);
+            }
+        }
+    }
+}
+
+TEST(ParallelForWorksWithoutWorkers) {
+    // 初期化しない（ワーカー 0 人）でも呼び出し元だけで終わる
+    ThreadPool threadPool;
+    uint64_t sum = 0;
+    threadPool.ParallelFor(100, 8, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+    });
+    CHECK_EQ(sum, 4950u);
+}
+
+TEST(FinalizeRunsSubmittedJobs) {
+    ThreadPool threadPool;
+    threadPool.Initialize(2);
+    CHECK_EQ(threadPool.GetThreadCount(), 2u);
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 100; ++i) {
+        threadPool.Submit([&] { ++count; });
+    }
+    threadPool.Finalize();
+    CHECK_EQ(count.load(), 100);
+}
@@ -0,0 +1,71 @@
+#include "TiledCompression.h"
+#include "ThreadPool.h"
+#include "TestFramework.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    // なめらかな模様に乱数を足した画像から、ミップマップ付きの画像を作る
+    DirectX::ScratchImage MakeMipImages(size_t width, size_t height) {
+        DirectX::ScratchImage image;
+        HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, width, height, 1, 1);
+        CHECK(SUCCEEDED(hr));
+        const DirectX::Image* source = image.GetImage(0, 0, 0);
+        std::mt19937 random(1);
+        for (size_t y = 0; y < height; ++y) {
+            uint8_t* row = source->pixels + y * source->rowPitch;
+            for (size_t x = 0; x < width; ++x) {
+                row[x * 4 + 0] = static_cast<uint8_t>(x * 255 / width);
+                row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / height);
+                row[x * 4 + 2] = static_cast<uint8_t>(random() & 0x3F);
+                row[x * 4 + 3] = 255;
+            }
+        }
+        DirectX::ScratchImage mipImages;
+        hr = DirectX::GenerateMipMaps(*source, DirectX::TEX_FILTER_DEFAULT, 0, mipImages);
+        CHECK(SUCCEEDED(hr));
+        return mipImages;
+    }
+
+    // DDS ファイルにしたときのバイト列
+    std::vector<uint8_t> SaveToBytes(const DirectX::ScratchImage& image) {
+        DirectX::Blob blob;
+        HRESULT hr = DirectX::SaveToDDSMemory(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::DDS_FLAGS_NONE, blob);
+        CHECK(SUCCEEDED(hr));
+        const uint8_t* bytes = static_cast<const uint8_t*>(blob.GetBufferPointer());
+        return std::vector<uint8_t>(bytes, bytes + blob.GetBufferSize());
+    }
+
+    // 1枚まるごとの圧縮（-j 1）と、workerCount 人でのタイル圧縮が同じ DDS になるか
+    void CheckTiledMatchesSingleCall(size_t width, size_t height, DXGI_FORMAT format, uint32_t workerCount) {
+        DirectX::ScratchImage mipImages = MakeMipImages(width, height);
+
+        DirectX::ScratchImage whole;
+        HRESULT hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+            format, DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, whole);
+        CHECK(SUCCEEDED(hr));
+
+        ThreadPool threadPool;
+        threadPool.Initialize(workerCount);
+        DirectX::ScratchImage tiled;
+        hr = TiledCompression::Compress(mipImages, format, threadPool, tiled);
+        CHECK(SUCCEEDED(hr));
+
+        std::vector<uint8_t> wholeBytes = SaveToBytes(whole);
+        std::vector<uint8_t> tiledBytes = SaveToBytes(tiled);
+        CHECK_EQ(wholeBytes.size(), tiledBytes.size());
+        CHECK(wholeBytes == tiledBytes);
+    }
+}
+
+// 高さはタイル（kTileRows 行）で割り切れない大きさにして、最後の短いタイルと小さなミップマップも通す
+TEST(TiledBC1MatchesSingleCall) {
+    static_assert(200 % TiledCompression::kTileRows != 0);
+    CheckTiledMatchesSingleCall(256, 200, DXGI_FORMAT_BC1_UNORM, 1);
+    CheckTiledMatchesSingleCall(256, 200, DXGI_FORMAT_BC1_UNORM, 3);
+}
+
+TEST(TiledBC7MatchesSingleCall) {
+    CheckTiledMatchesSingleCall(96, 136, DXGI_FORMAT_BC7_UNORM, 3);
+}
@@ -0,0 +1,121 @@
+#include "UploadRingAllocator.h"
+#include "TestFramework.h"
+
+namespace {
+    // GPU の代わり。WaitForFenceValue を呼ばれたらそこまで進める
+    class FakeBackend : public UploadRingAllocator::Backend {
+    public:
+        explicit FakeBackend(size_t capacity) : memory_(capacity) {}
+
+        uint8_t* GetMappedPointer() override { return memory_.data(); }
+        uint64_t GetGpuAddress() override { return kGpuAddress; }
+        uint64_t GetCompletedFenceValue() override { return completedFenceValue; }
+        void WaitForFenceValue(uint64_t fenceValue) override {
+            ++waitCount;
+            completedFenceValue = fenceValue;
+        }
+
+        static constexpr uint64_t kGpuAddress = 0x10000;
+        uint64_t completedFenceValue = 0;
+        uint32_t waitCount = 0;
+
+    private:
+        std::vector<uint8_t> memory_;
+    };
+
+    constexpr uint64_t kCapacity = 4096;
+}
+
+TEST(AllocationsAreAlignedAndAddressed) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    UploadRingAllocator::Allocation first = ring.Allocate(100);
+    UploadRingAllocator::Allocation second = ring.Allocate(100);
+    UploadRingAllocator::Allocation third = ring.Allocate(16, 16);
+    CHECK(first.IsValid() && second.IsValid() && third.IsValid());
+    CHECK_EQ(first.offset, 0u);
+    CHECK_EQ(second.offset, UploadRingAllocator::kDefaultAlignment);
+    CHECK_EQ(third.offset % 16, 0u);
+    CHECK(third.offset >= second.offset + 100);
+    CHECK_EQ(second.gpuAddress, FakeBackend::kGpuAddress + second.offset);
+    CHECK(static_cast<uint8_t*>(second.cpuAddress) == backend.GetMappedPointer() + second.offset);
+}
+
+TEST(ReusesSpaceAfterFencePasses) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    for (uint64_t frame = 1; frame <= 20; ++frame) {
+        for (int i = 0; i < 3; ++i) {
+            CHECK(ring.Allocate(512).IsValid());
+        }
+        ring.FinishFrame(frame);
+        // GPU は 1 フレーム遅れで追いかける
+        backend.completedFenceValue = frame - 1;
+        CHECK(ring.GetUsedSize() <= kCapacity);
+    }
+    // 2 フレーム分（3KB）は 4KB に収まるので、待たずに回っている
+    CHECK_EQ(backend.waitCount, 0u);
+}
+
+TEST(WaitsForOldestFrameWhenFull) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    CHECK(ring.Allocate(3000).IsValid());
+    ring.FinishFrame(1);
+    // GPU はまだ 1 を終えていないので、待ってから切り出す
+    UploadRingAllocator::Allocation allocation = ring.Allocate(3000);
+    CHECK(allocation.IsValid());
+    CHECK_EQ(backend.waitCount, 1u);
+    CHECK_EQ(backend.completedFenceValue, 1u);
+}
+
+TEST(FailsWhenRequestExceedsCapacity) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    CHECK(!ring.Allocate(kCapacity + 1).IsValid());
+    // 失敗しても状態は変わらない
+    CHECK_EQ(ring.GetUsedSize(), 0u);
+    CHECK(ring.Allocate(kCapacity).IsValid());
+}
+
+TEST(FailsWhenCurrentFrameFillsRing) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK(ring.Allocate(1024).IsValid());
+    }
+    // 待てる古いフレームが無いので、待たずに失敗する（呼ぶ側が専用のバッファを使う）
+    CHECK(!ring.Allocate(1024).IsValid());
+    CHECK_EQ(backend.waitCount, 0u);
+
+    // フレームを締めれば、そのフレームを待って再利用できる
+    ring.FinishFrame(1);
+    CHECK(ring.Allocate(1024).IsValid());
+    CHECK_EQ(backend.waitCount, 1u);
+}
+
+TEST(WrapsToStartInsteadOfSplitting) {
+    FakeBackend backend(kCapacity);
+    UploadRingAllocator ring;
+    ring.Initialize(&backend, kCapacity);
+
+    CHECK(ring.Allocate(3072).IsValid());
+    ring.FinishFrame(1);
+    backend.completedFenceValue = 1;
+    CHECK(ring.Allocate(256).IsValid());
+    ring.FinishFrame(2);
+    // 末尾に 768 バイトしか残っていないので先頭に折り返す
+    UploadRingAllocator::Allocation allocation = ring.Allocate(1024);
+    CHECK(allocation.IsValid());
+    CHECK(allocation.offset + allocation.size <= kCapacity);
+}
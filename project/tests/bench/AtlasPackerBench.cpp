@@ -0,0 +1,43 @@
+#include "AtlasPacker.h"
+#include "BenchmarkUtil.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// アトラスへの詰め込みの速さと詰め具合（ページの大きさ・画像の数ごと）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 5;
+
+    std::printf("%-6s %8s %10s %10s %10s\n", "page", "rects", "placed", "ms", "occupancy");
+    for (uint32_t pageSize : { 1024u, 2048u, 4096u }) {
+        for (uint32_t rectCount : { 256u, 2048u }) {
+            if (isQuick && (pageSize > 1024 || rectCount > 256)) {
+                continue;
+            }
+            // アイコン程度の大きさの画像
+            std::mt19937 random(pageSize + rectCount);
+            std::uniform_int_distribution<uint32_t> size(8, 128);
+            std::vector<std::pair<uint32_t, uint32_t>> sizes(rectCount);
+            for (auto& [width, height] : sizes) {
+                width = size(random);
+                height = size(random);
+            }
+
+            uint32_t placed = 0;
+            float occupancy = 0.0f;
+            double ms = Benchmark::MeasureMs(repeat, [&] {
+                AtlasPacker packer;
+                packer.Initialize(pageSize, pageSize);
+                placed = 0;
+                for (const auto& [width, height] : sizes) {
+                    AtlasPacker::Rect rect;
+                    placed += packer.Insert(width, height, rect) ? 1 : 0;
+                }
+                occupancy = packer.GetOccupancy();
+            });
+            std::printf("%-6u %8u %10u %10.3f %9.1f%%\n", pageSize, rectCount, placed, ms, occupancy * 100.0f);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// ベンチマークの共通処理
+namespace Benchmark {
+
+    // --quick が渡されたか（ctest から小さなサイズで1回だけ動かすとき）
+    inline bool IsQuick(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--quick") == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // func を repeat 回実行し、一番速かった1回のミリ秒を返す（他のプロセスの影響を受けにくい）
+    template <typename Func>
+    double MeasureMs(int repeat, Func&& func) {
+        double best = 1.0e30;
+        for (int i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto end = std::chrono::steady_clock::now();
+            best = (std::min)(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    }
+
+}
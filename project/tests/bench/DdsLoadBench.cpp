@@ -0,0 +1,79 @@
+#include "BenchmarkUtil.h"
+#include "DdsLayout.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+// クック済み DDS の読み込みを比べる
+// 以前: LoadFromDDSFile で ScratchImage に読み込んでからアップロード用バッファにコピー
+// 現在: ファイルをマップし、DdsLayout で位置だけ調べてアップロード用バッファに直接コピー
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 5;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "DdsLoadBench";
+    std::filesystem::create_directories(directory);
+
+    std::vector<size_t> sizes = { 1024, 2048, 4096 };
+    if (isQuick) {
+        sizes = { 256 };
+    }
+
+    std::printf("%-6s %8s %10s %14s %12s %10s\n", "format", "size", "MB", "LoadFromDDS", "mapped", "speedup");
+    for (size_t size : sizes) {
+        // 中身は乱数のブロック（読み込みは中身を見ないので圧縮しなくてよい）
+        DirectX::ScratchImage image;
+        if (FAILED(image.Initialize2D(DXGI_FORMAT_BC7_UNORM, size, size, 1, 0))) {
+            return 1;
+        }
+        std::mt19937 random(1);
+        for (size_t i = 0; i < image.GetPixelsSize(); ++i) {
+            image.GetPixels()[i] = static_cast<uint8_t>(random());
+        }
+        const std::filesystem::path filePath = directory / ("bc7_" + std::to_string(size) + ".dds");
+        if (FAILED(DirectX::SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+            DirectX::DDS_FLAGS_FORCE_DX10_EXT, filePath.wstring().c_str()))) {
+            return 1;
+        }
+
+        // アップロード用バッファの代わり
+        std::vector<uint8_t> uploadBuffer(image.GetPixelsSize());
+
+        double scratchMs = Benchmark::MeasureMs(repeat, [&] {
+            DirectX::ScratchImage loaded;
+            DirectX::TexMetadata metadata;
+            if (FAILED(DirectX::LoadFromDDSFile(filePath.wstring().c_str(), DirectX::DDS_FLAGS_NONE, &metadata, loaded))) {
+                std::abort();
+            }
+            uint8_t* destination = uploadBuffer.data();
+            for (size_t i = 0; i < loaded.GetImageCount(); ++i) {
+                const DirectX::Image& subresource = loaded.GetImages()[i];
+                std::memcpy(destination, subresource.pixels, subresource.slicePitch);
+                destination += subresource.slicePitch;
+            }
+        });
+
+        double mappedMs = Benchmark::MeasureMs(repeat, [&] {
+            MappedFile file;
+            DdsLayout layout;
+            if (!file.Open(filePath) || !layout.Parse(file.GetData(), file.GetSize())) {
+                std::abort();
+            }
+            uint8_t* destination = uploadBuffer.data();
+            for (const DdsLayout::Subresource& subresource : layout.subresources) {
+                std::memcpy(destination, file.GetData() + subresource.offset, subresource.slicePitch);
+                destination += subresource.slicePitch;
+            }
+        });
+
+        std::printf("%-6s %8zu %10.1f %14.2f %12.2f %9.2fx\n", "BC7", size,
+            static_cast<double>(uploadBuffer.size()) / (1024.0 * 1024.0), scratchMs, mappedMs, scratchMs / mappedMs);
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
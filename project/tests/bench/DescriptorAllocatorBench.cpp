@@ -0,0 +1,106 @@
+#include "BenchmarkUtil.h"
+#include "DeferredReleaseQueue.h"
+#include "DescriptorAllocator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// デスクリプタ番号の割り当て・解放の速さ（1回あたりのナノ秒）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t frames = isQuick ? 10 : 1000;
+
+    // エンジンと同じ大きさ（常駐 4096、1フレームあたりの一時領域 1024、3フレーム）
+    constexpr uint32_t kPersistentCapacity = 4096;
+    constexpr uint32_t kTransientCapacity = 1024;
+    constexpr uint32_t kFrameCount = 3;
+
+    std::printf("%-34s %10s %10s\n", "operation", "ms", "ns/op");
+    auto report = [](const char* name, double ms, double operations) {
+        std::printf("%-34s %10.3f %10.2f\n", name, ms, ms * 1.0e6 / operations);
+    };
+
+    // 常駐領域：半分まで埋めた状態で、ばらばらの順に解放して割り当て直す（テクスチャの読み込み・破棄）
+    uint32_t checksum = 0;
+    std::mt19937 random(1);
+    const uint32_t churn = kPersistentCapacity / 2;
+    std::vector<uint32_t> live;
+    double persistentMs = Benchmark::MeasureMs(repeat, [&] {
+        DescriptorAllocator allocator;
+        allocator.Initialize(kPersistentCapacity, kTransientCapacity, kFrameCount);
+        live.clear();
+        for (uint32_t i = 0; i < churn; ++i) {
+            live.push_back(allocator.AllocatePersistent());
+        }
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            for (uint32_t i = 0; i < 64; ++i) {
+                uint32_t slot = random() % churn;
+                allocator.FreePersistent(live[slot]);
+                live[slot] = allocator.AllocatePersistent();
+                checksum += live[slot];
+            }
+        }
+    });
+    report("persistent free + allocate", persistentMs, double(churn) + double(frames) * 64.0);
+
+    // 一時領域：毎フレーム空にして、1つずつ / 8個ずつ積む
+    for (uint32_t count : { 1u, 8u }) {
+        const uint32_t perFrame = kTransientCapacity / count;
+        double transientMs = Benchmark::MeasureMs(repeat, [&] {
+            DescriptorAllocator allocator;
+            allocator.Initialize(kPersistentCapacity, kTransientCapacity, kFrameCount);
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                allocator.BeginFrame(frame % kFrameCount);
+                for (uint32_t i = 0; i < perFrame; ++i) {
+                    checksum += allocator.AllocateTransient(count);
+                }
+            }
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "transient allocate (count %u)", count);
+        report(name, transientMs, double(frames) * perFrame);
+    }
+
+    // テクスチャの出し入れ（DirectXCommon::FreeSrvIndex と同じく、解放は GPU が通過してから）
+    // 常駐 1024 枚のうち毎フレーム 32 枚を捨てて読み込み直す（以前の 128 枠のヒープは番号を解放できず、128 枚を超えられなかった）
+    constexpr uint32_t kStreamedPerFrame = 32;
+    constexpr uint32_t kResidentTextures = 1024;
+    uint32_t streamingPeak = 0;
+    uint64_t streamedTextures = 0;
+    double streamingMs = Benchmark::MeasureMs(repeat, [&] {
+        DescriptorAllocator allocator;
+        allocator.Initialize(kPersistentCapacity, kTransientCapacity, kFrameCount);
+        DeferredReleaseQueue retireQueue;
+        std::vector<uint32_t> resident;
+        streamedTextures = 0;
+        for (uint32_t i = 0; i < kResidentTextures; ++i) {
+            resident.push_back(allocator.AllocatePersistent());
+        }
+        for (uint64_t frame = 1; frame <= frames; ++frame) {
+            // kFrameCount フレーム前までは GPU が終わっている
+            if (frame > kFrameCount) {
+                retireQueue.Process(frame - kFrameCount);
+            }
+            for (uint32_t i = 0; i < kStreamedPerFrame; ++i) {
+                uint32_t slot = random() % kResidentTextures;
+                uint32_t index = resident[slot];
+                retireQueue.Push(frame, 0, [&allocator, index] { allocator.FreePersistent(index); });
+                resident[slot] = allocator.AllocatePersistent();
+                if (resident[slot] == DescriptorAllocator::kInvalidIndex) {
+                    std::abort();
+                }
+                checksum += resident[slot];
+            }
+            streamedTextures += kStreamedPerFrame;
+        }
+        streamingPeak = allocator.GetStats().persistentPeak;
+    });
+    report("texture streaming (deferred free)", streamingMs, double(kResidentTextures) + double(streamedTextures));
+    std::printf("streamed %llu textures over %u frames, peak %u of %u persistent slots\n",
+        static_cast<unsigned long long>(streamedTextures), frames, streamingPeak, kPersistentCapacity);
+
+    std::printf("checksum %u\n", checksum);
+    return 0;
+}
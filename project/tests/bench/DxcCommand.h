@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ベンチマークから DXC のコマンドライン版を呼ぶ（エンジンは dxcompiler を直接使うが、計るのはコンパイルそのものの時間）
+// 環境変数 ENGINE_DXC にパスがあればそれを、なければ PATH の dxc を使う。見つからなければ DXC を使う計測は飛ばす
+namespace DxcCommand {
+
+#ifdef _WIN32
+    constexpr const char* kDiscardOutput = " >NUL 2>&1";
+#else
+    constexpr const char* kDiscardOutput = " >/dev/null 2>&1";
+#endif
+
+    // 使う dxc のコマンド。見つからなければ空
+    inline std::string Find() {
+        const char* configured = std::getenv("ENGINE_DXC");
+        std::string command = (configured && *configured) ? "\"" + std::string(configured) + "\"" : std::string("dxc");
+        if (std::system((command + " -help" + kDiscardOutput).c_str()) != 0) {
+            return std::string();
+        }
+        return command;
+    }
+
+    // source をコンパイルし、DXIL を output に書く。引数は DirectXCommon::CompileShader の Debug 以外と同じ
+    // defines は ShaderPermutation::BuildDefineArguments の結果（-D と名前が交互に並ぶ）
+    inline bool Compile(const std::string& dxc, const std::filesystem::path& source, const char* profile,
+        const std::vector<std::wstring>& defines, const std::filesystem::path& output) {
+        std::string command = dxc + " \"" + source.string() + "\" -E main -T " + profile + " -O3 -Zpr";
+        for (const std::wstring& define : defines) {
+            // 機能の名前は ASCII だけ
+            command += " " + std::string(define.begin(), define.end());
+        }
+        command += " -Fo \"" + output.string() + "\"" + kDiscardOutput;
+        return std::system(command.c_str()) == 0;
+    }
+
+    // Compile の出力を読む（無ければ空）
+    inline std::vector<uint8_t> ReadOutput(const std::filesystem::path& output) {
+        std::ifstream file(output, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+}
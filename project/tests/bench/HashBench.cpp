@@ -0,0 +1,31 @@
+#include "BenchmarkUtil.h"
+#include "Hash.h"
+#include <cstdio>
+#include <vector>
+
+// xxHash64 の速さ（シェーダーキャッシュのキー・PSO のハッシュで使う）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const size_t totalBytes = isQuick ? (size_t(1) << 20) : (size_t(256) << 20);
+
+    std::printf("%-10s %12s %10s %12s\n", "size", "calls", "ms", "GB/s");
+    uint64_t checksum = 0;
+    for (size_t size : { size_t(16), size_t(256), size_t(4096), size_t(1) << 20 }) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = uint8_t(i * 31);
+        }
+        size_t calls = (std::max)(totalBytes / size, size_t(1));
+        double ms = Benchmark::MeasureMs(repeat, [&] {
+            for (size_t i = 0; i < calls; ++i) {
+                checksum += Hash::XXH64(data.data(), size, i);
+            }
+        });
+        double gigabytesPerSecond = double(size) * double(calls) / (ms * 1.0e6);
+        std::printf("%-10zu %12zu %10.3f %12.2f\n", size, calls, ms, gigabytesPerSecond);
+    }
+    // 最適化で計算が消されないように使う
+    std::printf("checksum %016llx\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "BenchmarkUtil.h"
+#include "DxcCommand.h"
+#include "JobGraph.h"
+#include "ShaderPermutation.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+// 起動時のパイプライン作成と同じ形のグラフ（シェーダーのコンパイル → PSO 作成）を並列に実行したときの時間
+// DXC の代わりに、1スレッドでコンパイル時間分かかる計算（spin）と、待つだけの仕事（sleep）の2通りで測る
+// dxc が見つかれば、スプライトのシェーダーを実際にコンパイルするグラフも測る
+namespace {
+    // 決まった量の計算をする（時刻で止めると、コアが足りないときも待つだけの仕事と同じ時間で終わってしまう）
+    uint64_t Spin(uint64_t iterations) {
+        uint64_t value = 1;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        return value;
+    }
+
+    // 1 スレッドで duration かかる Spin の回数
+    uint64_t CalibrateSpin(std::chrono::microseconds duration) {
+        const uint64_t probe = 1000000;
+        auto start = std::chrono::steady_clock::now();
+        volatile uint64_t sink = Spin(probe);
+        (void)sink;
+        double probeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<uint64_t>(double(probe) * double(duration.count()) / (std::max)(probeUs, 1.0));
+    }
+
+    // pipelineCount 本のパイプライン。それぞれ VS / PS のコンパイルが終わってから PSO を作る
+    // spinIterations が 0 なら待つだけ、そうでなければその回数だけ計算する（PSO はコンパイルの 1/4）
+    double RunGraph(ThreadPool* threadPool, uint32_t pipelineCount, std::chrono::microseconds compileTime, uint64_t spinIterations) {
+        auto work = [=](uint32_t divisor) {
+            return [=] {
+                if (spinIterations != 0) {
+                    volatile uint64_t sink = Spin(spinIterations / divisor);
+                    (void)sink;
+                } else {
+                    std::this_thread::sleep_for(compileTime / divisor);
+                }
+            };
+        };
+        JobGraph graph;
+        for (uint32_t i = 0; i < pipelineCount; ++i) {
+            JobGraph::JobId vertexShader = graph.Add("VS", work(1));
+            JobGraph::JobId pixelShader = graph.Add("PS", work(1));
+            graph.Add("PSO", work(4), { vertexShader, pixelShader });
+        }
+        graph.Run(threadPool);
+        return graph.GetTotalMs();
+    }
+
+    // SpriteCommon::CreateGraphicsPipelineState と同じグラフ（VS 2つ、PS は ALPHA_TEST の有無で 2x2、PSO 4つ）を dxc で作る
+    // PSO の代わりに、2つのシェーダーの出力を読むだけにする
+    double RunSpriteGraph(ThreadPool* threadPool, const std::string& dxc, const std::filesystem::path& directory, std::atomic<bool>& failed, std::string* report) {
+        const std::filesystem::path shaderDirectory = std::filesystem::path(ENGINE_RESOURCES_DIR) / "shader";
+        JobGraph graph;
+        // 出力はジョブごとに別のファイルにする（同時に書くので）
+        auto compile = [&](const char* fileName, const char* profile, uint32_t features) {
+            std::string name = std::string(fileName) + " [" + ShaderPermutation::BuildVariantName(features) + "]";
+            std::filesystem::path output = directory / (name + ".dxil");
+            JobGraph::JobId id = graph.Add(name, [&dxc, &failed, shaderDirectory, fileName, profile, features, output] {
+                if (!DxcCommand::Compile(dxc, shaderDirectory / fileName, profile, ShaderPermutation::BuildDefineArguments(features), output)) {
+                    failed = true;
+                }
+            });
+            return std::make_pair(id, output);
+        };
+        auto pipeline = [&](const std::string& name, const std::pair<JobGraph::JobId, std::filesystem::path>& vertexShader,
+            const std::pair<JobGraph::JobId, std::filesystem::path>& pixelShader) {
+            graph.Add(name, [vertexShader, pixelShader] {
+                volatile size_t size = DxcCommand::ReadOutput(vertexShader.second).size() + DxcCommand::ReadOutput(pixelShader.second).size();
+                (void)size;
+            }, { vertexShader.first, pixelShader.first });
+        };
+
+        auto vertexShader = compile("Sprite2D.VS.hlsl", "vs_6_0", ShaderFeature::kNone);
+        auto instancedVertexShader = compile("Sprite2DInstanced.VS.hlsl", "vs_6_0", ShaderFeature::kNone);
+        for (uint32_t features : ShaderPermutation::EnumerateVariants(ShaderFeature::kAlphaTest)) {
+            std::string variantName = " [" + ShaderPermutation::BuildVariantName(features) + "]";
+            pipeline("Sprite2D PSO" + variantName, vertexShader, compile("Sprite2D.PS.hlsl", "ps_6_0", features));
+            pipeline("Sprite2DInstanced PSO" + variantName, instancedVertexShader, compile("Sprite2DInstanced.PS.hlsl", "ps_6_0", features));
+        }
+        graph.Run(threadPool);
+        if (report) {
+            *report = graph.BuildReport();
+        }
+        return graph.GetTotalMs();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const uint32_t pipelineCount = isQuick ? 2 : 8;
+    const std::chrono::microseconds compileTime(isQuick ? 1000 : 20000);
+    const uint64_t spinIterations = (std::max)(CalibrateSpin(compileTime), uint64_t(1));
+
+    std::printf("pipelines %u, compile %lld us each (%u hardware threads)\n",
+        pipelineCount, static_cast<long long>(compileTime.count()), std::thread::hardware_concurrency());
+    std::printf("%-8s %12s %12s\n", "threads", "spin ms", "sleep ms");
+    for (uint32_t threadCount : { 1u, 2u, 4u, 8u }) {
+        if (isQuick && threadCount > 2) {
+            continue;
+        }
+        // 1 は ThreadPool を使わずにその場で順に実行する（今までの起動と同じ）
+        std::unique_ptr<ThreadPool> threadPool;
+        if (threadCount > 1) {
+            threadPool = std::make_unique<ThreadPool>();
+            threadPool->Initialize(threadCount);
+        }
+        double spinMs = RunGraph(threadPool.get(), pipelineCount, compileTime, spinIterations);
+        double sleepMs = RunGraph(threadPool.get(), pipelineCount, compileTime, 0);
+        std::printf("%-8u %12.3f %12.3f\n", threadCount, spinMs, sleepMs);
+    }
+
+    std::string dxc = DxcCommand::Find();
+    if (dxc.empty()) {
+        std::printf("\ndxc not found (set ENGINE_DXC or add dxc to PATH): sprite shaders are not compiled\n");
+        return 0;
+    }
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("JobGraphBench_" + std::to_string(ticks));
+    std::filesystem::create_directories(directory);
+
+    std::printf("\nsprite shaders with dxc (6 compiles, 4 PSOs)\n");
+    std::printf("%-8s %12s\n", "threads", "ms");
+    std::atomic<bool> failed = false;
+    std::string report;
+    for (uint32_t threadCount : { 1u, 2u, 4u, 8u }) {
+        if (isQuick && threadCount > 2) {
+            continue;
+        }
+        std::unique_ptr<ThreadPool> threadPool;
+        if (threadCount > 1) {
+            threadPool = std::make_unique<ThreadPool>();
+            threadPool->Initialize(threadCount);
+        }
+        double ms = RunSpriteGraph(threadPool.get(), dxc, directory, failed, &report);
+        std::printf("%-8u %12.3f\n", threadCount, ms);
+    }
+    // 一番多いスレッド数のときのジョブごとの時間
+    std::printf("%s", report.c_str());
+    if (failed) {
+        std::printf("dxc failed: times are not valid\n");
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "BenchmarkUtil.h"
+#include "MathConstexpr.h"
+#include "Matrix.h"
+#include <cstdio>
+#include <vector>
+
+// ヘッダーの constexpr 版（インライン展開される）と Matrix.cpp の関数呼び出し版の比較
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t count = isQuick ? 1000 : 1000000;
+
+    std::vector<Matrix4x4> matrices(count);
+    std::vector<Vector3> points(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        float t = float(i % 1000) * 0.001f;
+        matrices[i] = MatrixMath::MakeAffineMatrix({ 1.0f + t, 1.0f, 1.0f - t * 0.5f }, { t, t * 2.0f, t * 3.0f }, { t * 10.0f, -t, 5.0f });
+        points[i] = { t, 1.0f - t, t * 2.0f };
+    }
+    std::vector<Matrix4x4> results(count);
+    std::vector<Vector3> transformed(count);
+
+    std::printf("%-28s %12s %12s %8s\n", "operation", "out-of-line", "constexpr", "speedup");
+    auto report = [](const char* name, double outOfLineMs, double constexprMs) {
+        std::printf("%-28s %12.3f %12.3f %7.2fx\n", name, outOfLineMs, constexprMs, outOfLineMs / constexprMs);
+    };
+
+    // 以前の Sprite::Update と同じく、毎回ビュー（単位行列）と正射影行列を作って掛ける
+    constexpr Matrix4x4 kViewProjection = MathConstexpr::Multiply(
+        MathConstexpr::MakeIdentity4x4(),
+        MathConstexpr::MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f));
+    report("world * viewProjection",
+        Benchmark::MeasureMs(repeat, [&] {
+            for (uint32_t i = 0; i < count; ++i) {
+                Matrix4x4 viewMatrix = MatrixMath::MakeIdentity4x4();
+                Matrix4x4 projectionMatrix = MatrixMath::MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f);
+                results[i] = MatrixMath::Scalar::Multiply(matrices[i], MatrixMath::Scalar::Multiply(viewMatrix, projectionMatrix));
+            }
+        }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MathConstexpr::Multiply(matrices[i], kViewProjection); } }));
+    report("Multiply",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Scalar::Multiply(matrices[i], kViewProjection); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MathConstexpr::Multiply(matrices[i], kViewProjection); } }));
+    report("Transform",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { transformed[i] = MatrixMath::Scalar::Transform(points[i], matrices[i]); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { transformed[i] = MathConstexpr::Transform(points[i], matrices[i]); } }));
+
+    // 最適化で計算が消されないように使う
+    float checksum = 0.0f;
+    for (uint32_t i = 0; i < count; i += 97) {
+        checksum += results[i].m[3][0] + transformed[i].x;
+    }
+    std::printf("checksum %f\n", checksum);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "BenchmarkUtil.h"
+#include "Matrix.h"
+#include "ModelLoader.h"
+#include <cstdio>
+#include <vector>
+
+// 行列演算のスカラー版と SIMD 版（ビルド設定で SSE / AVX2 / NEON）の比較
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t count = isQuick ? 1000 : 1000000;
+
+    std::vector<Vector3> scales(count);
+    std::vector<Vector3> rotates(count);
+    std::vector<Vector3> translates(count);
+    std::vector<Matrix4x4> matrices(count);
+    std::vector<Vector3> points(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        float t = float(i % 1000) * 0.001f;
+        scales[i] = { 1.0f + t, 1.0f, 1.0f - t * 0.5f };
+        rotates[i] = { t, t * 2.0f, t * 3.0f };
+        translates[i] = { t * 10.0f, -t, 5.0f };
+        matrices[i] = MatrixMath::MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+        points[i] = { t, 1.0f - t, t * 2.0f };
+    }
+    Matrix4x4 viewProjection = MatrixMath::Multiply(
+        MatrixMath::InverseRigid(MatrixMath::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.2f, 0.0f }, { 0.0f, 2.0f, -10.0f })),
+        MatrixMath::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+    std::vector<Matrix4x4> results(count);
+    std::vector<Vector3> transformed(count);
+    std::vector<float> x(count), y(count), z(count);
+    Vector3SoA out = { x.data(), y.data(), z.data() };
+
+    std::printf("%-28s %10s %10s %8s\n", "operation", "scalar ms", "simd ms", "speedup");
+    auto report = [](const char* name, double scalarMs, double simdMs) {
+        std::printf("%-28s %10.3f %10.3f %7.2fx\n", name, scalarMs, simdMs, scalarMs / simdMs);
+    };
+
+    report("Multiply",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Scalar::Multiply(matrices[i], viewProjection); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Multiply(matrices[i], viewProjection); } }));
+    report("MakeAffineMatrix",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Scalar::MakeAffineMatrix(scales[i], rotates[i], translates[i]); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::MakeAffineMatrix(scales[i], rotates[i], translates[i]); } }));
+    report("Inverse",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Scalar::Inverse(matrices[i]); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Inverse(matrices[i]); } }));
+    report("Inverse -> InverseAffine",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::Inverse(matrices[i]); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { results[i] = MatrixMath::InverseAffine(matrices[i]); } }));
+    report("Transform",
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { transformed[i] = MatrixMath::Scalar::Transform(points[i], viewProjection); } }),
+        Benchmark::MeasureMs(repeat, [&] { for (uint32_t i = 0; i < count; ++i) { transformed[i] = MatrixMath::Transform(points[i], viewProjection); } }));
+    report("Transform -> TransformPoints",
+        Benchmark::MeasureMs(repeat, [&] {
+            for (uint32_t i = 0; i < count; ++i) {
+                Vector3 point = MatrixMath::Scalar::Transform(points[i], viewProjection);
+                x[i] = point.x;
+                y[i] = point.y;
+                z[i] = point.z;
+            }
+        }),
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformPoints(points, viewProjection, out); }));
+    report("TransformPoints -> Affine",
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformPoints(points, matrices[0], out); }),
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformAffinePoints(points, matrices[0], out); }));
+
+    // Resources のモデルの頂点を並べて count 個にしたもの（カリング・ピッキングで1メッシュ分を変換するときの形）
+    // terrain.obj はリポジトリに無いので、axis.obj をずらしながら複製する
+    ModelLoader::ModelData model;
+    if (!ModelLoader::Load(std::filesystem::path(ENGINE_RESOURCES_DIR) / "axis.obj", model) || model.vertices.empty()) {
+        std::printf("failed to load axis.obj\n");
+        return 1;
+    }
+    std::vector<Vector3> meshPoints(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Vector4& position = model.vertices[i % model.vertices.size()].position;
+        float offset = float(i / model.vertices.size() % 1000) * 0.01f;
+        meshPoints[i] = { position.x + offset, position.y, position.z - offset };
+    }
+    report("mesh Transform -> Points",
+        Benchmark::MeasureMs(repeat, [&] {
+            for (uint32_t i = 0; i < count; ++i) {
+                Vector3 point = MatrixMath::Scalar::Transform(meshPoints[i], viewProjection);
+                x[i] = point.x;
+                y[i] = point.y;
+                z[i] = point.z;
+            }
+        }),
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformPoints(meshPoints, viewProjection, out); }));
+    report("mesh Points -> Affine",
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformPoints(meshPoints, matrices[0], out); }),
+        Benchmark::MeasureMs(repeat, [&] { MatrixMath::TransformAffinePoints(meshPoints, matrices[0], out); }));
+    std::printf("mesh: axis.obj (%zu vertices) x %zu\n", model.vertices.size(), (count + model.vertices.size() - 1) / model.vertices.size());
+
+    // 最適化で計算が消されないように使う
+    float checksum = 0.0f;
+    for (uint32_t i = 0; i < count; i += 97) {
+        checksum += results[i].m[3][0] + transformed[i].x + x[i];
+    }
+    std::printf("checksum %f\n", checksum);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "BenchmarkUtil.h"
+#include "ModelLoader.h"
+#include "ThreadPool.h"
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+namespace {
+    // gridSize x gridSize の四角形の格子
+    std::string MakeGridObj(uint32_t gridSize) {
+        std::string text;
+        char line[128];
+        for (uint32_t y = 0; y <= gridSize; ++y) {
+            for (uint32_t x = 0; x <= gridSize; ++x) {
+                std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\n",
+                    x * 0.01f, y * 0.01f, (x ^ y) * 0.0001f, float(x) / gridSize, float(y) / gridSize);
+                text += line;
+            }
+        }
+        text += "vn 0.0000 0.0000 1.0000\no Grid\n";
+        for (uint32_t y = 0; y < gridSize; ++y) {
+            for (uint32_t x = 0; x < gridSize; ++x) {
+                uint32_t i0 = y * (gridSize + 1) + x + 1;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + gridSize + 2;
+                uint32_t i3 = i0 + gridSize + 1;
+                std::snprintf(line, sizeof(line), "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", i0, i0, i1, i1, i2, i2, i3, i3);
+                text += line;
+            }
+        }
+        return text;
+    }
+
+    // スレッド数ごとに読み込みの速さを測って表にする
+    bool RunParse(const std::string& text, int repeat, std::initializer_list<uint32_t> threadCounts) {
+        std::printf("OBJ %.3f MB (%u hardware threads)\n", double(text.size()) / (1024.0 * 1024.0), std::thread::hardware_concurrency());
+        std::printf("%-8s %10s %10s %12s\n", "threads", "ms", "MB/s", "triangles");
+        for (uint32_t threadCount : threadCounts) {
+            std::unique_ptr<ThreadPool> threadPool;
+            if (threadCount > 1) {
+                threadPool = std::make_unique<ThreadPool>();
+                threadPool->Initialize(threadCount - 1);
+            }
+            ModelLoader::ModelData model;
+            bool isLoaded = true;
+            double ms = Benchmark::MeasureMs(repeat, [&] {
+                model = {};
+                isLoaded = ModelLoader::Parse(text.data(), text.size(), ".", model, threadPool.get());
+            });
+            if (!isLoaded) {
+                std::printf("parse failed\n");
+                return false;
+            }
+            double megabytesPerSecond = double(text.size()) / (1024.0 * 1024.0) / (ms / 1000.0);
+            std::printf("%-8u %10.3f %10.1f %12zu\n", threadCount, ms, megabytesPerSecond, model.indices.size() / 3);
+        }
+        return true;
+    }
+}
+
+// OBJ の読み込みの速さ（スレッド数ごと）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 5;
+
+    // 大きなファイルはチャンクに分けて並列に読む
+    if (!RunParse(MakeGridObj(isQuick ? 100 : 1000), repeat, isQuick ? std::initializer_list<uint32_t>{ 1u, 2u } : std::initializer_list<uint32_t>{ 1u, 2u, 4u, 8u })) {
+        return 1;
+    }
+    // 小さなファイルはプールを渡しても1つずつ読む（スレッド数で遅くならない）
+    std::printf("\n");
+    if (!RunParse(MakeGridObj(16), isQuick ? 10 : 1000, { 1u, 4u })) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "BenchmarkUtil.h"
+#include "DxcCommand.h"
+#include "ShaderCache.h"
+#include "ShaderPermutation.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // スプライトの起動時と同じシェーダー（SpriteCommon::CreateGraphicsPipelineState）を、キャッシュが空のときとあるときで読み込む
+    // キャッシュが空なら キー + DXC + 保存、あれば キー + 読み込み
+    void RunSpriteStartup(const std::string& dxc, const std::filesystem::path& directory, int repeat) {
+        struct Shader {
+            const char* fileName;
+            const char* profile;
+            uint32_t features;
+        };
+        std::vector<Shader> shaders = {
+            { "Sprite2D.VS.hlsl", "vs_6_0", ShaderFeature::kNone },
+            { "Sprite2DInstanced.VS.hlsl", "vs_6_0", ShaderFeature::kNone },
+        };
+        for (uint32_t features : ShaderPermutation::EnumerateVariants(ShaderFeature::kAlphaTest)) {
+            shaders.push_back({ "Sprite2D.PS.hlsl", "ps_6_0", features });
+            shaders.push_back({ "Sprite2DInstanced.PS.hlsl", "ps_6_0", features });
+        }
+
+        const std::filesystem::path shaderDirectory = std::filesystem::path(ENGINE_RESOURCES_DIR) / "shader";
+        const std::filesystem::path cacheDirectory = directory / "spriteCache";
+        const std::filesystem::path outputPath = directory / "output.dxil";
+        bool failed = false;
+        auto startup = [&] {
+            ShaderCache cache;
+            cache.Initialize(cacheDirectory);
+            for (const Shader& shader : shaders) {
+                const std::filesystem::path source = shaderDirectory / shader.fileName;
+                std::vector<std::wstring> defines = ShaderPermutation::BuildDefineArguments(shader.features);
+                std::wstring profile(shader.profile, shader.profile + std::char_traits<char>::length(shader.profile));
+                std::vector<std::wstring> arguments = { source.wstring(), L"-E", L"main", L"-T", profile, L"-O3", L"-Zpr" };
+                arguments.insert(arguments.end(), defines.begin(), defines.end());
+
+                uint64_t key = ShaderCache::ComputeKey(source, arguments);
+                MappedFile bytecode;
+                if (cache.Load(key, bytecode)) {
+                    continue;
+                }
+                if (!DxcCommand::Compile(dxc, source, shader.profile, defines, outputPath)) {
+                    failed = true;
+                    continue;
+                }
+                std::vector<uint8_t> compiled = DxcCommand::ReadOutput(outputPath);
+                cache.Store(key, compiled.data(), compiled.size());
+            }
+        };
+
+        double coldMs = Benchmark::MeasureMs(repeat, [&] {
+            std::error_code error;
+            std::filesystem::remove_all(cacheDirectory, error);
+            startup();
+        });
+        double warmMs = Benchmark::MeasureMs(repeat, startup);
+
+        std::printf("\nsprite shaders with dxc (%zu compiles)%s\n", shaders.size(), failed ? ": dxc failed, times are not valid" : "");
+        std::printf("%-24s %10s\n", "startup", "ms");
+        std::printf("%-24s %10.3f\n", "cold (compile + Store)", coldMs);
+        std::printf("%-24s %10.3f\n", "warm (Load)", warmMs);
+    }
+}
+
+// 起動時にシェーダーキャッシュが足す時間（キーの計算とヒット時の読み込み）
+// dxc が見つかれば、スプライトのシェーダーを実際にコンパイルして、キャッシュが空のときとあるときの起動時間も比べる
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t shaderCount = isQuick ? 8 : 64;
+    // DXIL の大きさの目安（スプライトのシェーダーは数 KB）
+    const size_t bytecodeSize = 8 * 1024;
+
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("ShaderCacheBench_" + std::to_string(ticks));
+    std::filesystem::create_directories(directory);
+
+    // 共通の .hlsli を2段たどるシェーダーを並べる
+    {
+        std::ofstream(directory / "Common.hlsli") << "#include \"Math.hlsli\"\nstruct VertexShaderOutput { float4 position : SV_POSITION; };\n";
+        std::ofstream math(directory / "Math.hlsli");
+        for (int i = 0; i < 200; ++i) {
+            math << "float Helper" << i << "(float x) { return x * " << i << ".0f; }\n";
+        }
+    }
+    std::vector<std::filesystem::path> sources;
+    for (uint32_t i = 0; i < shaderCount; ++i) {
+        sources.push_back(directory / ("Shader" + std::to_string(i) + ".hlsl"));
+        std::ofstream(sources.back()) << "#include \"Common.hlsli\"\n// shader " << i << "\nfloat4 main() : SV_TARGET { return Helper1(1.0f); }\n";
+    }
+    const std::vector<std::wstring> arguments = { L"-E", L"main", L"-T", L"ps_6_0", L"-O3" };
+
+    ShaderCache cache;
+    cache.Initialize(directory / "cache");
+    std::vector<uint64_t> keys(shaderCount);
+    std::vector<uint8_t> bytecode(bytecodeSize, 0x5a);
+
+    double keyMs = Benchmark::MeasureMs(repeat, [&] {
+        for (uint32_t i = 0; i < shaderCount; ++i) {
+            keys[i] = ShaderCache::ComputeKey(sources[i], arguments);
+        }
+    });
+    double storeMs = Benchmark::MeasureMs(repeat, [&] {
+        for (uint32_t i = 0; i < shaderCount; ++i) {
+            cache.Store(keys[i], bytecode.data(), bytecode.size());
+        }
+    });
+    size_t loadedBytes = 0;
+    double hitMs = Benchmark::MeasureMs(repeat, [&] {
+        loadedBytes = 0;
+        for (uint32_t i = 0; i < shaderCount; ++i) {
+            MappedFile loaded;
+            if (cache.Load(keys[i], loaded)) {
+                loadedBytes += loaded.GetSize();
+            }
+        }
+    });
+
+    std::printf("shaders %u, bytecode %zu bytes each\n", shaderCount, bytecodeSize);
+    std::printf("%-24s %10s %14s\n", "step", "ms", "us/shader");
+    auto report = [&](const char* name, double ms) {
+        std::printf("%-24s %10.3f %14.2f\n", name, ms, ms * 1000.0 / shaderCount);
+    };
+    report("ComputeKey", keyMs);
+    report("Store", storeMs);
+    report("Load (hit)", hitMs);
+    std::printf("loaded %zu bytes, hits %u, misses %u\n", loadedBytes, cache.GetStats().hitCount, cache.GetStats().missCount);
+
+    std::string dxc = DxcCommand::Find();
+    if (dxc.empty()) {
+        std::printf("\ndxc not found (set ENGINE_DXC or add dxc to PATH): compile time is not measured\n");
+    } else {
+        RunSpriteStartup(dxc, directory, isQuick ? 1 : 3);
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "BenchmarkUtil.h"
+#include "SpriteBatch.h"
+#include <cstdio>
+#include <vector>
+
+// 1フレーム分のスプライトを集めてテクスチャ順に並べ、頂点列と描画範囲を作る速さ（枚数・テクスチャ数ごと）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+
+    std::printf("%-10s %10s %10s %10s %12s\n", "sprites", "textures", "ms", "draws", "ns/sprite");
+    for (uint32_t count : { 1000u, 10000u, 100000u }) {
+        for (uint32_t textureCount : { 1u, 16u, 256u }) {
+            if (isQuick && (count > 1000 || textureCount > 16)) {
+                continue;
+            }
+            // 頂点は中身に関係なく同じ手間なので、位置だけずらしたものを使う
+            std::vector<SpriteBatch::Vertex> source(count * SpriteBatch::kVerticesPerSprite);
+            for (uint32_t i = 0; i < source.size(); ++i) {
+                source[i] = {};
+                source[i].position = { float(i % 1280), float(i % 720), 0.0f, 1.0f };
+            }
+            std::vector<SpriteBatch::Vertex> sorted(source.size());
+
+            SpriteBatch batch;
+            double ms = Benchmark::MeasureMs(repeat, [&] {
+                batch.Begin();
+                for (uint32_t i = 0; i < count; ++i) {
+                    // テクスチャがばらばらの順で登録される（並べ替えが効く）場合
+                    const SpriteBatch::Vertex(&quad)[SpriteBatch::kVerticesPerSprite] =
+                        *reinterpret_cast<const SpriteBatch::Vertex(*)[SpriteBatch::kVerticesPerSprite]>(&source[i * SpriteBatch::kVerticesPerSprite]);
+                    batch.Add((i * 7) % textureCount, quad);
+                }
+                batch.End();
+                batch.WriteVertices(sorted.data());
+            });
+            std::printf("%-10u %10u %10.3f %10zu %12.1f\n", count, textureCount, ms, batch.GetDrawRuns().size(), ms * 1.0e6 / count);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "BenchmarkUtil.h"
+#include "SpriteQuad.h"
+#include <cstdio>
+#include <vector>
+
+// Sprite::Update（SpriteQuad）の1フレーム分の速さ。ほとんど動かないスプライトで、変更フラグで作り直しを省けるか
+// 「全部」は毎フレーム全スプライトを動かした場合（変更フラグが無かったときと同じく毎回作り直す）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const uint32_t count = isQuick ? 1000 : 100000;
+    const int repeat = isQuick ? 1 : 20;
+    const Vector2 textureSize = { 64.0f, 64.0f };
+
+    std::vector<SpriteQuad> quads(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        quads[i].SetTexture(textureSize);
+        quads[i].SetPosition({ float(i % 1280), float(i % 720) });
+        quads[i].SetRotation(float(i) * 0.001f);
+        quads[i].SetAnchorPoint({ 0.5f, 0.5f });
+        quads[i].Update(textureSize);
+    }
+
+    std::printf("%-10s %10s %10s %10s %10s %12s\n", "sprites", "moving", "updated", "skipped", "ms", "ns/sprite");
+    float frame = 0.0f;
+    // 毎フレーム動かすスプライトの割合（1/step）
+    for (uint32_t step : { 1u, 10u, 100u, 1000u }) {
+        uint32_t updated = 0;
+        double ms = Benchmark::MeasureMs(repeat, [&] {
+            frame += 1.0f;
+            for (uint32_t i = 0; i < count; i += step) {
+                quads[i].SetPosition({ float(i % 1280) + frame, float(i % 720) });
+            }
+            updated = 0;
+            for (SpriteQuad& quad : quads) {
+                updated += quad.Update(textureSize) ? 1 : 0;
+            }
+        });
+        char moving[16];
+        std::snprintf(moving, sizeof(moving), step == 1 ? "all" : "1/%u", step);
+        std::printf("%-10u %10s %10u %10u %10.3f %12.2f\n", count, moving, updated, count - updated, ms, ms * 1.0e6 / count);
+    }
+    return 0;
+}
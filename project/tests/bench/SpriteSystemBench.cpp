@@ -0,0 +1,74 @@
+#include "BenchmarkUtil.h"
+#include "SpriteBatch.h"
+#include "SpriteQuad.h"
+#include "SpriteSystem.h"
+#include "ThreadPool.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// 大量のスプライトの頂点・インスタンスを書き込む速さ（スレッド数ごと）
+// 比べる相手は1枚ずつのオブジェクト（Sprite と同じく1枚ずつ確保した SpriteQuad の Update で頂点を作り、バッチの頂点列へ写す）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t count = isQuick ? 10000 : 1000000;
+
+    SpriteSystem spriteSystem;
+    for (uint32_t i = 0; i < count; ++i) {
+        SpriteSystem::Handle handle = spriteSystem.Create(i % 8, { 64.0f, 64.0f });
+        spriteSystem.SetPosition(handle, { float(i % 1280), float(i % 720) });
+        spriteSystem.SetRotation(handle, float(i) * 0.001f);
+    }
+    std::vector<SpriteBatch::Vertex> vertices(count * SpriteBatch::kVerticesPerSprite);
+    std::vector<SpriteInstance> instances(count);
+    const uint32_t srvIndices[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    // 1枚ずつのオブジェクト（main.cpp の new Sprite と同じ持ち方）
+    const Vector2 textureSize = { 64.0f, 64.0f };
+    std::vector<std::unique_ptr<SpriteQuad>> quads(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        quads[i] = std::make_unique<SpriteQuad>();
+        quads[i]->SetTexture(textureSize);
+        quads[i]->SetPosition({ float(i % 1280), float(i % 720) });
+        quads[i]->SetRotation(float(i) * 0.001f);
+    }
+    float frame = 0.0f;
+    auto updateQuads = [&](bool isMoving) {
+        frame += 1.0f;
+        SpriteBatch::Vertex* out = vertices.data();
+        for (uint32_t i = 0; i < count; ++i) {
+            SpriteQuad& quad = *quads[i];
+            if (isMoving) {
+                quad.SetRotation(float(i) * 0.001f + frame * 0.01f);
+            }
+            quad.Update(textureSize);
+            std::memcpy(out, quad.GetVertices(), sizeof(SpriteBatch::Vertex) * SpriteBatch::kVerticesPerSprite);
+            out += SpriteBatch::kVerticesPerSprite;
+        }
+    };
+    // SpriteSystem は毎回すべて作り直すので、比べるのは全部が動いているとき
+    double perObjectMs = Benchmark::MeasureMs(repeat, [&] { updateQuads(true); });
+    double perObjectStaticMs = Benchmark::MeasureMs(repeat, [&] { updateQuads(false); });
+
+    std::printf("sprites %u (%u hardware threads)\n", count, std::thread::hardware_concurrency());
+    std::printf("per-object SpriteQuad: all moving %.3f ms, none moving %.3f ms\n", perObjectMs, perObjectStaticMs);
+    std::printf("%-8s %14s %14s %14s %14s\n", "threads", "vertices ms", "instances ms", "vs per-object", "bytes ratio");
+    for (uint32_t threadCount : { 1u, 2u, 4u, 8u }) {
+        if (isQuick && threadCount > 2) {
+            continue;
+        }
+        // 呼び出し元のスレッドも仕事をするので、ワーカーは1人少なくてよい
+        std::unique_ptr<ThreadPool> threadPool;
+        if (threadCount > 1) {
+            threadPool = std::make_unique<ThreadPool>();
+            threadPool->Initialize(threadCount - 1);
+        }
+        double verticesMs = Benchmark::MeasureMs(repeat, [&] { spriteSystem.WriteVertices(vertices, threadPool.get()); });
+        double instancesMs = Benchmark::MeasureMs(repeat, [&] { spriteSystem.WriteInstances(instances, srvIndices, threadPool.get()); });
+        double bytesRatio = double(sizeof(SpriteInstance)) / double(sizeof(SpriteBatch::Vertex) * SpriteBatch::kVerticesPerSprite);
+        std::printf("%-8u %14.3f %14.3f %13.2fx %14.2f\n", threadCount, verticesMs, instancesMs, perObjectMs / verticesMs, bytesRatio);
+    }
+    return 0;
+}
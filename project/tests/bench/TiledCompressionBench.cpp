@@ -0,0 +1,66 @@
+#include "BenchmarkUtil.h"
+#include "ThreadPool.h"
+#include "TiledCompression.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+// TextureCooker の圧縮をスレッド数ごとに比べる（1 は DirectXTex に1枚まるごと渡す、-j 1 と同じ）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 3;
+    const uint32_t hardwareThreads = (std::max)(1u, std::thread::hardware_concurrency());
+
+    struct Case {
+        DXGI_FORMAT format;
+        const char* name;
+        size_t size;
+    };
+    // BC7 は CPU では遅いので小さめにする
+    const Case cases[] = {
+        { DXGI_FORMAT_BC1_UNORM, "BC1", isQuick ? 128u : 1024u },
+        { DXGI_FORMAT_BC7_UNORM, "BC7", isQuick ? 64u : 256u },
+    };
+
+    std::printf("%u hardware threads\n", hardwareThreads);
+    std::printf("%-6s %10s %8s %12s %10s\n", "format", "size", "threads", "ms", "speedup");
+    for (const Case& testCase : cases) {
+        DirectX::ScratchImage image;
+        if (FAILED(image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, testCase.size, testCase.size, 1, 1))) {
+            return 1;
+        }
+        const DirectX::Image* source = image.GetImage(0, 0, 0);
+        std::mt19937 random(1);
+        for (size_t i = 0; i < source->slicePitch; ++i) {
+            source->pixels[i] = static_cast<uint8_t>(random());
+        }
+        DirectX::ScratchImage mipImages;
+        if (FAILED(DirectX::GenerateMipMaps(*source, DirectX::TEX_FILTER_DEFAULT, 0, mipImages))) {
+            return 1;
+        }
+
+        double singleMs = 0.0;
+        for (uint32_t threadCount : { 1u, 2u, 4u, hardwareThreads }) {
+            if (isQuick && threadCount > 2) {
+                continue;
+            }
+            DirectX::ScratchImage compressed;
+            double ms = 0.0;
+            if (threadCount == 1) {
+                ms = Benchmark::MeasureMs(repeat, [&] {
+                    DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+                        testCase.format, DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+                });
+                singleMs = ms;
+            } else {
+                // 呼び出し元のスレッドも圧縮するので、ワーカーは1人少なくてよい
+                ThreadPool threadPool;
+                threadPool.Initialize(threadCount - 1);
+                ms = Benchmark::MeasureMs(repeat, [&] { TiledCompression::Compress(mipImages, testCase.format, threadPool, compressed); });
+            }
+            std::printf("%-6s %10zu %8u %12.1f %9.2fx\n", testCase.name, testCase.size, threadCount, ms, singleMs / ms);
+        }
+    }
+    return 0;
+}
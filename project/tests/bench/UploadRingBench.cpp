@@ -0,0 +1,84 @@
+#include "BenchmarkUtil.h"
+#include "UploadRingAllocator.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+    // GPU の代わり。lag フレーム遅れで完了していく
+    class FakeBackend : public UploadRingAllocator::Backend {
+    public:
+        explicit FakeBackend(size_t capacity) : memory_(capacity) {}
+
+        uint8_t* GetMappedPointer() override { return memory_.data(); }
+        uint64_t GetGpuAddress() override { return 0x10000; }
+        uint64_t GetCompletedFenceValue() override { return completedFenceValue; }
+        void WaitForFenceValue(uint64_t fenceValue) override {
+            ++waitCount;
+            completedFenceValue = fenceValue;
+        }
+
+        uint64_t completedFenceValue = 0;
+        uint64_t waitCount = 0;
+
+    private:
+        std::vector<uint8_t> memory_;
+    };
+}
+
+// 1フレームに小さな定数バッファをたくさん切り出すときの速さ
+// 比べる相手は「切り出すたびにヒープから確保する」場合（CreateBufferResource はこれよりずっと重い）
+int main(int argc, char* argv[]) {
+    bool isQuick = Benchmark::IsQuick(argc, argv);
+    const int repeat = isQuick ? 1 : 10;
+    const uint32_t frameCount = isQuick ? 10 : 100;
+    const uint64_t capacity = 16ull * 1024 * 1024;
+
+    std::printf("%-8s %10s %6s %12s %12s %8s\n", "size", "per frame", "lag", "ring ns", "new ns", "waits");
+    for (uint64_t size : { 64ull, 256ull, 4096ull }) {
+        for (uint32_t allocationsPerFrame : { 1000u, 10000u }) {
+            for (uint64_t lag : { 1ull, 2ull }) {
+                if (isQuick && (allocationsPerFrame > 1000 || lag > 1)) {
+                    continue;
+                }
+                // 1フレーム分が (lag + 1) フレーム分収まらない組み合わせは毎フレーム待つだけなので省く
+                if (size * allocationsPerFrame * (lag + 1) > capacity) {
+                    continue;
+                }
+                FakeBackend backend(capacity);
+                UploadRingAllocator ring;
+                ring.Initialize(&backend, capacity);
+                uint64_t fenceValue = 0;
+                uint64_t checksum = 0;
+                double ringMs = Benchmark::MeasureMs(repeat, [&] {
+                    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                        for (uint32_t i = 0; i < allocationsPerFrame; ++i) {
+                            checksum += ring.Allocate(size).offset;
+                        }
+                        ring.FinishFrame(++fenceValue);
+                        backend.completedFenceValue = fenceValue > lag ? fenceValue - lag : 0;
+                    }
+                });
+
+                double newMs = Benchmark::MeasureMs(repeat, [&] {
+                    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                        for (uint32_t i = 0; i < allocationsPerFrame; ++i) {
+                            std::unique_ptr<uint8_t[]> buffer(new uint8_t[size]);
+                            buffer[0] = uint8_t(i);
+                            checksum += buffer[0];
+                        }
+                    }
+                });
+
+                double allocations = double(frameCount) * allocationsPerFrame;
+                std::printf("%-8llu %10u %6llu %12.1f %12.1f %8llu\n", static_cast<unsigned long long>(size), allocationsPerFrame,
+                    static_cast<unsigned long long>(lag), ringMs * 1.0e6 / allocations, newMs * 1.0e6 / allocations,
+                    static_cast<unsigned long long>(backend.waitCount));
+                if (checksum == 1) {
+                    std::printf("\n");
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "TiledCompression.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+HRESULT TiledCompression::Compress(const DirectX::ScratchImage& mipImages, DXGI_FORMAT format, ThreadPool& threadPool, DirectX::ScratchImage& compressed) {
+    DirectX::TexMetadata metadata = mipImages.GetMetadata();
+    metadata.format = format;
+    HRESULT hr = compressed.Initialize(metadata);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // タイルの一覧（どの画像の何行目から何行か）
+    struct Tile {
+        size_t imageIndex;
+        size_t y;
+        size_t height;
+    };
+    std::vector<Tile> tiles;
+    const DirectX::Image* sourceImages = mipImages.GetImages();
+    for (size_t i = 0; i < mipImages.GetImageCount(); ++i) {
+        for (size_t y = 0; y < sourceImages[i].height; y += kTileRows) {
+            tiles.push_back({ i, y, (std::min)(kTileRows, sourceImages[i].height - y) });
+        }
+    }
+
+    // タイルごとの結果（どれか1つでも失敗したら全体を失敗にする）
+    std::vector<HRESULT> results(tiles.size(), S_OK);
+    const DirectX::Image* destinationImages = compressed.GetImages();
+
+    threadPool.ParallelFor(static_cast<uint32_t>(tiles.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t t = begin; t < end; ++t) {
+            const Tile& tile = tiles[t];
+            const DirectX::Image& source = sourceImages[tile.imageIndex];
+
+            // 元画像の一部を指す Image（コピーしない）
+            DirectX::Image part = source;
+            part.height = tile.height;
+            part.pixels = source.pixels + tile.y * source.rowPitch;
+            part.slicePitch = source.rowPitch * tile.height;
+
+            DirectX::ScratchImage partCompressed;
+            results[t] = DirectX::Compress(part, format, DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, partCompressed);
+            if (FAILED(results[t])) {
+                continue;
+            }
+
+            // 圧縮したブロック行を出力画像の同じ位置へ写す
+            const DirectX::Image& destination = destinationImages[tile.imageIndex];
+            const DirectX::Image* compressedPart = partCompressed.GetImage(0, 0, 0);
+            size_t blockRowBegin = tile.y / 4;
+            size_t blockRowCount = (tile.height + 3) / 4;
+            for (size_t row = 0; row < blockRowCount; ++row) {
+                std::memcpy(destination.pixels + (blockRowBegin + row) * destination.rowPitch,
+                    compressedPart->pixels + row * compressedPart->rowPitch,
+                    destination.rowPitch);
+            }
+        }
+    });
+
+    for (HRESULT result : results) {
+        if (FAILED(result)) {
+            return result;
+        }
+    }
+    return S_OK;
+}
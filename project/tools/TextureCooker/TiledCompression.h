@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+
+#include "externals/DirectXTex/DirectXTex.h"
+
+class ThreadPool;
+
+// ブロック圧縮を横長のタイルに分けて並列に行う（TextureCooker の -j）
+namespace TiledCompression {
+
+    // 1タイルの高さ（ピクセル）。ブロック（4x4）の境目で切るので 4 の倍数にする
+    constexpr size_t kTileRows = 64;
+
+    // 全ミップマップを横長のタイル（ブロック行のまとまり）に分け、threadPool で並列に圧縮する
+    // ブロックどうしは独立に圧縮されるので、1枚まるごと圧縮したときと同じ結果になる
+    // （ブロックをまたいで誤差を拡散する TEX_COMPRESS_DITHER は使わないこと）
+    HRESULT Compress(const DirectX::ScratchImage& mipImages, DXGI_FORMAT format, ThreadPool& threadPool, DirectX::ScratchImage& compressed);
+
+}
@@ -0,0 +1,291 @@
+// テクスチャのクッカー（コマンドラインツール）
+// 画像を読み込んでミップマップを作り、BC7 / BC1 に圧縮した DDS を元の画像の隣に書き出す。
+// ゲーム側（DirectXCommon::LoadTexture）は同じ名前の .dds があればそちらを読む。
+//
+// 使い方: TextureCooker [-f bc7|bc1] [-j スレッド数] [-o 出力ディレクトリ] [-verify] 入力ファイルまたはディレクトリ...
+//   ディレクトリを渡すと中の画像（png, jpg, bmp, tga, hdr）をすべて処理する
+//   -j 1 で1スレッド、省略時は論理コア数ぶんのスレッドで圧縮する（結果のファイルはスレッド数によらず同じ）
+//   -verify を付けると、画像ごとに -j 1 と同じ圧縮（1枚まるごと）と -j の並列圧縮の両方を行い、
+//   書き出す DDS がバイト単位で同じか確かめる（違えばその画像は失敗にして書き出さない）
+//   png / jpg / bmp の読み込みは WIC を使うので Windows のみ。tga / hdr はどこでも読める
+//   D3D12 はブロック圧縮のテクスチャの幅・高さが 4 の倍数でないと作れないので、そうでない画像は 4 の倍数に拡大してから圧縮する
+//   （ゲーム側から見えるテクスチャの大きさも拡大後のものになる）
+#include "TextureDecoder.h"
+#include "ThreadPool.h"
+#include "TiledCompression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+namespace {
+
+    // 読み込み対象の拡張子
+    bool IsSourceImage(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        for (char& c : extension) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp"
+            || extension == ".tga" || extension == ".hdr";
+    }
+
+    // 出力するブロック圧縮形式（sRGB の画像は sRGB のまま圧縮する）
+    DXGI_FORMAT GetCompressedFormat(DXGI_FORMAT sourceFormat, bool useBC1) {
+        bool isSRGB = DirectX::IsSRGB(sourceFormat);
+        if (useBC1) {
+            return isSRGB ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+        }
+        return isSRGB ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+    }
+
+    // ブロック圧縮の1ブロックの幅・高さ
+    constexpr size_t kBlockSize = 4;
+
+    size_t AlignToBlock(size_t value) {
+        return (value + kBlockSize - 1) / kBlockSize * kBlockSize;
+    }
+
+    // 幅・高さが 4 の倍数でなければ、4 の倍数に拡大する（D3D12 がブロック圧縮のテクスチャを作れるように）
+    HRESULT ResizeToBlockMultiple(DirectX::ScratchImage& image) {
+        const DirectX::TexMetadata& metadata = image.GetMetadata();
+        size_t width = AlignToBlock(metadata.width);
+        size_t height = AlignToBlock(metadata.height);
+        if (width == metadata.width && height == metadata.height) {
+            return S_OK;
+        }
+
+        DirectX::TEX_FILTER_FLAGS filter = DirectX::IsSRGB(metadata.format) ? DirectX::TEX_FILTER_SRGB : DirectX::TEX_FILTER_DEFAULT;
+        DirectX::ScratchImage resized;
+        HRESULT hr = DirectX::Resize(image.GetImages(), image.GetImageCount(), metadata, width, height, filter, resized);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        image = std::move(resized);
+        return S_OK;
+    }
+
+    // DDS ファイルにしたときのバイト列
+    HRESULT SaveToMemory(const DirectX::ScratchImage& image, DirectX::Blob& blob) {
+        return DirectX::SaveToDDSMemory(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::DDS_FLAGS_NONE, blob);
+    }
+
+    // -j 1 の圧縮（DirectXTex に1枚まるごと渡す）と TiledCompression::Compress の結果を DDS のバイト列で比べる
+    // 違っていれば最初に違う位置を表示して false
+    bool VerifyTiledCompression(const std::filesystem::path& inputPath, const DirectX::ScratchImage& mipImages, DXGI_FORMAT format, ThreadPool& threadPool) {
+        DirectX::ScratchImage whole;
+        HRESULT hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+            format, DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, whole);
+        DirectX::ScratchImage tiled;
+        if (SUCCEEDED(hr)) {
+            hr = TiledCompression::Compress(mipImages, format, threadPool, tiled);
+        }
+        DirectX::Blob wholeBlob;
+        DirectX::Blob tiledBlob;
+        if (SUCCEEDED(hr)) {
+            hr = SaveToMemory(whole, wholeBlob);
+        }
+        if (SUCCEEDED(hr)) {
+            hr = SaveToMemory(tiled, tiledBlob);
+        }
+        if (FAILED(hr)) {
+            std::printf("%s: verify failed to compress (hr=%08x)\n", inputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+
+        const uint8_t* wholeBytes = static_cast<const uint8_t*>(wholeBlob.GetBufferPointer());
+        const uint8_t* tiledBytes = static_cast<const uint8_t*>(tiledBlob.GetBufferPointer());
+        size_t size = (std::min)(wholeBlob.GetBufferSize(), tiledBlob.GetBufferSize());
+        size_t mismatch = std::mismatch(wholeBytes, wholeBytes + size, tiledBytes).first - wholeBytes;
+        if (mismatch < size || wholeBlob.GetBufferSize() != tiledBlob.GetBufferSize()) {
+            std::printf("%s: verify MISMATCH between -j 1 and -j %u (first difference at byte %zu, %zu vs %zu bytes)\n",
+                inputPath.string().c_str(), threadPool.GetThreadCount() + 1, mismatch, wholeBlob.GetBufferSize(), tiledBlob.GetBufferSize());
+            return false;
+        }
+        std::printf("%s: verify ok, -j 1 and -j %u write identical DDS (%zu bytes)\n",
+            inputPath.string().c_str(), threadPool.GetThreadCount() + 1, size);
+        return true;
+    }
+
+    // 1枚クックする。失敗したら false
+    bool Cook(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath, bool useBC1, bool verify, ThreadPool& threadPool) {
+        // 1. 読み込み
+        DirectX::ScratchImage image;
+        HRESULT hr = TextureDecoder::Load(inputPath.wstring(), image);
+        if (FAILED(hr)) {
+            std::printf("%s: failed to load (hr=%08x)\n", inputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+
+        // 幅・高さを 4 の倍数にそろえる
+        size_t sourceWidth = image.GetMetadata().width;
+        size_t sourceHeight = image.GetMetadata().height;
+        hr = ResizeToBlockMultiple(image);
+        if (FAILED(hr)) {
+            std::printf("%s: failed to resize (hr=%08x)\n", inputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+        if (image.GetMetadata().width != sourceWidth || image.GetMetadata().height != sourceHeight) {
+            std::printf("%s: resized %zux%zu -> %zux%zu (block compression needs multiples of 4)\n",
+                inputPath.string().c_str(), sourceWidth, sourceHeight, image.GetMetadata().width, image.GetMetadata().height);
+        }
+
+        // ミップマップ生成（ゲーム側と同じ処理）
+        DirectX::ScratchImage mipImages;
+        hr = TextureDecoder::GenerateMipMaps(image, mipImages);
+        if (FAILED(hr)) {
+            std::printf("%s: failed to generate mipmaps (hr=%08x)\n", inputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+
+        // 2. ブロック圧縮
+        const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
+        DXGI_FORMAT format = GetCompressedFormat(metadata.format, useBC1);
+
+        // スレッド数で結果が変わらないことを確かめる
+        if (verify && !VerifyTiledCompression(inputPath, mipImages, format, threadPool)) {
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        DirectX::ScratchImage compressed;
+        if (threadPool.GetThreadCount() == 0) {
+            hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), metadata,
+                format, DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+        } else {
+            hr = TiledCompression::Compress(mipImages, format, threadPool, compressed);
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (FAILED(hr)) {
+            std::printf("%s: failed to compress (hr=%08x)\n", inputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+
+        // 3. DDS に保存
+        hr = DirectX::SaveToDDSFile(compressed.GetImages(), compressed.GetImageCount(), compressed.GetMetadata(),
+            DirectX::DDS_FLAGS_NONE, outputPath.wstring().c_str());
+        if (FAILED(hr)) {
+            std::printf("%s: failed to save (hr=%08x)\n", outputPath.string().c_str(), static_cast<unsigned int>(hr));
+            return false;
+        }
+
+        // 4. 結果（圧縮時間と、非圧縮のミップマップ付きデータに対するサイズ比）
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        size_t sourceSize = mipImages.GetPixelsSize();
+        size_t cookedSize = compressed.GetPixelsSize();
+        std::printf("%s: %zux%zu, %zu mips, %s, %u threads, %.1f ms, %zu -> %zu bytes (%.1f%%)\n",
+            inputPath.string().c_str(), metadata.width, metadata.height, metadata.mipLevels,
+            useBC1 ? "BC1" : "BC7", threadPool.GetThreadCount() + 1, milliseconds, sourceSize, cookedSize,
+            100.0 * double(cookedSize) / double(sourceSize));
+        return true;
+    }
+
+    void PrintUsage() {
+        std::printf("usage: TextureCooker [-f bc7|bc1] [-j threads] [-o outputDir] [-verify] inputs...\n");
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    bool useBC1 = false;
+    bool verify = false;
+    uint32_t threadCount = 0;
+    std::filesystem::path outputDirectory;
+    std::vector<std::filesystem::path> inputs;
+
+    // 引数の解析
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-f" && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format == "bc1") {
+                useBC1 = true;
+            } else if (format == "bc7") {
+                useBC1 = false;
+            } else {
+                PrintUsage();
+                return 1;
+            }
+        } else if (arg == "-j" && i + 1 < argc) {
+            threadCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            if (threadCount == 0) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputDirectory = argv[++i];
+        } else if (arg == "-verify") {
+            verify = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            PrintUsage();
+            return 1;
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    // 出力先のディレクトリが無ければ作る
+    if (!outputDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(outputDirectory, error);
+    }
+
+    // ディレクトリは中の画像に展開する
+    std::vector<std::filesystem::path> files;
+    for (const std::filesystem::path& input : inputs) {
+        if (std::filesystem::is_directory(input)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(input)) {
+                if (entry.is_regular_file() && IsSourceImage(entry.path())) {
+                    files.push_back(entry.path());
+                }
+            }
+        } else {
+            files.push_back(input);
+        }
+    }
+
+#ifdef _WIN32
+    // WIC を使うので COM を初期化する
+    HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(hr)) {
+        return 1;
+    }
+#endif
+
+    // 呼び出し元のスレッドも圧縮するので、ワーカーは (スレッド数 - 1) 人
+    // -j 1 ならワーカーなしで、DirectXTex に1枚まるごと渡す
+    ThreadPool threadPool;
+    if (threadCount != 1) {
+        threadPool.Initialize(threadCount == 0 ? 0 : threadCount - 1);
+    }
+
+    uint32_t failedCount = 0;
+    for (const std::filesystem::path& file : files) {
+        std::filesystem::path outputPath = file;
+        outputPath.replace_extension(".dds");
+        if (!outputDirectory.empty()) {
+            outputPath = outputDirectory / outputPath.filename();
+        }
+        if (!Cook(file, outputPath, useBC1, verify, threadPool)) {
+            ++failedCount;
+        }
+    }
+
+    std::printf("%zu cooked, %u failed\n", files.size() - failedCount, failedCount);
+    return failedCount == 0 ? 0 : 1;
+}